@@ -10,16 +10,23 @@ typedef struct fcsv_row {
         fsv_t *datas;
         fsv_t *columns;
     };
+    const fsv_allocator_t *allocator;
 } fcsv_row_t;
 
 typedef struct fcsv {
     fsv_t      parse_point;
     fsb_t      content;
+    fsv_t      mapping;  // File content when opened with `fcsv_open_mmap`
     fcsv_row_t header;
     fcsv_row_t rows;
+    // Set before `fcsv_open` to allocate the content and the rows with it
+    const fsv_allocator_t *allocator;
 } fcsv_t;
 
 bool fcsv_open(fcsv_t *csv, const char *file_path, bool have_header);
+// Same as `fcsv_open` but maps the file instead of reading it, columns point
+// straight into the mapping
+bool fcsv_open_mmap(fcsv_t *csv, const char *file_path, bool have_header);
 void fcsv_close(fcsv_t *csv);
 bool fcsv_get_next_column(fsv_t *row, fsv_t *column);
 bool fcsv_get_next_row(fcsv_t *csv, fcsv_row_t *out);
@@ -60,13 +67,11 @@ int main(void) {
 
 #ifdef FCSV_IMPLEMENTATION
 
-bool fcsv_open(fcsv_t *csv, const char *file_path, bool have_header) {
-    if (!fsb_read_entire_file(file_path, &csv->content)) {
-        FSV_LOGE("[FCSV] Couldn't open file `%s`. %s\n", file_path, strerror(errno));
-        return false;
-    }
-    fsv_t saved_point = fsv_from_sb(csv->content);
-    csv->parse_point = fsv_from_sb(csv->content);
+static bool fcsv_open_content(fcsv_t *csv, fsv_t content, bool have_header) {
+    csv->header.allocator = csv->allocator;
+    csv->rows.allocator   = csv->allocator;
+    fsv_t saved_point = content;
+    csv->parse_point  = content;
 
     { // Getting column_count
         size_t column_count = 0;
@@ -74,16 +79,33 @@ bool fcsv_open(fcsv_t *csv, const char *file_path, bool have_header) {
         fsv_t column        = {};
         if (!fsv_split_by_cstr(&csv->parse_point, "\r\n", false, &row)) return false;
         while (fcsv_get_next_column(&row, &column)) {
-            if (have_header) { fda_append(&csv->header, column); }
+            if (have_header) { fda_append_a(&csv->header, column); }
             column_count++;
         }
-        fda_reserve(&csv->rows, column_count);
+        fda_reserve_a(&csv->rows, column_count);
     }
 
     csv->parse_point = saved_point;
     return true;
 }
 
+bool fcsv_open(fcsv_t *csv, const char *file_path, bool have_header) {
+    csv->content.allocator = csv->allocator;
+    if (!fsb_read_entire_file(file_path, &csv->content)) {
+        FSV_LOGE("[FCSV] Couldn't open file `%s`. %s\n", file_path, strerror(errno));
+        return false;
+    }
+    return fcsv_open_content(csv, fsv_from_sb(csv->content), have_header);
+}
+
+bool fcsv_open_mmap(fcsv_t *csv, const char *file_path, bool have_header) {
+    if (!fsv_mmap_file(file_path, FSV_MMAP_SEQUENTIAL, &csv->mapping)) {
+        FSV_LOGE("[FCSV] Couldn't map file `%s`\n", file_path);
+        return false;
+    }
+    return fcsv_open_content(csv, csv->mapping, have_header);
+}
+
 bool fcsv_get_next_column(fsv_t *row, fsv_t *column) {
     if (fsv_starts_with_cstr(*row, "\"", true)) {
         fsv_t unused = {};
@@ -105,15 +127,16 @@ bool fcsv_get_next_row(fcsv_t *csv, fcsv_row_t *out) {
     if (!fsv_split_by_cstr(&csv->parse_point, "\r\n", false, &row)) return false;
 
     csv->rows.size = 0;
-    while (fcsv_get_next_column(&row, &column)) { fda_append(&csv->rows, column); }
+    while (fcsv_get_next_column(&row, &column)) { fda_append_a(&csv->rows, column); }
     if (out != NULL) *out = csv->rows;
     return true;
 }
 
 void fcsv_close(fcsv_t *csv) {
     fsb_free(&csv->content);
-    fda_free(&csv->header);
-    fda_free(&csv->rows);
+    fsv_munmap_file(&csv->mapping);
+    fda_free_a(&csv->header);
+    fda_free_a(&csv->rows);
 }
 
 #endif // FCSV_IMPLEMENTATION
@@ -49,6 +49,40 @@
 #    define FSV_PRINTF_FORMAT(STRING_INDEX, FIRST_TO_CHECK)
 #endif
 
+#ifndef FSV_THREAD_LOCAL
+#    if defined(FSV_DISABLE_THREADS)
+#        define FSV_THREAD_LOCAL
+#    elif defined(__cplusplus)
+#        define FSV_THREAD_LOCAL thread_local
+#    elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#        define FSV_THREAD_LOCAL _Thread_local
+#    elif defined(_MSC_VER)
+#        define FSV_THREAD_LOCAL __declspec(thread)
+#    else
+#        define FSV_THREAD_LOCAL __thread
+#    endif
+#endif // FSV_THREAD_LOCAL
+
+///////////////////////// SIMD /////////////////////////
+
+// Search kernels are picked at runtime from the best instruction set
+// supported by the CPU. Define `FSV_DISABLE_SIMD` to only use the portable
+// SWAR (SIMD within a register) fallback.
+typedef enum {
+    FSV_SIMD_SWAR,
+    FSV_SIMD_SSE2,
+    FSV_SIMD_AVX2,
+    FSV_SIMD_AVX512,
+} fsv_simd_t;
+
+FSV_DEF fsv_simd_t fsv_simd_detect(void);
+FSV_DEF fsv_simd_t fsv_simd_get(void);
+// Can only lower the instruction set (for testing or benchmarking)
+// Return the instruction set actually in use
+FSV_DEF fsv_simd_t fsv_simd_set(fsv_simd_t simd);
+
+///////////////////////// End of SIMD /////////////////////////
+
 ///////////////////////// String View /////////////////////////
 
 typedef struct fstring_view {
@@ -57,8 +91,13 @@ typedef struct fstring_view {
 } fsv_t;
 
 FSV_DEF fsv_t fsv_from_cstr(const char *string);
+// Stop at the null-terminator if it comes before `length`
 FSV_DEF fsv_t fsv_from_partial_cstr(const char *string, const size_t length);
+// O(1), trust `length` so `datas` doesn't need to be null-terminated
+FSV_DEF fsv_t fsv_from_parts(const char *datas, const size_t length);
+// O(1), `start` and `length` are clamped to the bounds of `sv`
 FSV_DEF fsv_t fsv_from_sv(const fsv_t sv, const size_t length);
+FSV_DEF fsv_t fsv_slice(const fsv_t sv, const size_t start, const size_t length);
 
 FSV_DEF fsv_t fsv_trim(fsv_t sv);
 FSV_DEF fsv_t fsv_trim_left(fsv_t sv);
@@ -66,6 +105,7 @@ FSV_DEF fsv_t fsv_trim_right(fsv_t sv);
 
 FSV_DEF size_t fsv_strlen(const char *string);
 FSV_DEF int    fsv_index_of(fsv_t sv, char c);
+FSV_DEF int    fsv_index_of_sv(fsv_t sv, fsv_t needle, bool ignore_case);
 FSV_DEF char   fsv_lower(char c);
 FSV_DEF char   fsv_upper(char c);
 FSV_DEF bool   fsv_is_space(char c);
@@ -81,17 +121,94 @@ FSV_DEF bool fsv_eq_cstr(fsv_t sv1, const char *string, bool ignore_case);
 FSV_DEF bool fsv_ends_with_cstr(fsv_t sv, const char *suffix, bool ignore_case);
 FSV_DEF bool fsv_starts_with_cstr(fsv_t sv, const char *prefix, bool ignore_case);
 
+// 64-bit hash of the bytes of `sv` (wyhash). With `ignore_case` ASCII letters
+// are folded first, so views that are `fsv_eq(..., true)` hash the same
+FSV_DEF uint64_t fsv_hash(fsv_t sv, uint64_t seed, bool ignore_case);
+
+// Set of delimiters compiled once by `fsv_delims_from_*` and then used to
+// split on any of them in a single pass
+typedef struct fstring_view_delims {
+    bool table[256];
+    // Nibble lookup tables for `pshufb`, a byte `c` is in the set when
+    // `low[c & 0xF] & high[c >> 4]` is not 0. Only usable if `vectorized`
+    uint8_t low[16];
+    uint8_t high[16];
+    bool vectorized;
+} fsv_delims_t;
+
+FSV_DEF fsv_delims_t fsv_delims_from_sv(fsv_t set);
+FSV_DEF fsv_delims_t fsv_delims_from_cstr(const char *set);
+FSV_DEF int          fsv_index_of_any(fsv_t sv, const fsv_delims_t *delims);
+
 FSV_DEF bool fsv_split(fsv_t *sv, fsv_t *out);
+FSV_DEF bool fsv_split_by_any(fsv_t *sv, const fsv_delims_t *delims, fsv_t *out);
 FSV_DEF bool fsv_split_by_delim(fsv_t *sv, char delim, fsv_t *out);
 FSV_DEF bool fsv_split_by_sv(fsv_t *sv, fsv_t delim, bool ignore_case, fsv_t *out);
 FSV_DEF bool fsv_split_by_cstr(fsv_t *sv, const char *delim, bool ignore_case, fsv_t *out);
 FSV_DEF bool fsv_split_by_pair(fsv_t *right, const char *pair, fsv_t *middle, fsv_t *left);
 
+typedef enum {
+    FSV_PARSE_OK,
+    FSV_PARSE_INVALID,   // No number at the start of the view, it is left untouched
+    FSV_PARSE_OVERFLOW,  // Out of range, the number is still consumed and `out` is clamped
+} fsv_parse_status_t;
+
+// Parse the number at the start of `sv` and move `sv` right after it,
+// like `fsv_split_*` do. No leading spaces are skipped.
+// Usage:
+//  int64_t value = 0;
+//  fsv_t sv = fsv_from_cstr("-42,rest");
+//  if (fsv_parse_i64(&sv, &value) == FSV_PARSE_OK) ... // sv = ",rest"
+FSV_DEF fsv_parse_status_t fsv_parse_u64(fsv_t *sv, uint64_t *out);
+// Optional '+' or '-' sign
+FSV_DEF fsv_parse_status_t fsv_parse_i64(fsv_t *sv, int64_t *out);
+// Decimal notation with an optional exponent, "inf", "infinity" or "nan",
+// correctly rounded like `strtod` but without locale. Finite numbers that
+// are too big give FSV_PARSE_OVERFLOW and an infinity.
+FSV_DEF fsv_parse_status_t fsv_parse_f64(fsv_t *sv, double *out);
+FSV_DEF fsv_parse_status_t fsv_parse_f32(fsv_t *sv, float *out);
+
 ///////////////////////// End of String View /////////////////////////
 
+///////////////////////// Allocator /////////////////////////
+
+// Runtime allocator that `fsb_t`, `ffp_t`, `fcsv_t` and the `fda_*_a` arrays
+// can carry in their `allocator` field. NULL means `FSV_REALLOC` and `FSV_FREE`.
+// The allocator is only pointed to, it must outlive the containers using it.
+// Only `fda_*_a` and the functions of those containers honor it, not `fda_*`.
+// Usage:
+//  fsv_arena_t arena = {};
+//  fsv_allocator_t allocator = fsv_arena_allocator(&arena);
+//  fsb_t sb = {};
+//  sb.allocator = &allocator;
+//  fsb_append_cstr(&sb, "...");
+//  fsv_arena_reset(&arena);  // No need for `fsb_free`
+typedef struct fstring_view_allocator {
+    void *(*alloc)(void *ctx, size_t size);
+    // Grow or shrink `ptr`, keeping its first `min(old_size, new_size)` bytes
+    void *(*resize)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+    void  (*release)(void *ctx, void *ptr, size_t size);
+    void *ctx;
+} fsv_allocator_t;
+
+FSV_DEF void *fsv_allocator_alloc(const fsv_allocator_t *allocator, size_t size);
+FSV_DEF void *fsv_allocator_resize(const fsv_allocator_t *allocator, void *ptr, size_t old_size, size_t new_size);
+FSV_DEF void  fsv_allocator_release(const fsv_allocator_t *allocator, void *ptr, size_t size);
+
+///////////////////////// End of Allocator /////////////////////////
+
 ///////////////////////// String Builder /////////////////////////
 #define FSB_INITIAL_CAPACITY (2)
 
+// Two families of dynamic array macros, picked by the array:
+//  - `fda_*` work on any struct with `size`, `capacity` and `datas` fields and
+//    always go through `FSV_REALLOC` and `FSV_FREE`. They ignore `allocator`.
+//  - `fda_*_a` also need an `allocator` field and always go through it.
+// Arrays that carry an allocator (`fsb_t`, `ffp_t`, `fpt_t`, `fcsv_row_t`) must
+// only be grown and freed with `fda_*_a` or their own functions (`fsb_append_*`,
+// `fsb_free`, `ffp_free`, ...). `fda_*` on them is only safe while `allocator`
+// is NULL: on an arena it would realloc or free memory the arena owns.
+
 #ifndef fda_realloc
 #define fda_realloc(da, item_added)                                                                                  \
     do {                                                                                                             \
@@ -148,10 +265,76 @@ FSV_DEF bool fsv_split_by_pair(fsv_t *right, const char *pair, fsv_t *middle, fs
     } while (0)
 #endif // fda_free
 
+// `fda_*_a` also need an `allocator` field, like `fsb_t` and `ffp_t`. NULL
+// behaves exactly like `fda_*`
+
+#ifndef fda_realloc_a
+#define fda_realloc_a(da, item_added)                                                               \
+    do {                                                                                            \
+        size_t fda_old_capacity = (da)->capacity;                                                   \
+        if ((da)->capacity == 0) { (da)->capacity = FSB_INITIAL_CAPACITY; }                         \
+        while ((da)->size + (item_added) > (da)->capacity) {                                        \
+            (da)->capacity *= 2;                                                                    \
+        }                                                                                           \
+        (da)->datas = (__typeof__(*((da)->datas))*) fsv_allocator_resize((da)->allocator,           \
+                (da)->datas, fda_old_capacity*sizeof(*(da)->datas), (da)->capacity*sizeof(*(da)->datas)); \
+        FSV_ASSERT((da)->datas != NULL && "Out of Memory!!!");                                      \
+    } while (0)
+#endif // fda_realloc_a
+
+#ifndef fda_append_a
+#define fda_append_a(da, data)                  \
+    do {                                        \
+        if ((da)->size + 1 >= (da)->capacity) { \
+            fda_realloc_a((da), 1);             \
+        }                                       \
+        (da)->datas[(da)->size++] = data;       \
+    } while (0)
+#endif // fda_append_a
+
+#ifndef fda_append_many_a
+#define fda_append_many_a(da, _datas, _size)           \
+    do {                                               \
+        if ((da)->size + (_size) >= (da)->capacity) {  \
+            fda_realloc_a((da), (_size));              \
+        }                                              \
+        for (size_t i = 0; i < (size_t)(_size); ++i) { \
+            (da)->datas[(da)->size++] = (_datas)[i];   \
+        }                                              \
+    } while (0)
+#endif // fda_append_many_a
+
+#ifndef fda_reserve_a
+#define fda_reserve_a(da, cap)                                                                 \
+    do {                                                                                       \
+        if ((da)->capacity >= (cap)) { break; }                                                \
+        (da)->datas = (__typeof__(*((da)->datas))*) fsv_allocator_resize((da)->allocator,      \
+                (da)->datas, (da)->capacity*sizeof(*(da)->datas), (cap)*sizeof(*(da)->datas)); \
+        FSV_ASSERT((da)->datas != NULL && "Out of Memory!!!");                                 \
+        (da)->capacity = (cap);                                                                \
+    } while (0)
+#endif // fda_reserve_a
+
+#ifndef fda_free_a
+// Keeps `allocator`, so the array can be reused right away
+#define fda_free_a(da)                                                                             \
+    do {                                                                                           \
+        if ((da)->datas != NULL) {                                                                 \
+            fsv_allocator_release((da)->allocator, (da)->datas, (da)->capacity*sizeof(*(da)->datas)); \
+        }                                                                                          \
+        (da)->datas    = NULL;                                                                     \
+        (da)->size     = 0;                                                                        \
+        (da)->capacity = 0;                                                                        \
+    } while (0)
+#endif // fda_free_a
+
+// Mutate it with the `fsb_*` functions or `fda_*_a`. Plain `fda_*` ignore
+// `allocator` and are only safe while it is NULL
 typedef struct fstring_builder {
     union { size_t size; size_t length; };
     size_t capacity;
     char *datas;
+    const fsv_allocator_t *allocator;
 } fsb_t;
 
 typedef struct f_file_entity {
@@ -159,28 +342,464 @@ typedef struct f_file_entity {
     bool is_dir;
 } ffe_t;
 
+// Mutate it with `fda_*_a` and free it with `ffp_free`. Plain `fda_*` ignore
+// `allocator` and are only safe while it is NULL
 typedef struct f_file_path {
     union { size_t size; size_t length; };
     size_t capacity;
     ffe_t *datas;
+    const fsv_allocator_t *allocator;  // Also used for the names of the entities
 } ffp_t;
 
 FSV_DEF bool fsb_read_entire_file(const char *file_path, fsb_t *sb);
 FSV_DEF bool fsb_read_entire_dir(const char *parent, ffp_t *children, bool recursive);
+
+// Hints for `fsv_mmap_file`, they can be combined
+typedef enum {
+    FSV_MMAP_NORMAL     = 0,
+    FSV_MMAP_SEQUENTIAL = 1 << 0,  // Read front to back, more read-ahead
+    FSV_MMAP_WILLNEED   = 1 << 1,  // Start paging the whole file in now
+    FSV_MMAP_HUGEPAGES  = 1 << 2,  // Where the kernel supports it for files
+} fsv_mmap_hint_t;
+
+// Read-only view of a whole file without copying it. Pages are loaded on
+// first access, the view is NOT NUL terminated. An empty file gives an empty
+// view. Release it with `fsv_munmap_file`.
+FSV_DEF bool fsv_mmap_file(const char *file_path, int hints, fsv_t *out);
+FSV_DEF void fsv_munmap_file(fsv_t *sv);
 FSV_DEF int  fsb_append_strf(fsb_t *sb, const char *fmt, ...) FSV_PRINTF_FORMAT(2, 3);
+// Typed appenders write straight into `sb` without going through printf,
+// `sb` stays NUL terminated like with `fsb_append_strf`
+FSV_DEF void fsb_append_sv(fsb_t *sb, fsv_t sv);
+FSV_DEF void fsb_append_cstr(fsb_t *sb, const char *cstr);
+FSV_DEF void fsb_append_char(fsb_t *sb, char c);
+FSV_DEF void fsb_append_u64(fsb_t *sb, uint64_t value);
+FSV_DEF void fsb_append_i64(fsb_t *sb, int64_t value);
+// Shortest text that reads back to the same double, formatted like C++17
+// `std::to_chars(first, last, value)`: "0.1", "1e+23", "-inf", "nan"
+FSV_DEF void fsb_append_f64(fsb_t *sb, double value);
 FSV_DEF void fsb_free(fsb_t *sb);
 FSV_DEF void ffp_free(ffp_t *fp);
 
 FSV_DEF fsv_t fsv_from_sb(const fsb_t sb);
 FSV_DEF fsb_t fsb_from_sv(const fsv_t sv);
+FSV_DEF fsb_t fsb_from_sv_with(const fsv_t sv, const fsv_allocator_t *allocator);
+
+// Compact listing of a tree: each entity only keeps its own name, all names
+// share one buffer, and the rest of a path is found through the parent
+// directory. Entity 0 is the listed directory itself, named like `parent`.
+// A directory comes before its entities, which are next to each other.
+// Freeing it is two frees whatever the size of the tree.
+// Usage:
+//  fpt_t table = {};
+//  if (!fpt_read_entire_dir("logs", &table, true)) return false;
+//  fsb_t path = {};
+//  for (size_t i = 0; i < table.size; ++i) {
+//      if (table.datas[i].is_dir) continue;
+//      path.length = 0;
+//      fpt_append_path(&table, i, &path);  // "logs/2024/app.log"
+//  }
+#define FPT_NO_PARENT (UINT32_MAX)
+
+typedef struct f_path_entity {
+    uint32_t name;    // Offset of the name in `names`, names are NUL terminated
+    uint32_t parent;  // Index of the parent directory or FPT_NO_PARENT
+    uint16_t length;  // Length of the name
+    bool     is_dir;
+} fpe_t;
+
+typedef struct f_path_table {
+    union { size_t size; size_t length; };
+    size_t capacity;
+    fpe_t *datas;
+    const fsv_allocator_t *allocator;  // Also used for `names`
+    fsb_t names;
+} fpt_t;
+
+FSV_DEF bool  fpt_read_entire_dir(const char *parent, fpt_t *table, bool recursive);
+FSV_DEF fsv_t fpt_name(const fpt_t *table, size_t index);
+// Appends the whole path of the entity, NUL terminated
+FSV_DEF void  fpt_append_path(const fpt_t *table, size_t index, fsb_t *sb);
+FSV_DEF void  fpt_free(fpt_t *table);
+
+// String builder that keeps up to `FSSB_INLINE_CAPACITY` chars inside the
+// struct and only moves to the heap past that. A zero initialized one is
+// empty and inline. The chars live in the struct itself, so always go through
+// a pointer: `fssb_cstr(&sb)`, `fsv_from_fssb(&sb)`
+#define FSSB_INLINE_CAPACITY (23)
+
+typedef struct fstring_small_builder {
+    union { size_t size; size_t length; };
+    size_t capacity;  // Only on the heap when greater than `FSSB_INLINE_CAPACITY`
+    union {
+        char *heap;
+        char inline_datas[FSSB_INLINE_CAPACITY + 1];
+    } u;
+} fssb_t;
+
+FSV_DEF fssb_t      fssb_from_sv(fsv_t sv);
+FSV_DEF void        fssb_append_sv(fssb_t *sb, fsv_t sv);
+FSV_DEF const char *fssb_cstr(const fssb_t *sb);
+FSV_DEF fsv_t       fsv_from_fssb(const fssb_t *sb);
+FSV_DEF void        fssb_free(fssb_t *sb);
 
 ///////////////////////// End of String Builder /////////////////////////
 
+///////////////////////// Tokenizer /////////////////////////
+
+// Split a whole buffer at once: `fsv_tokenizer_scan` finds every delimiter
+// of `source` block by block and keeps their offsets, then
+// `fsv_tokenizer_next` hands out the tokens the same way
+// a `fsv_split_by_any` loop would.
+typedef struct fstring_view_tokenizer {
+    union { size_t size; size_t length; };
+    size_t capacity;
+    size_t *datas;  // Offsets of the delimiters in `source`
+    fsv_t  source;
+    size_t cursor;  // Index of the next delimiter to consume
+} fsv_tokenizer_t;
+
+FSV_DEF size_t fsv_tokenizer_scan(fsv_tokenizer_t *tokenizer, fsv_t source, const fsv_delims_t *delims);
+FSV_DEF bool   fsv_tokenizer_next(fsv_tokenizer_t *tokenizer, fsv_t *out);
+// What's left after the last consumed delimiter
+FSV_DEF fsv_t  fsv_tokenizer_rest(const fsv_tokenizer_t *tokenizer);
+FSV_DEF void   fsv_tokenizer_free(fsv_tokenizer_t *tokenizer);
+
+// Split a large view on several threads. The view is cut right after
+// a delimiter into at most `thread_count` partitions (0 means one per CPU),
+// each one is scanned by its own `fsv_tokenizer_t` in `partitions`.
+// Walking the partitions in order gives the same tokens as a sequential
+// `fsv_split_by_any` loop, and the remainder is the `fsv_tokenizer_rest`
+// of the last partition. Define `FSV_DISABLE_THREADS` to scan them one by one.
+typedef struct fstring_view_partitions {
+    union { size_t size; size_t length; };
+    size_t capacity;
+    fsv_tokenizer_t *datas;
+} fsv_partitions_t;
+
+FSV_DEF size_t fsv_cpu_count(void);
+FSV_DEF size_t fsv_split_parallel(fsv_t sv, const fsv_delims_t *delims, size_t thread_count, fsv_partitions_t *partitions);
+FSV_DEF void   fsv_partitions_free(fsv_partitions_t *partitions);
+
+///////////////////////// End of Tokenizer /////////////////////////
+
+///////////////////////// Reader /////////////////////////
+
+// Walk a file of any size through windows of at most `2*chunk_size` chars.
+// A window ends right after the last `delim` it contains, the unfinished
+// record after it is carried over to the start of the next window. Records
+// longer than `chunk_size` are split. The next chunk is read ahead on a
+// background thread while the current window is parsed, so memory stays
+// around `4*chunk_size`. A window is valid until the next `fsv_reader_next`.
+// Usage:
+//  fsv_reader_t reader = {};
+//  if (!fsv_reader_open(&reader, "big.log", 0, '\n')) return false;
+//  fsv_t window = {}, line = {};
+//  while (fsv_reader_next(&reader, &window)) {
+//      while (fsv_split_by_delim(&window, '\n', &line)) ...
+//  }
+//  fsv_reader_close(&reader);
+#define FSV_READER_CHUNK_SIZE (1024*1024)
+
+typedef struct fstring_view_reader {
+    char  *buffers[2];  // `2*chunk_size` each: room for the carry-over, then a chunk
+    size_t chunk_size;
+    size_t back;        // Buffer the read-ahead goes into
+    fsv_t  tail;        // Carry-over of the last window
+    uint64_t offset;    // Offset of the next chunk in the file
+    char   delim;
+    bool   eof;
+    struct fstring_view_reader_job *job;
+} fsv_reader_t;
+
+// `chunk_size` 0 means `FSV_READER_CHUNK_SIZE`
+FSV_DEF bool fsv_reader_open(fsv_reader_t *reader, const char *file_path, size_t chunk_size, char delim);
+FSV_DEF bool fsv_reader_next(fsv_reader_t *reader, fsv_t *window);
+FSV_DEF void fsv_reader_close(fsv_reader_t *reader);
+
+///////////////////////// End of Reader /////////////////////////
+
+///////////////////////// Directory Walker /////////////////////////
+
+// Called for every entity under the walked directory, `path` is only valid
+// during the call. Calls come from `thread_count` threads at once, `worker`
+// (below `thread_count`) tells which one so state can be kept per thread
+// without locking. Return false to stop the walk.
+typedef bool (*fsv_walk_fn_t)(void *ctx, size_t worker, fsv_t path, bool is_dir);
+
+// Walk `parent` recursively on `thread_count` threads (0 means one per CPU).
+// Every thread reads directories from its own queue and steals from the
+// others when it runs out. Symbolic links are not followed.
+FSV_DEF bool fsv_walk_parallel(const char *parent, size_t thread_count, fsv_walk_fn_t fn, void *ctx);
+// Same entities as `fsb_read_entire_dir(parent, children, true)`. The order
+// depends on the threads, unless `sorted` is set to sort them by path.
+FSV_DEF bool fsb_read_entire_dir_parallel(const char *parent, ffp_t *children, size_t thread_count, bool sorted);
+
+///////////////////////// End of Directory Walker /////////////////////////
+
+///////////////////////// Batch Reader /////////////////////////
+
+// Read many files at once on `thread_count` threads, 0 means a few per CPU
+// since most of the time is spent waiting on the disk. Every file is appended
+// to `contents[i]` like `fsb_read_entire_file` does, and `errors[i]` gets 0
+// or the errno of its failure, `errors` can be NULL. On POSIX anything but a
+// regular file, like a FIFO, fails with EINVAL. The builders fill up on
+// worker threads, so their allocators must be thread safe.
+// Return false if any of the files could not be read.
+// Usage:
+//  ffp_t files = {};
+//  fsb_read_entire_dir("configs", &files, true);
+//  fsb_t *contents = calloc(files.size, sizeof(fsb_t));
+//  int *errors = calloc(files.size, sizeof(int));
+//  ffp_read_entire_files(&files, contents, errors, 0);
+FSV_DEF bool fsb_read_entire_files(const char *const *paths, size_t count, fsb_t *contents, int *errors, size_t thread_count);
+// Same with the entities of `files`, directories fail
+FSV_DEF bool ffp_read_entire_files(const ffp_t *files, fsb_t *contents, int *errors, size_t thread_count);
+
+///////////////////////// End of Batch Reader /////////////////////////
+
+///////////////////////// Grep /////////////////////////
+
+typedef struct fstring_view_grep_match {
+    fsv_t  path;
+    fsv_t  line;         // Without its line ending
+    size_t line_number;  // 1 based
+    size_t column;       // 1 based, in bytes
+    size_t pattern;      // Index of the pattern found
+} fsv_grep_match_t;
+
+// Called for every matching line, from several threads at once like
+// `fsv_walk_fn_t`. The views are only valid during the call.
+// Return false to stop the search.
+typedef bool (*fsv_grep_fn_t)(void *ctx, size_t worker, const fsv_grep_match_t *match);
+
+// Search a directory tree for a set of literals. Only `patterns` and `fn`
+// must be set, the rest can stay zero. Patterns should not contain line breaks.
+typedef struct fstring_view_grep {
+    const fsv_t *patterns;
+    size_t pattern_count;
+    bool ignore_case;     // ASCII only
+    size_t max_matches;   // Stop after reporting that many lines, 0 means no limit
+    size_t thread_count;  // 0 means one per CPU
+    fsv_grep_fn_t fn;
+    void *ctx;
+} fsv_grep_t;
+
+// Walk `parent` with `fsv_walk_parallel` and map every file. Each line that
+// contains a pattern is reported once, at the leftmost match. Files with a
+// NUL byte near their start are binary and skipped. `matches` gets the number
+// of lines reported, it can be NULL.
+// Usage:
+//  fsv_t patterns[] = { fsv_from_cstr("ERROR"), fsv_from_cstr("panic") };
+//  fsv_grep_t grep = {};
+//  grep.patterns      = patterns;
+//  grep.pattern_count = 2;
+//  grep.fn            = print_match;
+//  fsv_grep_parallel("/var/log/app", &grep, NULL);
+FSV_DEF bool fsv_grep_parallel(const char *parent, const fsv_grep_t *grep, size_t *matches);
+
+///////////////////////// End of Grep /////////////////////////
+
+///////////////////////// Hash Map /////////////////////////
+
+// Open addressing map from `fsv_t` to `void*` (Swiss table). The keys are
+// views and are not copied, they must outlive the map. A zero initialized
+// map is empty and ready to use, set `ignore_case` or `seed` before the
+// first insertion if needed.
+// Usage:
+//  fsv_map_t map = {};
+//  fsv_map_put(&map, fsv_from_cstr("key"), value);
+//  void *value = NULL;
+//  if (fsv_map_get(&map, fsv_from_cstr("key"), &value)) ...
+//  fsv_map_free(&map);
+typedef struct fstring_view_map_entry {
+    fsv_t key;
+    void *value;
+} fsv_map_entry_t;
+
+typedef struct fstring_view_map {
+    union { size_t size; size_t length; };
+    size_t capacity;         // Number of slots, 0 or a power of 2
+    fsv_map_entry_t *datas;  // Slots, only the ones with a full control byte hold an entry
+    int8_t *ctrl;            // One control byte per slot: empty, deleted or 7 bits of the hash
+    size_t tombstones;
+    uint64_t seed;
+    bool ignore_case;
+} fsv_map_t;
+
+FSV_DEF fsv_map_entry_t *fsv_map_find(const fsv_map_t *map, fsv_t key);
+// Find `key` or insert it with a NULL value. `inserted` can be NULL.
+// The entry stays valid until the next insertion
+FSV_DEF fsv_map_entry_t *fsv_map_insert(fsv_map_t *map, fsv_t key, bool *inserted);
+// Return true if `key` was not in the map yet
+FSV_DEF bool fsv_map_put(fsv_map_t *map, fsv_t key, void *value);
+FSV_DEF bool fsv_map_get(const fsv_map_t *map, fsv_t key, void **value);
+FSV_DEF bool fsv_map_remove(fsv_map_t *map, fsv_t key);
+FSV_DEF void fsv_map_reserve(fsv_map_t *map, size_t count);
+// Usage:
+//  size_t cursor = 0;
+//  fsv_map_entry_t *entry = NULL;
+//  while (fsv_map_next(&map, &cursor, &entry)) ...
+FSV_DEF bool fsv_map_next(const fsv_map_t *map, size_t *cursor, fsv_map_entry_t **entry);
+FSV_DEF void fsv_map_clear(fsv_map_t *map);
+FSV_DEF void fsv_map_free(fsv_map_t *map);
+
+///////////////////////// End of Hash Map /////////////////////////
+
+///////////////////////// Arena /////////////////////////
+
+// Chain of big blocks carved from front to back, everything is released at once.
+// Pointers stay valid until `fsv_arena_reset` or `fsv_arena_free`.
+// A zero initialized arena is ready to use, `block_size` can be set first.
+#define FSV_ARENA_BLOCK_SIZE (64*1024)
+#define FSV_ARENA_ALIGN      (2*sizeof(void*))
+
+typedef struct fstring_view_arena_block {
+    struct fstring_view_arena_block *next;
+    size_t size;
+    size_t capacity;
+    // Followed by `capacity` bytes
+} fsv_arena_block_t;
+
+typedef struct fstring_view_arena {
+    fsv_arena_block_t *first;
+    fsv_arena_block_t *current;
+    size_t block_size;
+} fsv_arena_t;
+
+FSV_DEF void *fsv_arena_alloc(fsv_arena_t *arena, size_t size);
+// `alignment` must be a power of 2
+FSV_DEF void *fsv_arena_alloc_aligned(fsv_arena_t *arena, size_t size, size_t alignment);
+// Copy of `sv` followed by a NUL byte
+FSV_DEF fsv_t fsv_arena_sv_dup(fsv_arena_t *arena, fsv_t sv);
+// Keep the blocks around for the next allocations
+FSV_DEF void  fsv_arena_reset(fsv_arena_t *arena);
+FSV_DEF void  fsv_arena_free(fsv_arena_t *arena);
+// Releasing is a no-op, the last allocation is grown in place when there is room
+FSV_DEF fsv_allocator_t fsv_arena_allocator(fsv_arena_t *arena);
+
+// Fixed size slots carved from an arena, released slots are reused first.
+// Set `slot_size` before the first allocation, a zero initialized pool is
+// otherwise ready to use. As an allocator, anything bigger than a slot fails.
+typedef struct fstring_view_pool {
+    fsv_arena_t arena;
+    void *free_list;
+    size_t slot_size;
+} fsv_pool_t;
+
+FSV_DEF void *fsv_pool_alloc(fsv_pool_t *pool);
+FSV_DEF void  fsv_pool_release(fsv_pool_t *pool, void *ptr);
+FSV_DEF void  fsv_pool_reset(fsv_pool_t *pool);
+FSV_DEF void  fsv_pool_free(fsv_pool_t *pool);
+FSV_DEF fsv_allocator_t fsv_pool_allocator(fsv_pool_t *pool);
+
+///////////////////////// End of Arena /////////////////////////
+
+///////////////////////// Interner /////////////////////////
+
+// Store every distinct string once and give it a small id, comparing
+// two interned strings is then comparing two integers.
+// Usage:
+//  fsv_interner_t interner = {};
+//  fsv_atom_t ok = fsv_intern(&interner, fsv_from_cstr("200"));
+//  if (fsv_intern(&interner, status) == ok) ...
+//  printf(fsv_fmt "\n", fsv_arg(fsv_atom_sv(&interner, ok)));
+//  fsv_interner_free(&interner);
+typedef uint32_t fsv_atom_t;
+
+typedef struct fstring_view_interner {
+    fsv_arena_t arena;  // Bytes of every string, NUL terminated
+    fsv_map_t   map;    // String -> atom
+    struct {
+        union { size_t size; size_t length; };
+        size_t capacity;
+        fsv_t *datas;
+    } atoms;            // Atom -> string
+} fsv_interner_t;
+
+FSV_DEF fsv_atom_t fsv_intern(fsv_interner_t *interner, fsv_t sv);
+FSV_DEF fsv_atom_t fsv_intern_cstr(fsv_interner_t *interner, const char *cstr);
+// Return false if `sv` was never interned
+FSV_DEF bool       fsv_interner_find(const fsv_interner_t *interner, fsv_t sv, fsv_atom_t *atom);
+// The view stays valid until `fsv_interner_free`
+FSV_DEF fsv_t      fsv_atom_sv(const fsv_interner_t *interner, fsv_atom_t atom);
+FSV_DEF void       fsv_interner_free(fsv_interner_t *interner);
+
+///////////////////////// End of Interner /////////////////////////
+
+///////////////////////// Directory Watcher /////////////////////////
+
+// Keep the recursive listing of a directory up to date without rescanning it.
+// On Linux the tree is listed once and then patched from inotify events, other
+// platforms rescan on every poll. Every added or removed file bumps
+// `generation` and is logged, so callers can ask what changed since the
+// generation they last saw.
+// Usage:
+//  fsv_watch_t watch = {};
+//  fsv_watch_open(&watch, "logs");
+//  uint64_t seen = watch.generation;
+//  ...
+//  fsv_watch_poll(&watch);
+//  const fsv_watch_change_t *changes = NULL;
+//  size_t count = 0;
+//  if (!fsv_watch_changes_since(&watch, seen, &changes, &count)) { ...use watch.files... }
+//  seen = watch.generation;
+//  fsv_watch_close(&watch);
+#ifndef FSV_WATCH_MAX_CHANGES
+#    define FSV_WATCH_MAX_CHANGES (64*1024)
+#endif // FSV_WATCH_MAX_CHANGES
+
+typedef struct fstring_view_watch_change {
+    fsb_t path;
+    uint64_t generation;
+    bool added;  // Otherwise removed
+} fsv_watch_change_t;
+
+typedef struct fstring_view_watch {
+    ffp_t files;          // Same entities as `fsb_read_entire_dir(root, &files, true)`, unordered
+    uint64_t generation;  // Generation of the last change
+    uint64_t trimmed;     // Changes up to this generation were dropped from the log
+    struct {
+        union { size_t size; size_t length; };
+        size_t capacity;
+        fsv_watch_change_t *datas;
+    } changes;            // Oldest first, at most `FSV_WATCH_MAX_CHANGES`
+    fsv_map_t index;      // Path -> index in `files`
+    fsv_map_t dirs;       // Path -> watched directory
+    fsv_map_t watches;    // Watch descriptor -> watched directory
+    struct {
+        union { size_t size; size_t length; };
+        size_t capacity;
+        struct fstring_view_watch_owner *datas;
+    } owners;             // Directory of every entity in `files`
+    fsb_t root;
+    int fd;               // inotify descriptor to poll() on, -1 without inotify
+} fsv_watch_t;
+
+FSV_DEF bool fsv_watch_open(fsv_watch_t *watch, const char *root);
+// Apply the pending events without blocking
+FSV_DEF bool fsv_watch_poll(fsv_watch_t *watch);
+// List the whole tree again and log the difference, done on IN_Q_OVERFLOW
+FSV_DEF bool fsv_watch_resync(fsv_watch_t *watch);
+// Changes made after `generation`, oldest first. They stay valid until the
+// next poll. Return false if some of them were already dropped from the log.
+FSV_DEF bool fsv_watch_changes_since(const fsv_watch_t *watch, uint64_t generation,
+        const fsv_watch_change_t **changes, size_t *count);
+FSV_DEF void fsv_watch_close(fsv_watch_t *watch);
+
+///////////////////////// End of Directory Watcher /////////////////////////
+
 ///////////////////////// Temporary Buffer /////////////////////////
 #ifndef FSV_DISABLE_TMP_BUFFER
 
+// Every thread has its own temporary buffer: a chain of `FSV_TMP_CAPACITY`
+// blocks that grows when full. Save points are offsets into that chain, so
+// `fsv_tmp_rewind` keeps working across blocks. `fsv_tmp_reset` releases every
+// block but the first one and `fsv_tmp_free` releases all of them, call it
+// before a worker thread exits.
 FSV_DEF char  *fsv_tmp_alloc(size_t how_many_chars);
 FSV_DEF void   fsv_tmp_reset(void);
+FSV_DEF void   fsv_tmp_free(void);
 FSV_DEF size_t fsv_tmp_save_point(void);
 FSV_DEF void   fsv_tmp_rewind(size_t checkpoint);
 FSV_DEF char  *fsv_tmp_strdup(const char *cstr);
@@ -223,26 +842,666 @@ FSV_DEF void fsv_log(
 
 #ifdef FSV_IMPLEMENTATION
 
+#include <float.h>
+#include <math.h>
 #include <stdio.h>
+#include <string.h>
+
+///////////////////////// SIMD /////////////////////////
+
+#if !defined(FSV_DISABLE_SIMD) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#    define FSV_SIMD_X86
+#    include <immintrin.h>
+#    define FSV_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#define FSV_SWAR_ONES  (0x0101010101010101ull)
+#define FSV_SWAR_LOWS  (0x7F7F7F7F7F7F7F7Full)
+
+#if !defined(FSV_DISABLE_THREADS) && defined(_WIN32)
+#    include <windows.h>
+#endif
+
+// The first search picks the kernels, on whichever threads make it at once
+static int fsv_simd_current = -1;
+
+static inline int fsv_simd_load(void) {
+#if defined(FSV_DISABLE_THREADS)
+    return fsv_simd_current;
+#elif defined(_WIN32)
+    return (int)InterlockedCompareExchange((volatile LONG*)&fsv_simd_current, 0, 0);
+#else
+    return __atomic_load_n(&fsv_simd_current, __ATOMIC_RELAXED);
+#endif // FSV_DISABLE_THREADS
+}
+
+static inline void fsv_simd_store(int simd) {
+#if defined(FSV_DISABLE_THREADS)
+    fsv_simd_current = simd;
+#elif defined(_WIN32)
+    InterlockedExchange((volatile LONG*)&fsv_simd_current, simd);
+#else
+    __atomic_store_n(&fsv_simd_current, simd, __ATOMIC_RELAXED);
+#endif // FSV_DISABLE_THREADS
+}
+
+FSV_DEF fsv_simd_t fsv_simd_detect(void) {
+#ifdef FSV_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw")) return FSV_SIMD_AVX512;
+    if (__builtin_cpu_supports("avx2"))     return FSV_SIMD_AVX2;
+    return FSV_SIMD_SSE2;
+#else
+    return FSV_SIMD_SWAR;
+#endif // FSV_SIMD_X86
+}
+
+FSV_DEF fsv_simd_t fsv_simd_get(void) {
+    int simd = fsv_simd_load();
+    if (simd < 0) {
+        // Racing threads all detect the same thing
+        simd = (int)fsv_simd_detect();
+        fsv_simd_store(simd);
+    }
+    return (fsv_simd_t)simd;
+}
+
+FSV_DEF fsv_simd_t fsv_simd_set(fsv_simd_t simd) {
+    fsv_simd_t best = fsv_simd_detect();
+    if (simd > best) simd = best;
+    fsv_simd_store((int)simd);
+    return simd;
+}
+
+static inline size_t fsv_ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(x);
+#else
+    size_t n = 0;
+    while ((x & 1) == 0) { x >>= 1; n++; }
+    return n;
+#endif
+}
+
+static inline size_t fsv_popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_popcountll(x);
+#else
+    size_t n = 0;
+    for (; x != 0; x &= x - 1) n++;
+    return n;
+#endif
+}
+
+// Always in little endian order so the first byte in memory is the lowest one
+static inline uint64_t fsv_swar_load(const char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+// High bit of every zero byte in `v` is set, the other bits are cleared
+static inline uint64_t fsv_swar_zeros(uint64_t v) {
+    return ~(((v & FSV_SWAR_LOWS) + FSV_SWAR_LOWS) | v | FSV_SWAR_LOWS);
+}
+
+// Index of the first byte with the high bit set in `mask`
+static inline size_t fsv_swar_first(uint64_t mask) {
+    return fsv_ctz64(mask) / 8;
+}
+
+// Every `fsv_find_*` kernel return the index of the first match or `length` if not found
+static size_t fsv_find_byte_swar(const char *datas, size_t length, char c) {
+    const uint64_t pattern = FSV_SWAR_ONES * (uint8_t)c;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t mask = fsv_swar_zeros(fsv_swar_load(datas + i) ^ pattern);
+        if (mask != 0) return i + fsv_swar_first(mask);
+    }
+    for (; i < length; ++i) {
+        if (datas[i] == c) return i;
+    }
+    return length;
+}
+
+// Number of bytes equal to `c`
+static size_t fsv_count_byte_swar(const char *datas, size_t length, char c) {
+    const uint64_t pattern = FSV_SWAR_ONES * (uint8_t)c;
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        count += fsv_popcount64(fsv_swar_zeros(fsv_swar_load(datas + i) ^ pattern));
+    }
+    for (; i < length; ++i) count += datas[i] == c;
+    return count;
+}
+
+static size_t fsv_find_space_scalar(const char *datas, size_t length) {
+    size_t i = 0;
+    while (i < length && !fsv_is_space(datas[i])) i++;
+    return i;
+}
+
+static size_t fsv_find_any_scalar(const char *datas, size_t length, const fsv_delims_t *delims) {
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4) {
+        if (delims->table[(uint8_t)datas[i]])     return i;
+        if (delims->table[(uint8_t)datas[i + 1]]) return i + 1;
+        if (delims->table[(uint8_t)datas[i + 2]]) return i + 2;
+        if (delims->table[(uint8_t)datas[i + 3]]) return i + 3;
+    }
+    while (i < length && !delims->table[(uint8_t)datas[i]]) i++;
+    return i;
+}
+
+// Lower every ASCII upper case letter of `v`, other bytes are left untouched
+static inline uint64_t fsv_swar_lower(uint64_t v) {
+    uint64_t heptets = v & FSV_SWAR_LOWS;
+    uint64_t ge_A    = heptets + FSV_SWAR_ONES*(0x80 - 'A');
+    uint64_t gt_Z    = heptets + FSV_SWAR_ONES*(0x80 - 'Z' - 1);
+    uint64_t upper   = (ge_A ^ gt_Z) & ~v & ~FSV_SWAR_LOWS;
+    return v | (upper >> 2);
+}
+
+static bool fsv_mem_eq_icase_swar(const char *a, const char *b, size_t length) {
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t x = fsv_swar_load(a + i);
+        uint64_t y = fsv_swar_load(b + i);
+        if (x != y && fsv_swar_lower(x) != fsv_swar_lower(y)) return false;
+    }
+    for (; i < length; ++i) {
+        if (fsv_lower(a[i]) != fsv_lower(b[i])) return false;
+    }
+    return true;
+}
+
+#ifdef FSV_SIMD_X86
+static bool fsv_mem_eq_icase_sse2(const char *a, const char *b, size_t length);
+static bool fsv_mem_eq_icase_avx2(const char *a, const char *b, size_t length);
+#endif // FSV_SIMD_X86
+
+// Comparison core of `fsv_eq`, `fsv_starts_with` and `fsv_ends_with`
+static bool fsv_mem_eq(const char *a, const char *b, size_t length, bool ignore_case) {
+    if (length == 0 || a == b) return true;
+    if (!ignore_case) return memcmp(a, b, length) == 0;
+
+    switch (fsv_simd_get()) {
+#ifdef FSV_SIMD_X86
+    case FSV_SIMD_AVX512:
+    case FSV_SIMD_AVX2:   return fsv_mem_eq_icase_avx2(a, b, length);
+    case FSV_SIMD_SSE2:   return fsv_mem_eq_icase_sse2(a, b, length);
+#endif // FSV_SIMD_X86
+    default:              return fsv_mem_eq_icase_swar(a, b, length);
+    }
+}
+
+// Substring search for needles with 1 <= `m` <= `n` bytes. Candidates are the
+// positions where both the first and the last byte of the needle match, then
+// only the bytes in between are compared.
+// http://0x80.pl/articles/simd-strfind.html
+//
+// When ignoring case, a letter is compared after `| 0x20` which only maps its
+// upper case to its lower case, so the filter stays exact.
+#define FSV_FOLD(c, ignore_case) ((ignore_case) && fsv_is_character(c) ? 0x20 : 0)
+
+static size_t fsv_find_sv_swar(const char *hay, size_t n, const char *needle, size_t m, bool ignore_case) {
+    const size_t   middle     = m > 2 ? m - 2 : 0;
+    const uint8_t  first_fold = FSV_FOLD(needle[0], ignore_case);
+    const uint8_t  last_fold  = FSV_FOLD(needle[m - 1], ignore_case);
+    const uint8_t  first      = (uint8_t)needle[0] | first_fold;
+    const uint8_t  last       = (uint8_t)needle[m - 1] | last_fold;
+    const uint64_t first_pattern = FSV_SWAR_ONES * first;
+    const uint64_t last_pattern  = FSV_SWAR_ONES * last;
+    size_t i = 0;
+    for (; i + m - 1 + 8 <= n; i += 8) {
+        uint64_t mask = fsv_swar_zeros((fsv_swar_load(hay + i) | FSV_SWAR_ONES*first_fold) ^ first_pattern)
+                      & fsv_swar_zeros((fsv_swar_load(hay + i + m - 1) | FSV_SWAR_ONES*last_fold) ^ last_pattern);
+        while (mask != 0) {
+            size_t at = i + fsv_swar_first(mask);
+            if (fsv_mem_eq(hay + at + 1, needle + 1, middle, ignore_case)) return at;
+            mask &= mask - 1;
+        }
+    }
+    for (; i + m <= n; ++i) {
+        if (((uint8_t)hay[i] | first_fold) == first
+            && ((uint8_t)hay[i + m - 1] | last_fold) == last
+            && fsv_mem_eq(hay + i + 1, needle + 1, middle, ignore_case)) {
+            return i;
+        }
+    }
+    return n;
+}
+
+// Boyer-Moore-Horspool for long needles, where skipping by the bad character
+// beats testing every position
+static size_t fsv_find_sv_horspool(const char *hay, size_t n, const char *needle, size_t m, bool ignore_case) {
+    size_t skip[256];
+    for (size_t i = 0; i < 256; ++i) skip[i] = m;
+    for (size_t i = 0; i + 1 < m; ++i) {
+        skip[(uint8_t)needle[i]] = m - 1 - i;
+        if (ignore_case) {
+            skip[(uint8_t)fsv_lower(needle[i])] = m - 1 - i;
+            skip[(uint8_t)fsv_upper(needle[i])] = m - 1 - i;
+        }
+    }
+
+    const char last = ignore_case ? fsv_lower(needle[m - 1]) : needle[m - 1];
+    size_t i = 0;
+    while (i + m <= n) {
+        char c = hay[i + m - 1];
+        if ((ignore_case ? fsv_lower(c) : c) == last && fsv_mem_eq(hay + i, needle, m - 1, ignore_case)) {
+            return i;
+        }
+        i += skip[(uint8_t)c];
+    }
+    return n;
+}
+
+#ifdef FSV_SIMD_X86
+
+FSV_TARGET("sse2")
+static size_t fsv_find_byte_sse2(const char *datas, size_t length, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64) {
+        __m128i a = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(datas + i)),      needle);
+        __m128i b = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(datas + i + 16)), needle);
+        __m128i d = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(datas + i + 32)), needle);
+        __m128i e = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(datas + i + 48)), needle);
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(d, e))) == 0) continue;
+        uint64_t mask = (uint64_t)(uint16_t)_mm_movemask_epi8(a)
+                      | (uint64_t)(uint16_t)_mm_movemask_epi8(b) << 16
+                      | (uint64_t)(uint16_t)_mm_movemask_epi8(d) << 32
+                      | (uint64_t)(uint16_t)_mm_movemask_epi8(e) << 48;
+        return i + fsv_ctz64(mask);
+    }
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(datas + i));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask != 0) return i + fsv_ctz64(mask);
+    }
+    return i + fsv_find_byte_swar(datas + i, length - i, c);
+}
+
+// Matches are subtracted from byte counters, which are summed before they can wrap
+static size_t fsv_count_byte_sse2(const char *datas, size_t length, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    size_t count = 0;
+    size_t i = 0;
+    while (i + 16 <= length) {
+        size_t blocks = (length - i) / 16;
+        if (blocks > 255) blocks = 255;
+        __m128i counts = _mm_setzero_si128();
+        for (size_t b = 0; b < blocks; ++b, i += 16) {
+            counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(datas + i)), needle));
+        }
+        __m128i sums = _mm_sad_epu8(counts, _mm_setzero_si128());
+        count += (size_t)_mm_cvtsi128_si32(sums) + (size_t)_mm_extract_epi16(sums, 4);
+    }
+    return count + fsv_count_byte_swar(datas + i, length - i, c);
+}
+
+FSV_TARGET("avx2")
+static size_t fsv_find_byte_avx2(const char *datas, size_t length, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    size_t i = 0;
+    // Unrolled so the loop is bound by loads instead of branches
+    for (; i + 128 <= length; i += 128) {
+        __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(datas + i)),      needle);
+        __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(datas + i + 32)), needle);
+        __m256i d = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(datas + i + 64)), needle);
+        __m256i e = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(datas + i + 96)), needle);
+        if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(d, e))) == 0) continue;
+        uint64_t lo = (uint32_t)_mm256_movemask_epi8(a) | ((uint64_t)(uint32_t)_mm256_movemask_epi8(b) << 32);
+        if (lo != 0) return i + fsv_ctz64(lo);
+        uint64_t hi = (uint32_t)_mm256_movemask_epi8(d) | ((uint64_t)(uint32_t)_mm256_movemask_epi8(e) << 32);
+        return i + 64 + fsv_ctz64(hi);
+    }
+    for (; i + 32 <= length; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(datas + i));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+        if (mask != 0) return i + fsv_ctz64(mask);
+    }
+    return i + fsv_find_byte_sse2(datas + i, length - i, c);
+}
+
+FSV_TARGET("avx2")
+static size_t fsv_count_byte_avx2(const char *datas, size_t length, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    size_t count = 0;
+    size_t i = 0;
+    while (i + 32 <= length) {
+        size_t blocks = (length - i) / 32;
+        if (blocks > 255) blocks = 255;
+        __m256i counts = _mm256_setzero_si256();
+        for (size_t b = 0; b < blocks; ++b, i += 32) {
+            counts = _mm256_sub_epi8(counts, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(datas + i)), needle));
+        }
+        __m256i wide = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+        __m128i sums = _mm_add_epi64(_mm256_castsi256_si128(wide), _mm256_extracti128_si256(wide, 1));
+        count += (size_t)_mm_cvtsi128_si32(sums) + (size_t)_mm_extract_epi16(sums, 4);
+    }
+    return count + fsv_count_byte_sse2(datas + i, length - i, c);
+}
+
+FSV_TARGET("avx512f,avx512bw")
+static size_t fsv_find_byte_avx512(const char *datas, size_t length, char c) {
+    const __m512i needle = _mm512_set1_epi8(c);
+    size_t i = 0;
+    for (; i + 128 <= length; i += 128) {
+        uint64_t a = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void*)(datas + i)),      needle);
+        uint64_t b = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void*)(datas + i + 64)), needle);
+        if ((a | b) == 0) continue;
+        if (a != 0) return i + fsv_ctz64(a);
+        return i + 64 + fsv_ctz64(b);
+    }
+    for (; i < length; i += 64) {
+        // Masked load never touches the bytes after `length`
+        size_t rest = length - i;
+        __mmask64 valid = rest >= 64 ? ~(__mmask64)0 : (((__mmask64)1 << rest) - 1);
+        __m512i block = _mm512_maskz_loadu_epi8(valid, datas + i);
+        uint64_t mask = _mm512_mask_cmpeq_epi8_mask(valid, block, needle);
+        if (mask != 0) return i + fsv_ctz64(mask);
+    }
+    return length;
+}
+
+// Whitespace is ' ' or any byte in range ['\t', '\r']
+FSV_TARGET("sse2")
+static size_t fsv_find_space_sse2(const char *datas, size_t length) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab   = _mm_set1_epi8('\t');
+    const __m128i range = _mm_set1_epi8('\r' - '\t');
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i block  = _mm_loadu_si128((const __m128i*)(datas + i));
+        __m128i offset = _mm_sub_epi8(block, tab);
+        __m128i found  = _mm_or_si128(_mm_cmpeq_epi8(block, space),
+                                      _mm_cmpeq_epi8(_mm_min_epu8(offset, range), offset));
+        unsigned mask = (unsigned)_mm_movemask_epi8(found);
+        if (mask != 0) return i + fsv_ctz64(mask);
+    }
+    return i + fsv_find_space_scalar(datas + i, length - i);
+}
+
+FSV_TARGET("avx2")
+static size_t fsv_find_space_avx2(const char *datas, size_t length) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab   = _mm256_set1_epi8('\t');
+    const __m256i range = _mm256_set1_epi8('\r' - '\t');
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i block  = _mm256_loadu_si256((const __m256i*)(datas + i));
+        __m256i offset = _mm256_sub_epi8(block, tab);
+        __m256i found  = _mm256_or_si256(_mm256_cmpeq_epi8(block, space),
+                                         _mm256_cmpeq_epi8(_mm256_min_epu8(offset, range), offset));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(found);
+        if (mask != 0) return i + fsv_ctz64(mask);
+    }
+    return i + fsv_find_space_sse2(datas + i, length - i);
+}
+
+FSV_TARGET("avx512f,avx512bw")
+static size_t fsv_find_space_avx512(const char *datas, size_t length) {
+    const __m512i space = _mm512_set1_epi8(' ');
+    const __m512i tab   = _mm512_set1_epi8('\t');
+    const __m512i range = _mm512_set1_epi8('\r' - '\t');
+    for (size_t i = 0; i < length; i += 64) {
+        size_t rest = length - i;
+        __mmask64 valid = rest >= 64 ? ~(__mmask64)0 : (((__mmask64)1 << rest) - 1);
+        __m512i block = _mm512_maskz_loadu_epi8(valid, datas + i);
+        uint64_t mask = _mm512_mask_cmpeq_epi8_mask(valid, block, space)
+                      | _mm512_mask_cmple_epu8_mask(valid, _mm512_sub_epi8(block, tab), range);
+        if (mask != 0) return i + fsv_ctz64(mask);
+    }
+    return length;
+}
+
+// Bit set for every byte of `block` in the set
+FSV_TARGET("avx2")
+static inline uint32_t fsv_match_any_avx2(__m256i block, __m256i low, __m256i high) {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i lo = _mm256_shuffle_epi8(low,  _mm256_and_si256(block, nibble));
+    __m256i hi = _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble));
+    __m256i none = _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256());
+    return ~(uint32_t)_mm256_movemask_epi8(none);
+}
+
+FSV_TARGET("avx2")
+static size_t fsv_find_any_avx2(const char *datas, size_t length, const fsv_delims_t *delims) {
+    const __m256i low  = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)delims->low));
+    const __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)delims->high));
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        uint32_t mask = fsv_match_any_avx2(_mm256_loadu_si256((const __m256i*)(datas + i)), low, high);
+        if (mask != 0) return i + fsv_ctz64(mask);
+    }
+    return i + fsv_find_any_scalar(datas + i, length - i, delims);
+}
+
+// Same 16 bytes in every lane (`_mm512_broadcast_i32x4` triggers -Wuninitialized on GCC)
+FSV_TARGET("avx512f,avx512bw")
+static inline __m512i fsv_broadcast16_avx512(const uint8_t *bytes) {
+    long long lo = (long long)fsv_swar_load((const char*)bytes);
+    long long hi = (long long)fsv_swar_load((const char*)bytes + 8);
+    return _mm512_set4_epi64(hi, lo, hi, lo);
+}
+
+FSV_TARGET("avx512f,avx512bw")
+static inline uint64_t fsv_match_any_avx512(__m512i block, __m512i low, __m512i high) {
+    const __m512i nibble = _mm512_set1_epi8(0x0F);
+    __m512i lo = _mm512_shuffle_epi8(low,  _mm512_and_si512(block, nibble));
+    __m512i hi = _mm512_shuffle_epi8(high, _mm512_and_si512(_mm512_srli_epi16(block, 4), nibble));
+    return _mm512_test_epi8_mask(lo, hi);
+}
+
+FSV_TARGET("avx512f,avx512bw")
+static size_t fsv_find_any_avx512(const char *datas, size_t length, const fsv_delims_t *delims) {
+    const __m512i low  = fsv_broadcast16_avx512(delims->low);
+    const __m512i high = fsv_broadcast16_avx512(delims->high);
+    for (size_t i = 0; i < length; i += 64) {
+        size_t rest = length - i;
+        __mmask64 valid = rest >= 64 ? ~(__mmask64)0 : (((__mmask64)1 << rest) - 1);
+        uint64_t mask = valid & fsv_match_any_avx512(_mm512_maskz_loadu_epi8(valid, datas + i), low, high);
+        if (mask != 0) return i + fsv_ctz64(mask);
+    }
+    return length;
+}
+
+// Lower case of the ASCII letters, `'A' - 1 < c < 'Z' + 1` is false for
+// every byte >= 0x80 because the comparison is signed
+FSV_TARGET("sse2")
+static inline __m128i fsv_lower_sse2(__m128i v) {
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+                                  _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+    return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+FSV_TARGET("sse2")
+static bool fsv_mem_eq_icase_sse2(const char *a, const char *b, size_t length) {
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i y = _mm_loadu_si128((const __m128i*)(b + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) == 0xFFFF) continue;
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(fsv_lower_sse2(x), fsv_lower_sse2(y))) != 0xFFFF) return false;
+    }
+    return fsv_mem_eq_icase_swar(a + i, b + i, length - i);
+}
+
+FSV_TARGET("avx2")
+static inline __m256i fsv_lower_avx2(__m256i v) {
+    __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)),
+                                     _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+    return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+FSV_TARGET("avx2")
+static bool fsv_mem_eq_icase_avx2(const char *a, const char *b, size_t length) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        if ((unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)) == 0xFFFFFFFFu) continue;
+        if ((unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(fsv_lower_avx2(x), fsv_lower_avx2(y))) != 0xFFFFFFFFu) {
+            return false;
+        }
+    }
+    return fsv_mem_eq_icase_sse2(a + i, b + i, length - i);
+}
+
+FSV_TARGET("sse2")
+static size_t fsv_find_sv_sse2(const char *hay, size_t n, const char *needle, size_t m, bool ignore_case) {
+    const size_t  middle     = m > 2 ? m - 2 : 0;
+    const uint8_t first_fold = FSV_FOLD(needle[0], ignore_case);
+    const uint8_t last_fold  = FSV_FOLD(needle[m - 1], ignore_case);
+    const __m128i first      = _mm_set1_epi8((char)((uint8_t)needle[0] | first_fold));
+    const __m128i last       = _mm_set1_epi8((char)((uint8_t)needle[m - 1] | last_fold));
+    const __m128i first_or   = _mm_set1_epi8((char)first_fold);
+    const __m128i last_or    = _mm_set1_epi8((char)last_fold);
+    size_t i = 0;
+    for (; i + m - 1 + 16 <= n; i += 16) {
+        __m128i a = _mm_or_si128(_mm_loadu_si128((const __m128i*)(hay + i)), first_or);
+        __m128i b = _mm_or_si128(_mm_loadu_si128((const __m128i*)(hay + i + m - 1)), last_or);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)));
+        while (mask != 0) {
+            size_t at = i + fsv_ctz64(mask);
+            if (fsv_mem_eq(hay + at + 1, needle + 1, middle, ignore_case)) return at;
+            mask &= mask - 1;
+        }
+    }
+    return i + fsv_find_sv_swar(hay + i, n - i, needle, m, ignore_case);
+}
+
+FSV_TARGET("avx2")
+static size_t fsv_find_sv_avx2(const char *hay, size_t n, const char *needle, size_t m, bool ignore_case) {
+    const size_t  middle     = m > 2 ? m - 2 : 0;
+    const uint8_t first_fold = FSV_FOLD(needle[0], ignore_case);
+    const uint8_t last_fold  = FSV_FOLD(needle[m - 1], ignore_case);
+    const __m256i first      = _mm256_set1_epi8((char)((uint8_t)needle[0] | first_fold));
+    const __m256i last       = _mm256_set1_epi8((char)((uint8_t)needle[m - 1] | last_fold));
+    const __m256i first_or   = _mm256_set1_epi8((char)first_fold);
+    const __m256i last_or    = _mm256_set1_epi8((char)last_fold);
+    size_t i = 0;
+    for (; i + m - 1 + 32 <= n; i += 32) {
+        __m256i a = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(hay + i)), first_or);
+        __m256i b = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(hay + i + m - 1)), last_or);
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last)));
+        while (mask != 0) {
+            size_t at = i + fsv_ctz64(mask);
+            if (fsv_mem_eq(hay + at + 1, needle + 1, middle, ignore_case)) return at;
+            mask &= mask - 1;
+        }
+    }
+    return i + fsv_find_sv_sse2(hay + i, n - i, needle, m, ignore_case);
+}
+
+#endif // FSV_SIMD_X86
+
+static size_t fsv_find_byte(const char *datas, size_t length, char c) {
+    switch (fsv_simd_get()) {
+#ifdef FSV_SIMD_X86
+    case FSV_SIMD_AVX512: return fsv_find_byte_avx512(datas, length, c);
+    case FSV_SIMD_AVX2:   return fsv_find_byte_avx2(datas, length, c);
+    case FSV_SIMD_SSE2:   return fsv_find_byte_sse2(datas, length, c);
+#endif // FSV_SIMD_X86
+    default:              return fsv_find_byte_swar(datas, length, c);
+    }
+}
+
+static size_t fsv_count_byte(const char *datas, size_t length, char c) {
+    switch (fsv_simd_get()) {
+#ifdef FSV_SIMD_X86
+    case FSV_SIMD_AVX512:
+    case FSV_SIMD_AVX2:   return fsv_count_byte_avx2(datas, length, c);
+    case FSV_SIMD_SSE2:   return fsv_count_byte_sse2(datas, length, c);
+#endif // FSV_SIMD_X86
+    default:              return fsv_count_byte_swar(datas, length, c);
+    }
+}
+
+static size_t fsv_find_space(const char *datas, size_t length) {
+    switch (fsv_simd_get()) {
+#ifdef FSV_SIMD_X86
+    case FSV_SIMD_AVX512: return fsv_find_space_avx512(datas, length);
+    case FSV_SIMD_AVX2:   return fsv_find_space_avx2(datas, length);
+    case FSV_SIMD_SSE2:   return fsv_find_space_sse2(datas, length);
+#endif // FSV_SIMD_X86
+    default:              return fsv_find_space_scalar(datas, length);
+    }
+}
+
+static size_t fsv_find_any(const char *datas, size_t length, const fsv_delims_t *delims) {
+    if (!delims->vectorized) return fsv_find_any_scalar(datas, length, delims);
+    switch (fsv_simd_get()) {
+#ifdef FSV_SIMD_X86
+    case FSV_SIMD_AVX512: return fsv_find_any_avx512(datas, length, delims);
+    case FSV_SIMD_AVX2:   return fsv_find_any_avx2(datas, length, delims);
+#endif // FSV_SIMD_X86
+    default:              return fsv_find_any_scalar(datas, length, delims);
+    }
+}
+
+#ifndef FSV_SEARCH_LONG_NEEDLE
+#define FSV_SEARCH_LONG_NEEDLE (32)
+#endif // FSV_SEARCH_LONG_NEEDLE
+
+static size_t fsv_find_sv(const char *hay, size_t n, const char *needle, size_t m, bool ignore_case) {
+    if (m == 0) return 0;
+    if (m > n) return n;
+    if (m == 1 && !(ignore_case && fsv_is_character(needle[0]))) return fsv_find_byte(hay, n, needle[0]);
+    if (m >= FSV_SEARCH_LONG_NEEDLE) return fsv_find_sv_horspool(hay, n, needle, m, ignore_case);
+
+    switch (fsv_simd_get()) {
+#ifdef FSV_SIMD_X86
+    case FSV_SIMD_AVX512:
+    case FSV_SIMD_AVX2:   return fsv_find_sv_avx2(hay, n, needle, m, ignore_case);
+    case FSV_SIMD_SSE2:   return fsv_find_sv_sse2(hay, n, needle, m, ignore_case);
+#endif // FSV_SIMD_X86
+    default:              return fsv_find_sv_swar(hay, n, needle, m, ignore_case);
+    }
+}
+
+///////////////////////// End of SIMD /////////////////////////
 
 ///////////////////////// String View /////////////////////////
 
 FSV_DEF fsv_t fsv_from_cstr(const char *string) {
-    return fsv_from_partial_cstr(string, fsv_strlen(string));
+    return fsv_from_parts(string, fsv_strlen(string));
 }
 
 FSV_DEF fsv_t fsv_from_partial_cstr(const char *string, const size_t length) {
     fsv_t ret = {};
-    if (length == 0) return ret;
-    size_t len = fsv_strlen(string);
-    ret.length = length > len ? len : length;
+    if (length == 0 || string == NULL) return ret;
+    // Never look further than `length` for the null-terminator
+    size_t len = 0;
+    while (len < length && string[len] != '\0') len++;
+    ret.length = len;
     ret.datas = string;
 
     return ret;
 }
 
+FSV_DEF fsv_t fsv_from_parts(const char *datas, const size_t length) {
+    fsv_t ret;
+    ret.length = datas == NULL ? 0 : length;
+    ret.datas  = datas;
+    return ret;
+}
+
 FSV_DEF fsv_t fsv_from_sv(const fsv_t sv, const size_t length) {
-    return fsv_from_partial_cstr(sv.datas, length);
+    return fsv_slice(sv, 0, length);
+}
+
+FSV_DEF fsv_t fsv_slice(const fsv_t sv, const size_t start, const size_t length) {
+    if (sv.datas == NULL) return fsv_from_parts(NULL, 0);
+    size_t from = start > sv.length ? sv.length : start;
+    size_t rest = sv.length - from;
+    return fsv_from_parts(sv.datas + from, length > rest ? rest : length);
 }
 
 FSV_DEF fsv_t fsv_trim(fsv_t sv) {
@@ -254,7 +1513,7 @@ FSV_DEF fsv_t fsv_trim_left(fsv_t sv) {
     while (i < sv.length && fsv_is_space(sv.datas[i])) {
         i++;
     }
-    return fsv_from_partial_cstr(sv.datas + i, sv.length - i);
+    return fsv_from_parts(sv.datas + i, sv.length - i);
 }
 
 FSV_DEF fsv_t fsv_trim_right(fsv_t sv) {
@@ -262,14 +1521,70 @@ FSV_DEF fsv_t fsv_trim_right(fsv_t sv) {
     while (i < sv.length && fsv_is_space(sv.datas[sv.length - i - 1])) {
         i++;
     }
-    return fsv_from_partial_cstr(sv.datas, sv.length - i);
+    return fsv_from_parts(sv.datas, sv.length - i);
 }
 
 FSV_DEF int fsv_index_of(fsv_t sv, char c) {
-    size_t index = 0;
-    while (index < sv.length && sv.datas[index] != c) {
-        index++;
+    size_t index = fsv_find_byte(sv.datas, sv.length, c);
+    if (index < sv.length) return (int)index;
+    return -1;
+}
+
+FSV_DEF int fsv_index_of_sv(fsv_t sv, fsv_t needle, bool ignore_case) {
+    if (needle.length == 0 || needle.datas == NULL) return -1;
+    size_t index = fsv_find_sv(sv.datas, sv.length, needle.datas, needle.length, ignore_case);
+    if (index < sv.length) return (int)index;
+    return -1;
+}
+
+FSV_DEF fsv_delims_t fsv_delims_from_sv(fsv_t set) {
+    fsv_delims_t delims = {};
+    uint8_t high_nibbles[16] = {0};
+    uint8_t low_nibbles[16]  = {0};
+    size_t high_count = 0;
+    size_t low_count  = 0;
+
+    for (size_t i = 0; i < set.length; ++i) {
+        uint8_t c = (uint8_t)set.datas[i];
+        if (delims.table[c]) continue;
+        delims.table[c] = true;
+        if (!high_nibbles[c >> 4]++) high_count++;
+        if (!low_nibbles[c & 0xF]++) low_count++;
+    }
+
+    // Give every distinct high (or low) nibble its own bit, then a byte is in
+    // the set only if its other nibble was seen together with that one.
+    // Need at most 8 distinct nibbles on one side since there are 8 bits.
+    bool by_high = high_count <= 8;
+    delims.vectorized = by_high || low_count <= 8;
+    if (!delims.vectorized) return delims;
+
+    uint8_t bucket[16] = {0};
+    uint8_t bucket_count = 0;
+    uint8_t *nibbles = by_high ? high_nibbles : low_nibbles;
+    for (size_t n = 0; n < 16; ++n) {
+        if (nibbles[n]) bucket[n] = (uint8_t)(1u << bucket_count++);
     }
+    for (size_t c = 0; c < 256; ++c) {
+        if (!delims.table[c]) continue;
+        size_t hi = c >> 4, lo = c & 0xF;
+        if (by_high) {
+            delims.high[hi]  = bucket[hi];
+            delims.low[lo]  |= bucket[hi];
+        } else {
+            delims.low[lo]   = bucket[lo];
+            delims.high[hi] |= bucket[lo];
+        }
+    }
+    return delims;
+}
+
+FSV_DEF fsv_delims_t fsv_delims_from_cstr(const char *set) {
+    return fsv_delims_from_sv(fsv_from_cstr(set));
+}
+
+FSV_DEF int fsv_index_of_any(fsv_t sv, const fsv_delims_t *delims) {
+    size_t index = fsv_find_any(sv.datas, sv.length, delims);
     if (index < sv.length) return (int)index;
     return -1;
 }
@@ -315,19 +1630,7 @@ FSV_DEF bool fsv_is_alphanumeric(char c) {
 
 FSV_DEF bool fsv_eq(fsv_t sv1, fsv_t sv2, bool ignore_case) {
     if (sv1.length != sv2.length) return false;
-
-    char a, b;
-    for (size_t i = 0; i < sv1.length; ++i) {
-        if (ignore_case) {
-            a = fsv_lower(sv1.datas[i]);
-            b = fsv_lower(sv2.datas[i]);
-        } else {
-            a = sv1.datas[i];
-            b = sv2.datas[i];
-        }
-        if (a != b) return false;
-    }
-    return true;
+    return fsv_mem_eq(sv1.datas, sv2.datas, sv1.length, ignore_case);
 }
 
 FSV_DEF bool fsv_eq_cstr(fsv_t sv1, const char *string, bool ignore_case) {
@@ -336,8 +1639,7 @@ FSV_DEF bool fsv_eq_cstr(fsv_t sv1, const char *string, bool ignore_case) {
 
 FSV_DEF bool fsv_starts_with(fsv_t sv, fsv_t prefix, bool ignore_case) {
     if (prefix.length > sv.length) return false;
-    fsv_t new_sv = fsv_from_partial_cstr(sv.datas, prefix.length);
-    return fsv_eq(new_sv, prefix, ignore_case);
+    return fsv_mem_eq(sv.datas, prefix.datas, prefix.length, ignore_case);
 }
 
 FSV_DEF bool fsv_starts_with_cstr(fsv_t sv, const char *prefix, bool ignore_case) {
@@ -346,55 +1648,136 @@ FSV_DEF bool fsv_starts_with_cstr(fsv_t sv, const char *prefix, bool ignore_case
 
 FSV_DEF bool fsv_ends_with(fsv_t sv, fsv_t suffix, bool ignore_case) {
     if (suffix.length > sv.length) return false;
-    fsv_t new_sv = fsv_from_partial_cstr(sv.datas + (sv.length - suffix.length), suffix.length);
-    return fsv_eq(new_sv, suffix, ignore_case);
+    return fsv_mem_eq(sv.datas + (sv.length - suffix.length), suffix.datas, suffix.length, ignore_case);
 }
 
 FSV_DEF bool fsv_ends_with_cstr(fsv_t sv, const char *suffix, bool ignore_case) {
     return fsv_ends_with(sv, fsv_from_cstr(suffix), ignore_case);
 }
 
-FSV_DEF bool fsv_split(fsv_t *sv, fsv_t *out) {
-    for (size_t i = 0; i < sv->length; ++i) {
-        if (fsv_is_space(sv->datas[i]))
-            return fsv_split_by_delim(sv, sv->datas[i], out);
-    }
-    return false;
+// Port of wyhash final 4 by Wang Yi: https://github.com/wangyi-fudan/wyhash
+static const uint64_t fsv_hash_secret[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+// 64x64 -> 128 bit multiplication, `*a` gets the low half and `*b` the high half
+static inline void fsv_hash_mum(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha*hb, rm0 = ha*lb, rm1 = hb*la, rl = la*lb, t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif // __SIZEOF_INT128__
 }
 
-FSV_DEF bool fsv_split_by_delim(fsv_t *sv, char delim, fsv_t *out) {
-    // This is basically:
-    //     return fsv_split_by_sv(sv, fsv_from_partial_cstr(&delim, 1), false, out);
-    // But I'm currently too dumb to know why valgrind doesn' t like this approach
-    size_t save_point = fsv_tmp_save_point();
-    char *datas = fsv_tmp_alloc(1); datas[0] = delim;
-    bool ret = fsv_split_by_sv(sv, fsv_from_partial_cstr(datas, 1), false, out);
+static inline uint64_t fsv_hash_mix(uint64_t a, uint64_t b) {
+    fsv_hash_mum(&a, &b);
+    return a ^ b;
+}
 
-    fsv_tmp_rewind(save_point);
-    return ret;
+static inline uint64_t fsv_hash_r8(const char *p, bool fold) {
+    uint64_t v = fsv_swar_load(p);
+    return fold ? fsv_swar_lower(v) : v;
 }
 
-FSV_DEF bool fsv_split_by_sv(fsv_t *sv, fsv_t delim, bool ignore_case, fsv_t *out) {
-    if (sv->length == 0 || sv->datas == NULL) return false;
-    if (delim.length == 0 || delim.datas == NULL) return false;
+static inline uint64_t fsv_hash_r4(const char *p, bool fold) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return fold ? fsv_swar_lower(v) : v;
+}
 
-    size_t index = 0;
-    bool found = false;
-    fsv_t window = fsv_from_partial_cstr(sv->datas, delim.length);
-    while (true) {
-        if (index + delim.length > sv->length) break;
-        if (fsv_eq(delim, window, ignore_case)) { found = true; break; }
-        index++; window.datas++;
-    }
+static inline uint64_t fsv_hash_r3(const char *p, size_t k, bool fold) {
+    uint64_t v = ((uint64_t)(uint8_t)p[0] << 16) | ((uint64_t)(uint8_t)p[k >> 1] << 8) | (uint8_t)p[k - 1];
+    return fold ? fsv_swar_lower(v) : v;
+}
 
-    if (found) {
-        out->datas  = sv->datas;
-        out->length = index;
-        sv->datas  += index + delim.length;
-        sv->length -= index + delim.length;
-        return true;
+// `fold` is always a constant so each caller gets its own copy without the branches
+static inline uint64_t fsv_hash_bytes(const char *p, size_t length, uint64_t seed, bool fold) {
+    const uint64_t *s = fsv_hash_secret;
+    uint64_t a = 0, b = 0;
+    seed ^= fsv_hash_mix(seed ^ s[0], s[1]);
+    if (length <= 16) {
+        if (length >= 4) {
+            size_t shift = (length >> 3) << 2;
+            a = (fsv_hash_r4(p, fold) << 32) | fsv_hash_r4(p + shift, fold);
+            b = (fsv_hash_r4(p + length - 4, fold) << 32) | fsv_hash_r4(p + length - 4 - shift, fold);
+        } else if (length > 0) {
+            a = fsv_hash_r3(p, length, fold);
+        }
+    } else {
+        size_t i = length;
+        if (i >= 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = fsv_hash_mix(fsv_hash_r8(p,      fold) ^ s[1], fsv_hash_r8(p +  8, fold) ^ seed);
+                see1 = fsv_hash_mix(fsv_hash_r8(p + 16, fold) ^ s[2], fsv_hash_r8(p + 24, fold) ^ see1);
+                see2 = fsv_hash_mix(fsv_hash_r8(p + 32, fold) ^ s[3], fsv_hash_r8(p + 40, fold) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i >= 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = fsv_hash_mix(fsv_hash_r8(p, fold) ^ s[1], fsv_hash_r8(p + 8, fold) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = fsv_hash_r8(p + i - 16, fold);
+        b = fsv_hash_r8(p + i - 8, fold);
     }
-    return false;
+    a ^= s[1];
+    b ^= seed;
+    fsv_hash_mum(&a, &b);
+    return fsv_hash_mix(a ^ s[0] ^ length, b ^ s[1]);
+}
+
+FSV_DEF uint64_t fsv_hash(fsv_t sv, uint64_t seed, bool ignore_case) {
+    if (sv.datas == NULL) sv.length = 0;
+    if (ignore_case) return fsv_hash_bytes(sv.datas, sv.length, seed, true);
+    return fsv_hash_bytes(sv.datas, sv.length, seed, false);
+}
+
+// Cut `sv` at `index`: `out` is everything before it and `sv` is everything
+// after the `delim_length` bytes of the delimiter
+static inline bool fsv_split_at(fsv_t *sv, size_t index, size_t delim_length, fsv_t *out) {
+    if (index >= sv->length) return false;
+    out->datas  = sv->datas;
+    out->length = index;
+    sv->datas  += index + delim_length;
+    sv->length -= index + delim_length;
+    return true;
+}
+
+FSV_DEF bool fsv_split(fsv_t *sv, fsv_t *out) {
+    if (sv->length == 0 || sv->datas == NULL) return false;
+    return fsv_split_at(sv, fsv_find_space(sv->datas, sv->length), 1, out);
+}
+
+FSV_DEF bool fsv_split_by_any(fsv_t *sv, const fsv_delims_t *delims, fsv_t *out) {
+    if (sv->length == 0 || sv->datas == NULL) return false;
+    return fsv_split_at(sv, fsv_find_any(sv->datas, sv->length, delims), 1, out);
+}
+
+FSV_DEF bool fsv_split_by_delim(fsv_t *sv, char delim, fsv_t *out) {
+    if (sv->length == 0 || sv->datas == NULL) return false;
+    return fsv_split_at(sv, fsv_find_byte(sv->datas, sv->length, delim), 1, out);
+}
+
+FSV_DEF bool fsv_split_by_sv(fsv_t *sv, fsv_t delim, bool ignore_case, fsv_t *out) {
+    if (sv->length == 0 || sv->datas == NULL) return false;
+    if (delim.length == 0 || delim.datas == NULL) return false;
+    return fsv_split_at(sv, fsv_find_sv(sv->datas, sv->length, delim.datas, delim.length, ignore_case),
+                        delim.length, out);
 }
 
 FSV_DEF bool fsv_split_by_cstr(fsv_t *sv, const char *delim, bool ignore_case, fsv_t *out) {
@@ -404,23 +1787,1081 @@ FSV_DEF bool fsv_split_by_cstr(fsv_t *sv, const char *delim, bool ignore_case, f
 FSV_DEF bool fsv_split_by_pair(fsv_t *right, const char *pair, fsv_t *middle, fsv_t *left) {
     FSV_ASSERT(fsv_strlen(pair) == 2);
 
-    bool first = false;
-    bool second = false;
-    for (size_t i = 0; i < right->length; ++i) {
-        if (right->datas[i] == pair[0]) first = true;
-        if (right->datas[i] == pair[1]) second = true;
-        if (first && second) break;
-    }
-    if (!first || !second) return false;
+    if (fsv_find_byte(right->datas, right->length, pair[0]) >= right->length) return false;
+    if (fsv_find_byte(right->datas, right->length, pair[1]) >= right->length) return false;
 
-    fsv_split_by_sv(right, fsv_from_partial_cstr(pair, 1), false, left);
-    fsv_split_by_sv(right, fsv_from_partial_cstr(pair + 1, 1), false, middle);
+    fsv_split_by_delim(right, pair[0], left);
+    fsv_split_by_delim(right, pair[1], middle);
 
     return true;
 }
 
+// All 8 bytes of `v` are between '0' and '9'
+static inline bool fsv_swar_is_8_digits(uint64_t v) {
+    return ((v & 0xF0F0F0F0F0F0F0F0ull) == 0x3030303030303030ull)
+        && (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) == 0x3030303030303030ull);
+}
+
+// 8 digits at once, the first digit is the lowest byte
+static inline uint64_t fsv_swar_parse_8_digits(uint64_t v) {
+    v = ((v & 0x0F0F0F0F0F0F0F0Full)*2561) >> 8;                // Pairs of digits
+    v = ((v & 0x00FF00FF00FF00FFull)*6553601) >> 16;            // Groups of 4 digits
+    return ((v & 0x0000FFFF0000FFFFull)*42949672960001ull) >> 32;
+}
+
+// Parse the digits at the start of `datas`, return how many there are
+static size_t fsv_parse_digits(const char *datas, size_t length, uint64_t *out, bool *overflow) {
+    uint64_t value = 0;
+    size_t i = 0;
+    // 16 digits always fit, past that every digit checks for overflow
+    while (i + 8 <= length && i + 8 <= 16) {
+        uint64_t chunk = fsv_swar_load(datas + i);
+        if (!fsv_swar_is_8_digits(chunk)) break;
+        value = value*100000000 + fsv_swar_parse_8_digits(chunk);
+        i += 8;
+    }
+    *overflow = false;
+    for (; i < length && fsv_is_digit(datas[i]); ++i) {
+        uint64_t digit = (uint64_t)(datas[i] - '0');
+        if (value > (UINT64_MAX - digit)/10) *overflow = true;
+        if (!*overflow) value = value*10 + digit;
+    }
+    *out = *overflow ? UINT64_MAX : value;
+    return i;
+}
+
+FSV_DEF fsv_parse_status_t fsv_parse_u64(fsv_t *sv, uint64_t *out) {
+    if (sv->length == 0 || sv->datas == NULL) return FSV_PARSE_INVALID;
+    bool overflow = false;
+    uint64_t value = 0;
+    size_t length = fsv_parse_digits(sv->datas, sv->length, &value, &overflow);
+    if (length == 0) return FSV_PARSE_INVALID;
+
+    *out = value;
+    sv->datas  += length;
+    sv->length -= length;
+    return overflow ? FSV_PARSE_OVERFLOW : FSV_PARSE_OK;
+}
+
+FSV_DEF fsv_parse_status_t fsv_parse_i64(fsv_t *sv, int64_t *out) {
+    if (sv->length == 0 || sv->datas == NULL) return FSV_PARSE_INVALID;
+    bool negative = sv->datas[0] == '-';
+    size_t sign = (negative || sv->datas[0] == '+') ? 1 : 0;
+    bool overflow = false;
+    uint64_t value = 0;
+    size_t length = fsv_parse_digits(sv->datas + sign, sv->length - sign, &value, &overflow);
+    if (length == 0) return FSV_PARSE_INVALID;
+
+    // -INT64_MIN does not fit in an int64_t but does in an uint64_t
+    const uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    if (overflow || value > limit) {
+        overflow = true;
+        *out = negative ? INT64_MIN : INT64_MAX;
+    } else {
+        *out = negative ? (int64_t)(0 - value) : (int64_t)value;
+    }
+    sv->datas  += sign + length;
+    sv->length -= sign + length;
+    return overflow ? FSV_PARSE_OVERFLOW : FSV_PARSE_OK;
+}
+
+// Floating point parsing is Eisel-Lemire as done by fast_float: https://github.com/fastfloat/fast_float
+// and "Number Parsing at a Gigabyte per Second" by Daniel Lemire
+#define FSV_POW5_MIN_EXPONENT (-342)
+#define FSV_POW5_MAX_EXPONENT (308)
+
+// 5^q for q in [-342, 308] rounded to 128 bits, most significant bit first
+static const uint64_t fsv_pow5_128[2*(FSV_POW5_MAX_EXPONENT - FSV_POW5_MIN_EXPONENT + 1)] = {
+    0xeef453d6923bd65aull, 0x113faa2906a13b3full,
+    0x9558b4661b6565f8ull, 0x4ac7ca59a424c507ull,
+    0xbaaee17fa23ebf76ull, 0x5d79bcf00d2df649ull,
+    0xe95a99df8ace6f53ull, 0xf4d82c2c107973dcull,
+    0x91d8a02bb6c10594ull, 0x79071b9b8a4be869ull,
+    0xb64ec836a47146f9ull, 0x9748e2826cdee284ull,
+    0xe3e27a444d8d98b7ull, 0xfd1b1b2308169b25ull,
+    0x8e6d8c6ab0787f72ull, 0xfe30f0f5e50e20f7ull,
+    0xb208ef855c969f4full, 0xbdbd2d335e51a935ull,
+    0xde8b2b66b3bc4723ull, 0xad2c788035e61382ull,
+    0x8b16fb203055ac76ull, 0x4c3bcb5021afcc31ull,
+    0xaddcb9e83c6b1793ull, 0xdf4abe242a1bbf3dull,
+    0xd953e8624b85dd78ull, 0xd71d6dad34a2af0dull,
+    0x87d4713d6f33aa6bull, 0x8672648c40e5ad68ull,
+    0xa9c98d8ccb009506ull, 0x680efdaf511f18c2ull,
+    0xd43bf0effdc0ba48ull, 0x0212bd1b2566def2ull,
+    0x84a57695fe98746dull, 0x014bb630f7604b57ull,
+    0xa5ced43b7e3e9188ull, 0x419ea3bd35385e2dull,
+    0xcf42894a5dce35eaull, 0x52064cac828675b9ull,
+    0x818995ce7aa0e1b2ull, 0x7343efebd1940993ull,
+    0xa1ebfb4219491a1full, 0x1014ebe6c5f90bf8ull,
+    0xca66fa129f9b60a6ull, 0xd41a26e077774ef6ull,
+    0xfd00b897478238d0ull, 0x8920b098955522b4ull,
+    0x9e20735e8cb16382ull, 0x55b46e5f5d5535b0ull,
+    0xc5a890362fddbc62ull, 0xeb2189f734aa831dull,
+    0xf712b443bbd52b7bull, 0xa5e9ec7501d523e4ull,
+    0x9a6bb0aa55653b2dull, 0x47b233c92125366eull,
+    0xc1069cd4eabe89f8ull, 0x999ec0bb696e840aull,
+    0xf148440a256e2c76ull, 0xc00670ea43ca250dull,
+    0x96cd2a865764dbcaull, 0x380406926a5e5728ull,
+    0xbc807527ed3e12bcull, 0xc605083704f5ecf2ull,
+    0xeba09271e88d976bull, 0xf7864a44c633682eull,
+    0x93445b8731587ea3ull, 0x7ab3ee6afbe0211dull,
+    0xb8157268fdae9e4cull, 0x5960ea05bad82964ull,
+    0xe61acf033d1a45dfull, 0x6fb92487298e33bdull,
+    0x8fd0c16206306babull, 0xa5d3b6d479f8e056ull,
+    0xb3c4f1ba87bc8696ull, 0x8f48a4899877186cull,
+    0xe0b62e2929aba83cull, 0x331acdabfe94de87ull,
+    0x8c71dcd9ba0b4925ull, 0x9ff0c08b7f1d0b14ull,
+    0xaf8e5410288e1b6full, 0x07ecf0ae5ee44dd9ull,
+    0xdb71e91432b1a24aull, 0xc9e82cd9f69d6150ull,
+    0x892731ac9faf056eull, 0xbe311c083a225cd2ull,
+    0xab70fe17c79ac6caull, 0x6dbd630a48aaf406ull,
+    0xd64d3d9db981787dull, 0x092cbbccdad5b108ull,
+    0x85f0468293f0eb4eull, 0x25bbf56008c58ea5ull,
+    0xa76c582338ed2621ull, 0xaf2af2b80af6f24eull,
+    0xd1476e2c07286faaull, 0x1af5af660db4aee1ull,
+    0x82cca4db847945caull, 0x50d98d9fc890ed4dull,
+    0xa37fce126597973cull, 0xe50ff107bab528a0ull,
+    0xcc5fc196fefd7d0cull, 0x1e53ed49a96272c8ull,
+    0xff77b1fcbebcdc4full, 0x25e8e89c13bb0f7aull,
+    0x9faacf3df73609b1ull, 0x77b191618c54e9acull,
+    0xc795830d75038c1dull, 0xd59df5b9ef6a2417ull,
+    0xf97ae3d0d2446f25ull, 0x4b0573286b44ad1dull,
+    0x9becce62836ac577ull, 0x4ee367f9430aec32ull,
+    0xc2e801fb244576d5ull, 0x229c41f793cda73full,
+    0xf3a20279ed56d48aull, 0x6b43527578c1110full,
+    0x9845418c345644d6ull, 0x830a13896b78aaa9ull,
+    0xbe5691ef416bd60cull, 0x23cc986bc656d553ull,
+    0xedec366b11c6cb8full, 0x2cbfbe86b7ec8aa8ull,
+    0x94b3a202eb1c3f39ull, 0x7bf7d71432f3d6a9ull,
+    0xb9e08a83a5e34f07ull, 0xdaf5ccd93fb0cc53ull,
+    0xe858ad248f5c22c9ull, 0xd1b3400f8f9cff68ull,
+    0x91376c36d99995beull, 0x23100809b9c21fa1ull,
+    0xb58547448ffffb2dull, 0xabd40a0c2832a78aull,
+    0xe2e69915b3fff9f9ull, 0x16c90c8f323f516cull,
+    0x8dd01fad907ffc3bull, 0xae3da7d97f6792e3ull,
+    0xb1442798f49ffb4aull, 0x99cd11cfdf41779cull,
+    0xdd95317f31c7fa1dull, 0x40405643d711d583ull,
+    0x8a7d3eef7f1cfc52ull, 0x482835ea666b2572ull,
+    0xad1c8eab5ee43b66ull, 0xda3243650005eecfull,
+    0xd863b256369d4a40ull, 0x90bed43e40076a82ull,
+    0x873e4f75e2224e68ull, 0x5a7744a6e804a291ull,
+    0xa90de3535aaae202ull, 0x711515d0a205cb36ull,
+    0xd3515c2831559a83ull, 0x0d5a5b44ca873e03ull,
+    0x8412d9991ed58091ull, 0xe858790afe9486c2ull,
+    0xa5178fff668ae0b6ull, 0x626e974dbe39a872ull,
+    0xce5d73ff402d98e3ull, 0xfb0a3d212dc8128full,
+    0x80fa687f881c7f8eull, 0x7ce66634bc9d0b99ull,
+    0xa139029f6a239f72ull, 0x1c1fffc1ebc44e80ull,
+    0xc987434744ac874eull, 0xa327ffb266b56220ull,
+    0xfbe9141915d7a922ull, 0x4bf1ff9f0062baa8ull,
+    0x9d71ac8fada6c9b5ull, 0x6f773fc3603db4a9ull,
+    0xc4ce17b399107c22ull, 0xcb550fb4384d21d3ull,
+    0xf6019da07f549b2bull, 0x7e2a53a146606a48ull,
+    0x99c102844f94e0fbull, 0x2eda7444cbfc426dull,
+    0xc0314325637a1939ull, 0xfa911155fefb5308ull,
+    0xf03d93eebc589f88ull, 0x793555ab7eba27caull,
+    0x96267c7535b763b5ull, 0x4bc1558b2f3458deull,
+    0xbbb01b9283253ca2ull, 0x9eb1aaedfb016f16ull,
+    0xea9c227723ee8bcbull, 0x465e15a979c1cadcull,
+    0x92a1958a7675175full, 0x0bfacd89ec191ec9ull,
+    0xb749faed14125d36ull, 0xcef980ec671f667bull,
+    0xe51c79a85916f484ull, 0x82b7e12780e7401aull,
+    0x8f31cc0937ae58d2ull, 0xd1b2ecb8b0908810ull,
+    0xb2fe3f0b8599ef07ull, 0x861fa7e6dcb4aa15ull,
+    0xdfbdcece67006ac9ull, 0x67a791e093e1d49aull,
+    0x8bd6a141006042bdull, 0xe0c8bb2c5c6d24e0ull,
+    0xaecc49914078536dull, 0x58fae9f773886e18ull,
+    0xda7f5bf590966848ull, 0xaf39a475506a899eull,
+    0x888f99797a5e012dull, 0x6d8406c952429603ull,
+    0xaab37fd7d8f58178ull, 0xc8e5087ba6d33b83ull,
+    0xd5605fcdcf32e1d6ull, 0xfb1e4a9a90880a64ull,
+    0x855c3be0a17fcd26ull, 0x5cf2eea09a55067full,
+    0xa6b34ad8c9dfc06full, 0xf42faa48c0ea481eull,
+    0xd0601d8efc57b08bull, 0xf13b94daf124da26ull,
+    0x823c12795db6ce57ull, 0x76c53d08d6b70858ull,
+    0xa2cb1717b52481edull, 0x54768c4b0c64ca6eull,
+    0xcb7ddcdda26da268ull, 0xa9942f5dcf7dfd09ull,
+    0xfe5d54150b090b02ull, 0xd3f93b35435d7c4cull,
+    0x9efa548d26e5a6e1ull, 0xc47bc5014a1a6dafull,
+    0xc6b8e9b0709f109aull, 0x359ab6419ca1091bull,
+    0xf867241c8cc6d4c0ull, 0xc30163d203c94b62ull,
+    0x9b407691d7fc44f8ull, 0x79e0de63425dcf1dull,
+    0xc21094364dfb5636ull, 0x985915fc12f542e4ull,
+    0xf294b943e17a2bc4ull, 0x3e6f5b7b17b2939dull,
+    0x979cf3ca6cec5b5aull, 0xa705992ceecf9c42ull,
+    0xbd8430bd08277231ull, 0x50c6ff782a838353ull,
+    0xece53cec4a314ebdull, 0xa4f8bf5635246428ull,
+    0x940f4613ae5ed136ull, 0x871b7795e136be99ull,
+    0xb913179899f68584ull, 0x28e2557b59846e3full,
+    0xe757dd7ec07426e5ull, 0x331aeada2fe589cfull,
+    0x9096ea6f3848984full, 0x3ff0d2c85def7621ull,
+    0xb4bca50b065abe63ull, 0x0fed077a756b53a9ull,
+    0xe1ebce4dc7f16dfbull, 0xd3e8495912c62894ull,
+    0x8d3360f09cf6e4bdull, 0x64712dd7abbbd95cull,
+    0xb080392cc4349decull, 0xbd8d794d96aacfb3ull,
+    0xdca04777f541c567ull, 0xecf0d7a0fc5583a0ull,
+    0x89e42caaf9491b60ull, 0xf41686c49db57244ull,
+    0xac5d37d5b79b6239ull, 0x311c2875c522ced5ull,
+    0xd77485cb25823ac7ull, 0x7d633293366b828bull,
+    0x86a8d39ef77164bcull, 0xae5dff9c02033197ull,
+    0xa8530886b54dbdebull, 0xd9f57f830283fdfcull,
+    0xd267caa862a12d66ull, 0xd072df63c324fd7bull,
+    0x8380dea93da4bc60ull, 0x4247cb9e59f71e6dull,
+    0xa46116538d0deb78ull, 0x52d9be85f074e608ull,
+    0xcd795be870516656ull, 0x67902e276c921f8bull,
+    0x806bd9714632dff6ull, 0x00ba1cd8a3db53b6ull,
+    0xa086cfcd97bf97f3ull, 0x80e8a40eccd228a4ull,
+    0xc8a883c0fdaf7df0ull, 0x6122cd128006b2cdull,
+    0xfad2a4b13d1b5d6cull, 0x796b805720085f81ull,
+    0x9cc3a6eec6311a63ull, 0xcbe3303674053bb0ull,
+    0xc3f490aa77bd60fcull, 0xbedbfc4411068a9cull,
+    0xf4f1b4d515acb93bull, 0xee92fb5515482d44ull,
+    0x991711052d8bf3c5ull, 0x751bdd152d4d1c4aull,
+    0xbf5cd54678eef0b6ull, 0xd262d45a78a0635dull,
+    0xef340a98172aace4ull, 0x86fb897116c87c34ull,
+    0x9580869f0e7aac0eull, 0xd45d35e6ae3d4da0ull,
+    0xbae0a846d2195712ull, 0x8974836059cca109ull,
+    0xe998d258869facd7ull, 0x2bd1a438703fc94bull,
+    0x91ff83775423cc06ull, 0x7b6306a34627ddcfull,
+    0xb67f6455292cbf08ull, 0x1a3bc84c17b1d542ull,
+    0xe41f3d6a7377eecaull, 0x20caba5f1d9e4a93ull,
+    0x8e938662882af53eull, 0x547eb47b7282ee9cull,
+    0xb23867fb2a35b28dull, 0xe99e619a4f23aa43ull,
+    0xdec681f9f4c31f31ull, 0x6405fa00e2ec94d4ull,
+    0x8b3c113c38f9f37eull, 0xde83bc408dd3dd04ull,
+    0xae0b158b4738705eull, 0x9624ab50b148d445ull,
+    0xd98ddaee19068c76ull, 0x3badd624dd9b0957ull,
+    0x87f8a8d4cfa417c9ull, 0xe54ca5d70a80e5d6ull,
+    0xa9f6d30a038d1dbcull, 0x5e9fcf4ccd211f4cull,
+    0xd47487cc8470652bull, 0x7647c3200069671full,
+    0x84c8d4dfd2c63f3bull, 0x29ecd9f40041e073ull,
+    0xa5fb0a17c777cf09ull, 0xf468107100525890ull,
+    0xcf79cc9db955c2ccull, 0x7182148d4066eeb4ull,
+    0x81ac1fe293d599bfull, 0xc6f14cd848405530ull,
+    0xa21727db38cb002full, 0xb8ada00e5a506a7cull,
+    0xca9cf1d206fdc03bull, 0xa6d90811f0e4851cull,
+    0xfd442e4688bd304aull, 0x908f4a166d1da663ull,
+    0x9e4a9cec15763e2eull, 0x9a598e4e043287feull,
+    0xc5dd44271ad3cdbaull, 0x40eff1e1853f29fdull,
+    0xf7549530e188c128ull, 0xd12bee59e68ef47cull,
+    0x9a94dd3e8cf578b9ull, 0x82bb74f8301958ceull,
+    0xc13a148e3032d6e7ull, 0xe36a52363c1faf01ull,
+    0xf18899b1bc3f8ca1ull, 0xdc44e6c3cb279ac1ull,
+    0x96f5600f15a7b7e5ull, 0x29ab103a5ef8c0b9ull,
+    0xbcb2b812db11a5deull, 0x7415d448f6b6f0e7ull,
+    0xebdf661791d60f56ull, 0x111b495b3464ad21ull,
+    0x936b9fcebb25c995ull, 0xcab10dd900beec34ull,
+    0xb84687c269ef3bfbull, 0x3d5d514f40eea742ull,
+    0xe65829b3046b0afaull, 0x0cb4a5a3112a5112ull,
+    0x8ff71a0fe2c2e6dcull, 0x47f0e785eaba72abull,
+    0xb3f4e093db73a093ull, 0x59ed216765690f56ull,
+    0xe0f218b8d25088b8ull, 0x306869c13ec3532cull,
+    0x8c974f7383725573ull, 0x1e414218c73a13fbull,
+    0xafbd2350644eeacfull, 0xe5d1929ef90898faull,
+    0xdbac6c247d62a583ull, 0xdf45f746b74abf39ull,
+    0x894bc396ce5da772ull, 0x6b8bba8c328eb783ull,
+    0xab9eb47c81f5114full, 0x066ea92f3f326564ull,
+    0xd686619ba27255a2ull, 0xc80a537b0efefebdull,
+    0x8613fd0145877585ull, 0xbd06742ce95f5f36ull,
+    0xa798fc4196e952e7ull, 0x2c48113823b73704ull,
+    0xd17f3b51fca3a7a0ull, 0xf75a15862ca504c5ull,
+    0x82ef85133de648c4ull, 0x9a984d73dbe722fbull,
+    0xa3ab66580d5fdaf5ull, 0xc13e60d0d2e0ebbaull,
+    0xcc963fee10b7d1b3ull, 0x318df905079926a8ull,
+    0xffbbcfe994e5c61full, 0xfdf17746497f7052ull,
+    0x9fd561f1fd0f9bd3ull, 0xfeb6ea8bedefa633ull,
+    0xc7caba6e7c5382c8ull, 0xfe64a52ee96b8fc0ull,
+    0xf9bd690a1b68637bull, 0x3dfdce7aa3c673b0ull,
+    0x9c1661a651213e2dull, 0x06bea10ca65c084eull,
+    0xc31bfa0fe5698db8ull, 0x486e494fcff30a62ull,
+    0xf3e2f893dec3f126ull, 0x5a89dba3c3efccfaull,
+    0x986ddb5c6b3a76b7ull, 0xf89629465a75e01cull,
+    0xbe89523386091465ull, 0xf6bbb397f1135823ull,
+    0xee2ba6c0678b597full, 0x746aa07ded582e2cull,
+    0x94db483840b717efull, 0xa8c2a44eb4571cdcull,
+    0xba121a4650e4ddebull, 0x92f34d62616ce413ull,
+    0xe896a0d7e51e1566ull, 0x77b020baf9c81d17ull,
+    0x915e2486ef32cd60ull, 0x0ace1474dc1d122eull,
+    0xb5b5ada8aaff80b8ull, 0x0d819992132456baull,
+    0xe3231912d5bf60e6ull, 0x10e1fff697ed6c69ull,
+    0x8df5efabc5979c8full, 0xca8d3ffa1ef463c1ull,
+    0xb1736b96b6fd83b3ull, 0xbd308ff8a6b17cb2ull,
+    0xddd0467c64bce4a0ull, 0xac7cb3f6d05ddbdeull,
+    0x8aa22c0dbef60ee4ull, 0x6bcdf07a423aa96bull,
+    0xad4ab7112eb3929dull, 0x86c16c98d2c953c6ull,
+    0xd89d64d57a607744ull, 0xe871c7bf077ba8b7ull,
+    0x87625f056c7c4a8bull, 0x11471cd764ad4972ull,
+    0xa93af6c6c79b5d2dull, 0xd598e40d3dd89bcfull,
+    0xd389b47879823479ull, 0x4aff1d108d4ec2c3ull,
+    0x843610cb4bf160cbull, 0xcedf722a585139baull,
+    0xa54394fe1eedb8feull, 0xc2974eb4ee658828ull,
+    0xce947a3da6a9273eull, 0x733d226229feea32ull,
+    0x811ccc668829b887ull, 0x0806357d5a3f525full,
+    0xa163ff802a3426a8ull, 0xca07c2dcb0cf26f7ull,
+    0xc9bcff6034c13052ull, 0xfc89b393dd02f0b5ull,
+    0xfc2c3f3841f17c67ull, 0xbbac2078d443ace2ull,
+    0x9d9ba7832936edc0ull, 0xd54b944b84aa4c0dull,
+    0xc5029163f384a931ull, 0x0a9e795e65d4df11ull,
+    0xf64335bcf065d37dull, 0x4d4617b5ff4a16d5ull,
+    0x99ea0196163fa42eull, 0x504bced1bf8e4e45ull,
+    0xc06481fb9bcf8d39ull, 0xe45ec2862f71e1d6ull,
+    0xf07da27a82c37088ull, 0x5d767327bb4e5a4cull,
+    0x964e858c91ba2655ull, 0x3a6a07f8d510f86full,
+    0xbbe226efb628afeaull, 0x890489f70a55368bull,
+    0xeadab0aba3b2dbe5ull, 0x2b45ac74ccea842eull,
+    0x92c8ae6b464fc96full, 0x3b0b8bc90012929dull,
+    0xb77ada0617e3bbcbull, 0x09ce6ebb40173744ull,
+    0xe55990879ddcaabdull, 0xcc420a6a101d0515ull,
+    0x8f57fa54c2a9eab6ull, 0x9fa946824a12232dull,
+    0xb32df8e9f3546564ull, 0x47939822dc96abf9ull,
+    0xdff9772470297ebdull, 0x59787e2b93bc56f7ull,
+    0x8bfbea76c619ef36ull, 0x57eb4edb3c55b65aull,
+    0xaefae51477a06b03ull, 0xede622920b6b23f1ull,
+    0xdab99e59958885c4ull, 0xe95fab368e45ecedull,
+    0x88b402f7fd75539bull, 0x11dbcb0218ebb414ull,
+    0xaae103b5fcd2a881ull, 0xd652bdc29f26a119ull,
+    0xd59944a37c0752a2ull, 0x4be76d3346f0495full,
+    0x857fcae62d8493a5ull, 0x6f70a4400c562ddbull,
+    0xa6dfbd9fb8e5b88eull, 0xcb4ccd500f6bb952ull,
+    0xd097ad07a71f26b2ull, 0x7e2000a41346a7a7ull,
+    0x825ecc24c873782full, 0x8ed400668c0c28c8ull,
+    0xa2f67f2dfa90563bull, 0x728900802f0f32faull,
+    0xcbb41ef979346bcaull, 0x4f2b40a03ad2ffb9ull,
+    0xfea126b7d78186bcull, 0xe2f610c84987bfa8ull,
+    0x9f24b832e6b0f436ull, 0x0dd9ca7d2df4d7c9ull,
+    0xc6ede63fa05d3143ull, 0x91503d1c79720dbbull,
+    0xf8a95fcf88747d94ull, 0x75a44c6397ce912aull,
+    0x9b69dbe1b548ce7cull, 0xc986afbe3ee11abaull,
+    0xc24452da229b021bull, 0xfbe85badce996168ull,
+    0xf2d56790ab41c2a2ull, 0xfae27299423fb9c3ull,
+    0x97c560ba6b0919a5ull, 0xdccd879fc967d41aull,
+    0xbdb6b8e905cb600full, 0x5400e987bbc1c920ull,
+    0xed246723473e3813ull, 0x290123e9aab23b68ull,
+    0x9436c0760c86e30bull, 0xf9a0b6720aaf6521ull,
+    0xb94470938fa89bceull, 0xf808e40e8d5b3e69ull,
+    0xe7958cb87392c2c2ull, 0xb60b1d1230b20e04ull,
+    0x90bd77f3483bb9b9ull, 0xb1c6f22b5e6f48c2ull,
+    0xb4ecd5f01a4aa828ull, 0x1e38aeb6360b1af3ull,
+    0xe2280b6c20dd5232ull, 0x25c6da63c38de1b0ull,
+    0x8d590723948a535full, 0x579c487e5a38ad0eull,
+    0xb0af48ec79ace837ull, 0x2d835a9df0c6d851ull,
+    0xdcdb1b2798182244ull, 0xf8e431456cf88e65ull,
+    0x8a08f0f8bf0f156bull, 0x1b8e9ecb641b58ffull,
+    0xac8b2d36eed2dac5ull, 0xe272467e3d222f3full,
+    0xd7adf884aa879177ull, 0x5b0ed81dcc6abb0full,
+    0x86ccbb52ea94baeaull, 0x98e947129fc2b4e9ull,
+    0xa87fea27a539e9a5ull, 0x3f2398d747b36224ull,
+    0xd29fe4b18e88640eull, 0x8eec7f0d19a03aadull,
+    0x83a3eeeef9153e89ull, 0x1953cf68300424acull,
+    0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd7ull,
+    0xcdb02555653131b6ull, 0x3792f412cb06794dull,
+    0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd0ull,
+    0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec4ull,
+    0xc8de047564d20a8bull, 0xf245825a5a445275ull,
+    0xfb158592be068d2eull, 0xeed6e2f0f0d56712ull,
+    0x9ced737bb6c4183dull, 0x55464dd69685606bull,
+    0xc428d05aa4751e4cull, 0xaa97e14c3c26b886ull,
+    0xf53304714d9265dfull, 0xd53dd99f4b3066a8ull,
+    0x993fe2c6d07b7fabull, 0xe546a8038efe4029ull,
+    0xbf8fdb78849a5f96ull, 0xde98520472bdd033ull,
+    0xef73d256a5c0f77cull, 0x963e66858f6d4440ull,
+    0x95a8637627989aadull, 0xdde7001379a44aa8ull,
+    0xbb127c53b17ec159ull, 0x5560c018580d5d52ull,
+    0xe9d71b689dde71afull, 0xaab8f01e6e10b4a6ull,
+    0x9226712162ab070dull, 0xcab3961304ca70e8ull,
+    0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d22ull,
+    0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506aull,
+    0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb242ull,
+    0xb267ed1940f1c61cull, 0x55f038b237591ed3ull,
+    0xdf01e85f912e37a3ull, 0x6b6c46dec52f6688ull,
+    0x8b61313bbabce2c6ull, 0x2323ac4b3b3da015ull,
+    0xae397d8aa96c1b77ull, 0xabec975e0a0d081aull,
+    0xd9c7dced53c72255ull, 0x96e7bd358c904a21ull,
+    0x881cea14545c7575ull, 0x7e50d64177da2e54ull,
+    0xaa242499697392d2ull, 0xdde50bd1d5d0b9e9ull,
+    0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e864ull,
+    0x84ec3c97da624ab4ull, 0xbd5af13bef0b113eull,
+    0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58eull,
+    0xcfb11ead453994baull, 0x67de18eda5814af2ull,
+    0x81ceb32c4b43fcf4ull, 0x80eacf948770ced7ull,
+    0xa2425ff75e14fc31ull, 0xa1258379a94d028dull,
+    0xcad2f7f5359a3b3eull, 0x096ee45813a04330ull,
+    0xfd87b5f28300ca0dull, 0x8bca9d6e188853fcull,
+    0x9e74d1b791e07e48ull, 0x775ea264cf55347eull,
+    0xc612062576589ddaull, 0x95364afe032a819eull,
+    0xf79687aed3eec551ull, 0x3a83ddbd83f52205ull,
+    0x9abe14cd44753b52ull, 0xc4926a9672793543ull,
+    0xc16d9a0095928a27ull, 0x75b7053c0f178294ull,
+    0xf1c90080baf72cb1ull, 0x5324c68b12dd6339ull,
+    0x971da05074da7beeull, 0xd3f6fc16ebca5e04ull,
+    0xbce5086492111aeaull, 0x88f4bb1ca6bcf585ull,
+    0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e6ull,
+    0x9392ee8e921d5d07ull, 0x3aff322e62439fd0ull,
+    0xb877aa3236a4b449ull, 0x09befeb9fad487c3ull,
+    0xe69594bec44de15bull, 0x4c2ebe687989a9b4ull,
+    0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a11ull,
+    0xb424dc35095cd80full, 0x538484c19ef38c95ull,
+    0xe12e13424bb40e13ull, 0x2865a5f206b06fbaull,
+    0x8cbccc096f5088cbull, 0xf93f87b7442e45d4ull,
+    0xafebff0bcb24aafeull, 0xf78f69a51539d749ull,
+    0xdbe6fecebdedd5beull, 0xb573440e5a884d1cull,
+    0x89705f4136b4a597ull, 0x31680a88f8953031ull,
+    0xabcc77118461cefcull, 0xfdc20d2b36ba7c3eull,
+    0xd6bf94d5e57a42bcull, 0x3d32907604691b4dull,
+    0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b110ull,
+    0xa7c5ac471b478423ull, 0x0fcf80dc33721d54ull,
+    0xd1b71758e219652bull, 0xd3c36113404ea4a9ull,
+    0x83126e978d4fdf3bull, 0x645a1cac083126eaull,
+    0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a4ull,
+    0xccccccccccccccccull, 0xcccccccccccccccdull,
+    0x8000000000000000ull, 0x0000000000000000ull,
+    0xa000000000000000ull, 0x0000000000000000ull,
+    0xc800000000000000ull, 0x0000000000000000ull,
+    0xfa00000000000000ull, 0x0000000000000000ull,
+    0x9c40000000000000ull, 0x0000000000000000ull,
+    0xc350000000000000ull, 0x0000000000000000ull,
+    0xf424000000000000ull, 0x0000000000000000ull,
+    0x9896800000000000ull, 0x0000000000000000ull,
+    0xbebc200000000000ull, 0x0000000000000000ull,
+    0xee6b280000000000ull, 0x0000000000000000ull,
+    0x9502f90000000000ull, 0x0000000000000000ull,
+    0xba43b74000000000ull, 0x0000000000000000ull,
+    0xe8d4a51000000000ull, 0x0000000000000000ull,
+    0x9184e72a00000000ull, 0x0000000000000000ull,
+    0xb5e620f480000000ull, 0x0000000000000000ull,
+    0xe35fa931a0000000ull, 0x0000000000000000ull,
+    0x8e1bc9bf04000000ull, 0x0000000000000000ull,
+    0xb1a2bc2ec5000000ull, 0x0000000000000000ull,
+    0xde0b6b3a76400000ull, 0x0000000000000000ull,
+    0x8ac7230489e80000ull, 0x0000000000000000ull,
+    0xad78ebc5ac620000ull, 0x0000000000000000ull,
+    0xd8d726b7177a8000ull, 0x0000000000000000ull,
+    0x878678326eac9000ull, 0x0000000000000000ull,
+    0xa968163f0a57b400ull, 0x0000000000000000ull,
+    0xd3c21bcecceda100ull, 0x0000000000000000ull,
+    0x84595161401484a0ull, 0x0000000000000000ull,
+    0xa56fa5b99019a5c8ull, 0x0000000000000000ull,
+    0xcecb8f27f4200f3aull, 0x0000000000000000ull,
+    0x813f3978f8940984ull, 0x4000000000000000ull,
+    0xa18f07d736b90be5ull, 0x5000000000000000ull,
+    0xc9f2c9cd04674edeull, 0xa400000000000000ull,
+    0xfc6f7c4045812296ull, 0x4d00000000000000ull,
+    0x9dc5ada82b70b59dull, 0xf020000000000000ull,
+    0xc5371912364ce305ull, 0x6c28000000000000ull,
+    0xf684df56c3e01bc6ull, 0xc732000000000000ull,
+    0x9a130b963a6c115cull, 0x3c7f400000000000ull,
+    0xc097ce7bc90715b3ull, 0x4b9f100000000000ull,
+    0xf0bdc21abb48db20ull, 0x1e86d40000000000ull,
+    0x96769950b50d88f4ull, 0x1314448000000000ull,
+    0xbc143fa4e250eb31ull, 0x17d955a000000000ull,
+    0xeb194f8e1ae525fdull, 0x5dcfab0800000000ull,
+    0x92efd1b8d0cf37beull, 0x5aa1cae500000000ull,
+    0xb7abc627050305adull, 0xf14a3d9e40000000ull,
+    0xe596b7b0c643c719ull, 0x6d9ccd05d0000000ull,
+    0x8f7e32ce7bea5c6full, 0xe4820023a2000000ull,
+    0xb35dbf821ae4f38bull, 0xdda2802c8a800000ull,
+    0xe0352f62a19e306eull, 0xd50b2037ad200000ull,
+    0x8c213d9da502de45ull, 0x4526f422cc340000ull,
+    0xaf298d050e4395d6ull, 0x9670b12b7f410000ull,
+    0xdaf3f04651d47b4cull, 0x3c0cdd765f114000ull,
+    0x88d8762bf324cd0full, 0xa5880a69fb6ac800ull,
+    0xab0e93b6efee0053ull, 0x8eea0d047a457a00ull,
+    0xd5d238a4abe98068ull, 0x72a4904598d6d880ull,
+    0x85a36366eb71f041ull, 0x47a6da2b7f864750ull,
+    0xa70c3c40a64e6c51ull, 0x999090b65f67d924ull,
+    0xd0cf4b50cfe20765ull, 0xfff4b4e3f741cf6dull,
+    0x82818f1281ed449full, 0xbff8f10e7a8921a4ull,
+    0xa321f2d7226895c7ull, 0xaff72d52192b6a0dull,
+    0xcbea6f8ceb02bb39ull, 0x9bf4f8a69f764490ull,
+    0xfee50b7025c36a08ull, 0x02f236d04753d5b4ull,
+    0x9f4f2726179a2245ull, 0x01d762422c946590ull,
+    0xc722f0ef9d80aad6ull, 0x424d3ad2b7b97ef5ull,
+    0xf8ebad2b84e0d58bull, 0xd2e0898765a7deb2ull,
+    0x9b934c3b330c8577ull, 0x63cc55f49f88eb2full,
+    0xc2781f49ffcfa6d5ull, 0x3cbf6b71c76b25fbull,
+    0xf316271c7fc3908aull, 0x8bef464e3945ef7aull,
+    0x97edd871cfda3a56ull, 0x97758bf0e3cbb5acull,
+    0xbde94e8e43d0c8ecull, 0x3d52eeed1cbea317ull,
+    0xed63a231d4c4fb27ull, 0x4ca7aaa863ee4bddull,
+    0x945e455f24fb1cf8ull, 0x8fe8caa93e74ef6aull,
+    0xb975d6b6ee39e436ull, 0xb3e2fd538e122b44ull,
+    0xe7d34c64a9c85d44ull, 0x60dbbca87196b616ull,
+    0x90e40fbeea1d3a4aull, 0xbc8955e946fe31cdull,
+    0xb51d13aea4a488ddull, 0x6babab6398bdbe41ull,
+    0xe264589a4dcdab14ull, 0xc696963c7eed2dd1ull,
+    0x8d7eb76070a08aecull, 0xfc1e1de5cf543ca2ull,
+    0xb0de65388cc8ada8ull, 0x3b25a55f43294bcbull,
+    0xdd15fe86affad912ull, 0x49ef0eb713f39ebeull,
+    0x8a2dbf142dfcc7abull, 0x6e3569326c784337ull,
+    0xacb92ed9397bf996ull, 0x49c2c37f07965404ull,
+    0xd7e77a8f87daf7fbull, 0xdc33745ec97be906ull,
+    0x86f0ac99b4e8dafdull, 0x69a028bb3ded71a3ull,
+    0xa8acd7c0222311bcull, 0xc40832ea0d68ce0cull,
+    0xd2d80db02aabd62bull, 0xf50a3fa490c30190ull,
+    0x83c7088e1aab65dbull, 0x792667c6da79e0faull,
+    0xa4b8cab1a1563f52ull, 0x577001b891185938ull,
+    0xcde6fd5e09abcf26ull, 0xed4c0226b55e6f86ull,
+    0x80b05e5ac60b6178ull, 0x544f8158315b05b4ull,
+    0xa0dc75f1778e39d6ull, 0x696361ae3db1c721ull,
+    0xc913936dd571c84cull, 0x03bc3a19cd1e38e9ull,
+    0xfb5878494ace3a5full, 0x04ab48a04065c723ull,
+    0x9d174b2dcec0e47bull, 0x62eb0d64283f9c76ull,
+    0xc45d1df942711d9aull, 0x3ba5d0bd324f8394ull,
+    0xf5746577930d6500ull, 0xca8f44ec7ee36479ull,
+    0x9968bf6abbe85f20ull, 0x7e998b13cf4e1ecbull,
+    0xbfc2ef456ae276e8ull, 0x9e3fedd8c321a67eull,
+    0xefb3ab16c59b14a2ull, 0xc5cfe94ef3ea101eull,
+    0x95d04aee3b80ece5ull, 0xbba1f1d158724a12ull,
+    0xbb445da9ca61281full, 0x2a8a6e45ae8edc97ull,
+    0xea1575143cf97226ull, 0xf52d09d71a3293bdull,
+    0x924d692ca61be758ull, 0x593c2626705f9c56ull,
+    0xb6e0c377cfa2e12eull, 0x6f8b2fb00c77836cull,
+    0xe498f455c38b997aull, 0x0b6dfb9c0f956447ull,
+    0x8edf98b59a373fecull, 0x4724bd4189bd5eacull,
+    0xb2977ee300c50fe7ull, 0x58edec91ec2cb657ull,
+    0xdf3d5e9bc0f653e1ull, 0x2f2967b66737e3edull,
+    0x8b865b215899f46cull, 0xbd79e0d20082ee74ull,
+    0xae67f1e9aec07187ull, 0xecd8590680a3aa11ull,
+    0xda01ee641a708de9ull, 0xe80e6f4820cc9495ull,
+    0x884134fe908658b2ull, 0x3109058d147fdcddull,
+    0xaa51823e34a7eedeull, 0xbd4b46f0599fd415ull,
+    0xd4e5e2cdc1d1ea96ull, 0x6c9e18ac7007c91aull,
+    0x850fadc09923329eull, 0x03e2cf6bc604ddb0ull,
+    0xa6539930bf6bff45ull, 0x84db8346b786151cull,
+    0xcfe87f7cef46ff16ull, 0xe612641865679a63ull,
+    0x81f14fae158c5f6eull, 0x4fcb7e8f3f60c07eull,
+    0xa26da3999aef7749ull, 0xe3be5e330f38f09dull,
+    0xcb090c8001ab551cull, 0x5cadf5bfd3072cc5ull,
+    0xfdcb4fa002162a63ull, 0x73d9732fc7c8f7f6ull,
+    0x9e9f11c4014dda7eull, 0x2867e7fddcdd9afaull,
+    0xc646d63501a1511dull, 0xb281e1fd541501b8ull,
+    0xf7d88bc24209a565ull, 0x1f225a7ca91a4226ull,
+    0x9ae757596946075full, 0x3375788de9b06958ull,
+    0xc1a12d2fc3978937ull, 0x0052d6b1641c83aeull,
+    0xf209787bb47d6b84ull, 0xc0678c5dbd23a49aull,
+    0x9745eb4d50ce6332ull, 0xf840b7ba963646e0ull,
+    0xbd176620a501fbffull, 0xb650e5a93bc3d898ull,
+    0xec5d3fa8ce427affull, 0xa3e51f138ab4cebeull,
+    0x93ba47c980e98cdfull, 0xc66f336c36b10137ull,
+    0xb8a8d9bbe123f017ull, 0xb80b0047445d4184ull,
+    0xe6d3102ad96cec1dull, 0xa60dc059157491e5ull,
+    0x9043ea1ac7e41392ull, 0x87c89837ad68db2full,
+    0xb454e4a179dd1877ull, 0x29babe4598c311fbull,
+    0xe16a1dc9d8545e94ull, 0xf4296dd6fef3d67aull,
+    0x8ce2529e2734bb1dull, 0x1899e4a65f58660cull,
+    0xb01ae745b101e9e4ull, 0x5ec05dcff72e7f8full,
+    0xdc21a1171d42645dull, 0x76707543f4fa1f73ull,
+    0x899504ae72497ebaull, 0x6a06494a791c53a8ull,
+    0xabfa45da0edbde69ull, 0x0487db9d17636892ull,
+    0xd6f8d7509292d603ull, 0x45a9d2845d3c42b6ull,
+    0x865b86925b9bc5c2ull, 0x0b8a2392ba45a9b2ull,
+    0xa7f26836f282b732ull, 0x8e6cac7768d7141eull,
+    0xd1ef0244af2364ffull, 0x3207d795430cd926ull,
+    0x8335616aed761f1full, 0x7f44e6bd49e807b8ull,
+    0xa402b9c5a8d3a6e7ull, 0x5f16206c9c6209a6ull,
+    0xcd036837130890a1ull, 0x36dba887c37a8c0full,
+    0x802221226be55a64ull, 0xc2494954da2c9789ull,
+    0xa02aa96b06deb0fdull, 0xf2db9baa10b7bd6cull,
+    0xc83553c5c8965d3dull, 0x6f92829494e5acc7ull,
+    0xfa42a8b73abbf48cull, 0xcb772339ba1f17f9ull,
+    0x9c69a97284b578d7ull, 0xff2a760414536efbull,
+    0xc38413cf25e2d70dull, 0xfef5138519684abaull,
+    0xf46518c2ef5b8cd1ull, 0x7eb258665fc25d69ull,
+    0x98bf2f79d5993802ull, 0xef2f773ffbd97a61ull,
+    0xbeeefb584aff8603ull, 0xaafb550ffacfd8faull,
+    0xeeaaba2e5dbf6784ull, 0x95ba2a53f983cf38ull,
+    0x952ab45cfa97a0b2ull, 0xdd945a747bf26183ull,
+    0xba756174393d88dfull, 0x94f971119aeef9e4ull,
+    0xe912b9d1478ceb17ull, 0x7a37cd5601aab85dull,
+    0x91abb422ccb812eeull, 0xac62e055c10ab33aull,
+    0xb616a12b7fe617aaull, 0x577b986b314d6009ull,
+    0xe39c49765fdf9d94ull, 0xed5a7e85fda0b80bull,
+    0x8e41ade9fbebc27dull, 0x14588f13be847307ull,
+    0xb1d219647ae6b31cull, 0x596eb2d8ae258fc8ull,
+    0xde469fbd99a05fe3ull, 0x6fca5f8ed9aef3bbull,
+    0x8aec23d680043beeull, 0x25de7bb9480d5854ull,
+    0xada72ccc20054ae9ull, 0xaf561aa79a10ae6aull,
+    0xd910f7ff28069da4ull, 0x1b2ba1518094da04ull,
+    0x87aa9aff79042286ull, 0x90fb44d2f05d0842ull,
+    0xa99541bf57452b28ull, 0x353a1607ac744a53ull,
+    0xd3fa922f2d1675f2ull, 0x42889b8997915ce8ull,
+    0x847c9b5d7c2e09b7ull, 0x69956135febada11ull,
+    0xa59bc234db398c25ull, 0x43fab9837e699095ull,
+    0xcf02b2c21207ef2eull, 0x94f967e45e03f4bbull,
+    0x8161afb94b44f57dull, 0x1d1be0eebac278f5ull,
+    0xa1ba1ba79e1632dcull, 0x6462d92a69731732ull,
+    0xca28a291859bbf93ull, 0x7d7b8f7503cfdcfeull,
+    0xfcb2cb35e702af78ull, 0x5cda735244c3d43eull,
+    0x9defbf01b061adabull, 0x3a0888136afa64a7ull,
+    0xc56baec21c7a1916ull, 0x088aaa1845b8fdd0ull,
+    0xf6c69a72a3989f5bull, 0x8aad549e57273d45ull,
+    0x9a3c2087a63f6399ull, 0x36ac54e2f678864bull,
+    0xc0cb28a98fcf3c7full, 0x84576a1bb416a7ddull,
+    0xf0fdf2d3f3c30b9full, 0x656d44a2a11c51d5ull,
+    0x969eb7c47859e743ull, 0x9f644ae5a4b1b325ull,
+    0xbc4665b596706114ull, 0x873d5d9f0dde1feeull,
+    0xeb57ff22fc0c7959ull, 0xa90cb506d155a7eaull,
+    0x9316ff75dd87cbd8ull, 0x09a7f12442d588f2ull,
+    0xb7dcbf5354e9beceull, 0x0c11ed6d538aeb2full,
+    0xe5d3ef282a242e81ull, 0x8f1668c8a86da5faull,
+    0x8fa475791a569d10ull, 0xf96e017d694487bcull,
+    0xb38d92d760ec4455ull, 0x37c981dcc395a9acull,
+    0xe070f78d3927556aull, 0x85bbe253f47b1417ull,
+    0x8c469ab843b89562ull, 0x93956d7478ccec8eull,
+    0xaf58416654a6babbull, 0x387ac8d1970027b2ull,
+    0xdb2e51bfe9d0696aull, 0x06997b05fcc0319eull,
+    0x88fcf317f22241e2ull, 0x441fece3bdf81f03ull,
+    0xab3c2fddeeaad25aull, 0xd527e81cad7626c3ull,
+    0xd60b3bd56a5586f1ull, 0x8a71e223d8d3b074ull,
+    0x85c7056562757456ull, 0xf6872d5667844e49ull,
+    0xa738c6bebb12d16cull, 0xb428f8ac016561dbull,
+    0xd106f86e69d785c7ull, 0xe13336d701beba52ull,
+    0x82a45b450226b39cull, 0xecc0024661173473ull,
+    0xa34d721642b06084ull, 0x27f002d7f95d0190ull,
+    0xcc20ce9bd35c78a5ull, 0x31ec038df7b441f4ull,
+    0xff290242c83396ceull, 0x7e67047175a15271ull,
+    0x9f79a169bd203e41ull, 0x0f0062c6e984d386ull,
+    0xc75809c42c684dd1ull, 0x52c07b78a3e60868ull,
+    0xf92e0c3537826145ull, 0xa7709a56ccdf8a82ull,
+    0x9bbcc7a142b17ccbull, 0x88a66076400bb691ull,
+    0xc2abf989935ddbfeull, 0x6acff893d00ea435ull,
+    0xf356f7ebf83552feull, 0x0583f6b8c4124d43ull,
+    0x98165af37b2153deull, 0xc3727a337a8b704aull,
+    0xbe1bf1b059e9a8d6ull, 0x744f18c0592e4c5cull,
+    0xeda2ee1c7064130cull, 0x1162def06f79df73ull,
+    0x9485d4d1c63e8be7ull, 0x8addcb5645ac2ba8ull,
+    0xb9a74a0637ce2ee1ull, 0x6d953e2bd7173692ull,
+    0xe8111c87c5c1ba99ull, 0xc8fa8db6ccdd0437ull,
+    0x910ab1d4db9914a0ull, 0x1d9c9892400a22a2ull,
+    0xb54d5e4a127f59c8ull, 0x2503beb6d00cab4bull,
+    0xe2a0b5dc971f303aull, 0x2e44ae64840fd61dull,
+    0x8da471a9de737e24ull, 0x5ceaecfed289e5d2ull,
+    0xb10d8e1456105dadull, 0x7425a83e872c5f47ull,
+    0xdd50f1996b947518ull, 0xd12f124e28f77719ull,
+    0x8a5296ffe33cc92full, 0x82bd6b70d99aaa6full,
+    0xace73cbfdc0bfb7bull, 0x636cc64d1001550bull,
+    0xd8210befd30efa5aull, 0x3c47f7e05401aa4eull,
+    0x8714a775e3e95c78ull, 0x65acfaec34810a71ull,
+    0xa8d9d1535ce3b396ull, 0x7f1839a741a14d0dull,
+    0xd31045a8341ca07cull, 0x1ede48111209a050ull,
+    0x83ea2b892091e44dull, 0x934aed0aab460432ull,
+    0xa4e4b66b68b65d60ull, 0xf81da84d5617853full,
+    0xce1de40642e3f4b9ull, 0x36251260ab9d668eull,
+    0x80d2ae83e9ce78f3ull, 0xc1d72b7c6b426019ull,
+    0xa1075a24e4421730ull, 0xb24cf65b8612f81full,
+    0xc94930ae1d529cfcull, 0xdee033f26797b627ull,
+    0xfb9b7cd9a4a7443cull, 0x169840ef017da3b1ull,
+    0x9d412e0806e88aa5ull, 0x8e1f289560ee864eull,
+    0xc491798a08a2ad4eull, 0xf1a6f2bab92a27e2ull,
+    0xf5b5d7ec8acb58a2ull, 0xae10af696774b1dbull,
+    0x9991a6f3d6bf1765ull, 0xacca6da1e0a8ef29ull,
+    0xbff610b0cc6edd3full, 0x17fd090a58d32af3ull,
+    0xeff394dcff8a948eull, 0xddfc4b4cef07f5b0ull,
+    0x95f83d0a1fb69cd9ull, 0x4abdaf101564f98eull,
+    0xbb764c4ca7a4440full, 0x9d6d1ad41abe37f1ull,
+    0xea53df5fd18d5513ull, 0x84c86189216dc5edull,
+    0x92746b9be2f8552cull, 0x32fd3cf5b4e49bb4ull,
+    0xb7118682dbb66a77ull, 0x3fbc8c33221dc2a1ull,
+    0xe4d5e82392a40515ull, 0x0fabaf3feaa5334aull,
+    0x8f05b1163ba6832dull, 0x29cb4d87f2a7400eull,
+    0xb2c71d5bca9023f8ull, 0x743e20e9ef511012ull,
+    0xdf78e4b2bd342cf6ull, 0x914da9246b255416ull,
+    0x8bab8eefb6409c1aull, 0x1ad089b6c2f7548eull,
+    0xae9672aba3d0c320ull, 0xa184ac2473b529b1ull,
+    0xda3c0f568cc4f3e8ull, 0xc9e5d72d90a2741eull,
+    0x8865899617fb1871ull, 0x7e2fa67c7a658892ull,
+    0xaa7eebfb9df9de8dull, 0xddbb901b98feeab7ull,
+    0xd51ea6fa85785631ull, 0x552a74227f3ea565ull,
+    0x8533285c936b35deull, 0xd53a88958f87275full,
+    0xa67ff273b8460356ull, 0x8a892abaf368f137ull,
+    0xd01fef10a657842cull, 0x2d2b7569b0432d85ull,
+    0x8213f56a67f6b29bull, 0x9c3b29620e29fc73ull,
+    0xa298f2c501f45f42ull, 0x8349f3ba91b47b8full,
+    0xcb3f2f7642717713ull, 0x241c70a936219a73ull,
+    0xfe0efb53d30dd4d7ull, 0xed238cd383aa0110ull,
+    0x9ec95d1463e8a506ull, 0xf4363804324a40aaull,
+    0xc67bb4597ce2ce48ull, 0xb143c6053edcd0d5ull,
+    0xf81aa16fdc1b81daull, 0xdd94b7868e94050aull,
+    0x9b10a4e5e9913128ull, 0xca7cf2b4191c8326ull,
+    0xc1d4ce1f63f57d72ull, 0xfd1c2f611f63a3f0ull,
+    0xf24a01a73cf2dccfull, 0xbc633b39673c8cecull,
+    0x976e41088617ca01ull, 0xd5be0503e085d813ull,
+    0xbd49d14aa79dbc82ull, 0x4b2d8644d8a74e18ull,
+    0xec9c459d51852ba2ull, 0xddf8e7d60ed1219eull,
+    0x93e1ab8252f33b45ull, 0xcabb90e5c942b503ull,
+    0xb8da1662e7b00a17ull, 0x3d6a751f3b936243ull,
+    0xe7109bfba19c0c9dull, 0x0cc512670a783ad4ull,
+    0x906a617d450187e2ull, 0x27fb2b80668b24c5ull,
+    0xb484f9dc9641e9daull, 0xb1f9f660802dedf6ull,
+    0xe1a63853bbd26451ull, 0x5e7873f8a0396973ull,
+    0x8d07e33455637eb2ull, 0xdb0b487b6423e1e8ull,
+    0xb049dc016abc5e5full, 0x91ce1a9a3d2cda62ull,
+    0xdc5c5301c56b75f7ull, 0x7641a140cc7810fbull,
+    0x89b9b3e11b6329baull, 0xa9e904c87fcb0a9dull,
+    0xac2820d9623bf429ull, 0x546345fa9fbdcd44ull,
+    0xd732290fbacaf133ull, 0xa97c177947ad4095ull,
+    0x867f59a9d4bed6c0ull, 0x49ed8eabcccc485dull,
+    0xa81f301449ee8c70ull, 0x5c68f256bfff5a74ull,
+    0xd226fc195c6a2f8cull, 0x73832eec6fff3111ull,
+    0x83585d8fd9c25db7ull, 0xc831fd53c5ff7eabull,
+    0xa42e74f3d032f525ull, 0xba3e7ca8b77f5e55ull,
+    0xcd3a1230c43fb26full, 0x28ce1bd2e55f35ebull,
+    0x80444b5e7aa7cf85ull, 0x7980d163cf5b81b3ull,
+    0xa0555e361951c366ull, 0xd7e105bcc332621full,
+    0xc86ab5c39fa63440ull, 0x8dd9472bf3fefaa7ull,
+    0xfa856334878fc150ull, 0xb14f98f6f0feb951ull,
+    0x9c935e00d4b9d8d2ull, 0x6ed1bf9a569f33d3ull,
+    0xc3b8358109e84f07ull, 0x0a862f80ec4700c8ull,
+    0xf4a642e14c6262c8ull, 0xcd27bb612758c0faull,
+    0x98e7e9cccfbd7dbdull, 0x8038d51cb897789cull,
+    0xbf21e44003acdd2cull, 0xe0470a63e6bd56c3ull,
+    0xeeea5d5004981478ull, 0x1858ccfce06cac74ull,
+    0x95527a5202df0ccbull, 0x0f37801e0c43ebc8ull,
+    0xbaa718e68396cffdull, 0xd30560258f54e6baull,
+    0xe950df20247c83fdull, 0x47c6b82ef32a2069ull,
+    0x91d28b7416cdd27eull, 0x4cdc331d57fa5441ull,
+    0xb6472e511c81471dull, 0xe0133fe4adf8e952ull,
+    0xe3d8f9e563a198e5ull, 0x58180fddd97723a6ull,
+    0x8e679c2f5e44ff8full, 0x570f09eaa7ea7648ull,
+};
+
+typedef struct {
+    uint64_t mantissa;     // At most 19 significant digits
+    int64_t  exponent;     // Power of 10 applied to `mantissa`
+    bool     negative;
+    bool     truncated;    // More digits than `mantissa` can hold
+    const char *integer;   // Digits before the dot
+    size_t   integer_length;
+    const char *fraction;  // Digits after the dot
+    size_t   fraction_length;
+    int64_t  explicit_exponent;
+} fsv_decimal_t;
+
+typedef struct {
+    uint64_t mantissa;
+    int32_t  power2;       // Biased exponent, -1 when the result can't be decided
+} fsv_float_bits_t;
+
+// Parameters of the IEEE 754 binary formats
+typedef struct {
+    int mantissa_bits;
+    int minimum_exponent;
+    int infinite_power;
+    int min_exponent_round_to_even;
+    int max_exponent_round_to_even;
+    int smallest_power_of_ten;
+    int largest_power_of_ten;
+} fsv_float_format_t;
+
+static const fsv_float_format_t fsv_binary64 = { 52, -1023, 0x7FF, -4,  23, -342, 308 };
+static const fsv_float_format_t fsv_binary32 = { 23, -127,  0xFF,  -17, 10, -64,  38  };
+
+static inline size_t fsv_clz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_clzll(x);
+#else
+    size_t n = 0;
+    while ((x & 0x8000000000000000ull) == 0) { x <<= 1; n++; }
+    return n;
+#endif
+}
+
+static inline size_t fsv_parse_digit_run(const char *datas, size_t length) {
+    size_t i = 0;
+    while (i + 8 <= length && fsv_swar_is_8_digits(fsv_swar_load(datas + i))) i += 8;
+    while (i < length && fsv_is_digit(datas[i])) i += 1;
+    return i;
+}
+
+// Return how many bytes make up the number, 0 if there is none
+static size_t fsv_parse_decimal(const char *datas, size_t length, fsv_decimal_t *d) {
+    size_t i = 0;
+    d->negative = datas[0] == '-';
+    if (datas[0] == '-' || datas[0] == '+') i += 1;
+
+    d->integer = datas + i;
+    d->integer_length = fsv_parse_digit_run(datas + i, length - i);
+    i += d->integer_length;
+    d->fraction = datas + i;
+    d->fraction_length = 0;
+    if (i < length && datas[i] == '.') {
+        i += 1;
+        d->fraction = datas + i;
+        d->fraction_length = fsv_parse_digit_run(datas + i, length - i);
+        i += d->fraction_length;
+    }
+    if (d->integer_length + d->fraction_length == 0) return 0;
+
+    // The exponent is only part of the number if it has digits
+    d->explicit_exponent = 0;
+    if (i < length && (datas[i] | 0x20) == 'e') {
+        size_t j = i + 1;
+        bool negative = j < length && datas[j] == '-';
+        if (j < length && (datas[j] == '-' || datas[j] == '+')) j += 1;
+        if (j < length && fsv_is_digit(datas[j])) {
+            for (; j < length && fsv_is_digit(datas[j]); ++j) {
+                // Way past what a double can represent, keep it from overflowing
+                if (d->explicit_exponent < 0x10000000) d->explicit_exponent = d->explicit_exponent*10 + (datas[j] - '0');
+            }
+            if (negative) d->explicit_exponent = -d->explicit_exponent;
+            i = j;
+        }
+    }
+
+    // Leading zeros do not count, `mantissa` stops growing after 19 digits
+    const uint64_t limit = 1000000000000000000ull;
+    uint64_t mantissa = 0;
+    size_t k = 0;
+    for (; k + 8 <= d->integer_length && mantissa < 10000000000ull; k += 8) {
+        mantissa = mantissa*100000000 + fsv_swar_parse_8_digits(fsv_swar_load(d->integer + k));
+    }
+    for (; k < d->integer_length && mantissa < limit; ++k) mantissa = mantissa*10 + (uint64_t)(d->integer[k] - '0');
+    d->exponent = (int64_t)(d->integer_length - k);
+    d->truncated = k < d->integer_length;
+    if (!d->truncated) {
+        for (k = 0; k + 8 <= d->fraction_length && mantissa < 10000000000ull; k += 8) {
+            mantissa = mantissa*100000000 + fsv_swar_parse_8_digits(fsv_swar_load(d->fraction + k));
+        }
+        for (; k < d->fraction_length && mantissa < limit; ++k) mantissa = mantissa*10 + (uint64_t)(d->fraction[k] - '0');
+        d->exponent = -(int64_t)k;
+        d->truncated = k < d->fraction_length;
+    }
+    // Only trailing zeros left behind is not a truncation
+    if (d->truncated) {
+        bool zeros = true;
+        const char *rest = d->exponent >= 0 ? d->integer + (d->integer_length - (size_t)d->exponent) : d->fraction + k;
+        const char *end  = d->fraction + d->fraction_length;
+        for (const char *c = rest; c < end && zeros; ++c) zeros = *c == '0' || *c == '.';
+        d->truncated = !zeros;
+    }
+    d->exponent += d->explicit_exponent;
+    d->mantissa = mantissa;
+    return i;
+}
+
+// Most significant 128 bits of `w * 5^q`, only as precise as `bits` requires
+static inline void fsv_pow5_product(int64_t q, uint64_t w, int bits, uint64_t *high, uint64_t *low) {
+    const size_t index = 2*(size_t)(q - FSV_POW5_MIN_EXPONENT);
+    const uint64_t precision_mask = 0xFFFFFFFFFFFFFFFFull >> bits;
+    uint64_t lo = w, hi = fsv_pow5_128[index];
+    fsv_hash_mum(&lo, &hi);
+    if ((hi & precision_mask) == precision_mask) {
+        uint64_t lo2 = w, hi2 = fsv_pow5_128[index + 1];
+        fsv_hash_mum(&lo2, &hi2);
+        lo += hi2;
+        if (hi2 > lo) hi += 1;
+    }
+    *high = hi;
+    *low  = lo;
+}
+
+static fsv_float_bits_t fsv_eisel_lemire(int64_t q, uint64_t w, const fsv_float_format_t *f) {
+    fsv_float_bits_t answer = { 0, 0 };
+    if (w == 0 || q < f->smallest_power_of_ten) return answer;
+    if (q > f->largest_power_of_ten) {
+        answer.power2 = f->infinite_power;
+        return answer;
+    }
+
+    size_t lz = fsv_clz64(w);
+    w <<= lz;
+    uint64_t high = 0, low = 0;
+    fsv_pow5_product(q, w, f->mantissa_bits + 3, &high, &low);
+    // The truncated product may be off by one, too close to call outside of where it is exact
+    if (low == 0xFFFFFFFFFFFFFFFFull && (q < -27 || q > 55)) {
+        answer.power2 = -1;
+        return answer;
+    }
+
+    int upperbit = (int)(high >> 63);
+    int shift = upperbit + 64 - f->mantissa_bits - 3;
+    answer.mantissa = high >> shift;
+    answer.power2 = (int32_t)((((152170 + 65536)*q) >> 16) + 63 + upperbit - (int64_t)lz - f->minimum_exponent);
+
+    if (answer.power2 <= 0) {
+        // Subnormal
+        if (-answer.power2 + 1 >= 64) {
+            answer.mantissa = 0;
+            answer.power2 = 0;
+            return answer;
+        }
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa += answer.mantissa & 1;
+        answer.mantissa >>= 1;
+        answer.power2 = answer.mantissa < ((uint64_t)1 << f->mantissa_bits) ? 0 : 1;
+        return answer;
+    }
+
+    // Exactly halfway between two floats: round to even
+    if (low <= 1 && q >= f->min_exponent_round_to_even && q <= f->max_exponent_round_to_even
+        && (answer.mantissa & 3) == 1 && (answer.mantissa << shift) == high) {
+        answer.mantissa &= ~(uint64_t)1;
+    }
+    answer.mantissa += answer.mantissa & 1;
+    answer.mantissa >>= 1;
+    if (answer.mantissa >= ((uint64_t)2 << f->mantissa_bits)) {
+        answer.mantissa = (uint64_t)1 << f->mantissa_bits;
+        answer.power2 += 1;
+    }
+    answer.mantissa &= ~((uint64_t)1 << f->mantissa_bits);
+    if (answer.power2 >= f->infinite_power) {
+        answer.power2 = f->infinite_power;
+        answer.mantissa = 0;
+    }
+    return answer;
+}
+
+static fsv_float_bits_t fsv_decimal_to_bits(const fsv_decimal_t *d, const fsv_float_format_t *f) {
+    fsv_float_bits_t answer = fsv_eisel_lemire(d->exponent, d->mantissa, f);
+    // The dropped digits can only push the value up to mantissa + 1
+    if (d->truncated && answer.power2 >= 0) {
+        fsv_float_bits_t upper = fsv_eisel_lemire(d->exponent, d->mantissa + 1, f);
+        if (upper.mantissa != answer.mantissa || upper.power2 != answer.power2) answer.power2 = -1;
+    }
+    return answer;
+}
+
+// Hard cases: hand every digit to `strtod` as "digitsE[-]exponent",
+// no decimal point so the locale doesn't matter. The caller applies the sign
+static double fsv_parse_fallback(const fsv_decimal_t *d, bool is_float) {
+    char small[128];
+    size_t capacity = d->integer_length + d->fraction_length + 32;
+    char *buffer = capacity <= sizeof(small) ? small : (char*) FSV_REALLOC(NULL, capacity);
+    FSV_ASSERT(buffer != NULL && "Out of Memory!!!");
+
+    size_t n = 0;
+    memcpy(buffer + n, d->integer, d->integer_length);
+    n += d->integer_length;
+    memcpy(buffer + n, d->fraction, d->fraction_length);
+    n += d->fraction_length;
+    snprintf(buffer + n, capacity - n, "e%lld", (long long)(d->explicit_exponent - (int64_t)d->fraction_length));
+
+    double value = is_float ? (double)strtof(buffer, NULL) : strtod(buffer, NULL);
+    if (buffer != small) FSV_FREE(buffer);
+    return value;
+}
+
+// "inf", "infinity" and "nan" after the sign
+static size_t fsv_parse_special(const char *datas, size_t length, bool *is_nan) {
+    size_t sign = (datas[0] == '-' || datas[0] == '+') ? 1 : 0;
+    fsv_t rest = fsv_from_parts(datas + sign, length - sign);
+    *is_nan = false;
+    if (fsv_starts_with_cstr(rest, "infinity", true)) return sign + 8;
+    if (fsv_starts_with_cstr(rest, "inf", true))      return sign + 3;
+    if (fsv_starts_with_cstr(rest, "nan", true)) {
+        *is_nan = true;
+        return sign + 3;
+    }
+    return 0;
+}
+
+static const double fsv_exact_pow10_f64[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static const float fsv_exact_pow10_f32[] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+};
+
+FSV_DEF fsv_parse_status_t fsv_parse_f64(fsv_t *sv, double *out) {
+    if (sv->length == 0 || sv->datas == NULL) return FSV_PARSE_INVALID;
+    fsv_decimal_t d;
+    double value = 0;
+    size_t length = fsv_parse_decimal(sv->datas, sv->length, &d);
+    if (length == 0) {
+        bool is_nan = false;
+        length = fsv_parse_special(sv->datas, sv->length, &is_nan);
+        if (length == 0) return FSV_PARSE_INVALID;
+        value = is_nan ? (double)NAN : (double)INFINITY;
+        *out = sv->datas[0] == '-' ? -value : value;
+        sv->datas  += length;
+        sv->length -= length;
+        return FSV_PARSE_OK;
+    }
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    // Clinger's fast path: both the mantissa and the power of 10 are exact doubles
+    if (!d.truncated && d.mantissa <= ((uint64_t)1 << 53) && d.exponent >= -22 && d.exponent <= 22) {
+        value = (double)d.mantissa;
+        value = d.exponent < 0 ? value / fsv_exact_pow10_f64[-d.exponent] : value * fsv_exact_pow10_f64[d.exponent];
+    } else
+#endif // FLT_EVAL_METHOD
+    {
+        fsv_float_bits_t bits = fsv_decimal_to_bits(&d, &fsv_binary64);
+        if (bits.power2 < 0) {
+            value = fsv_parse_fallback(&d, false);
+        } else {
+            uint64_t word = bits.mantissa | ((uint64_t)bits.power2 << 52);
+            memcpy(&value, &word, sizeof(value));
+        }
+    }
+    *out = d.negative ? -value : value;
+    sv->datas  += length;
+    sv->length -= length;
+    return isinf(value) ? FSV_PARSE_OVERFLOW : FSV_PARSE_OK;
+}
+
+FSV_DEF fsv_parse_status_t fsv_parse_f32(fsv_t *sv, float *out) {
+    if (sv->length == 0 || sv->datas == NULL) return FSV_PARSE_INVALID;
+    fsv_decimal_t d;
+    float value = 0;
+    size_t length = fsv_parse_decimal(sv->datas, sv->length, &d);
+    if (length == 0) {
+        bool is_nan = false;
+        length = fsv_parse_special(sv->datas, sv->length, &is_nan);
+        if (length == 0) return FSV_PARSE_INVALID;
+        value = is_nan ? NAN : INFINITY;
+        *out = sv->datas[0] == '-' ? -value : value;
+        sv->datas  += length;
+        sv->length -= length;
+        return FSV_PARSE_OK;
+    }
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    if (!d.truncated && d.mantissa <= ((uint64_t)1 << 24) && d.exponent >= -10 && d.exponent <= 10) {
+        value = (float)d.mantissa;
+        value = d.exponent < 0 ? value / fsv_exact_pow10_f32[-d.exponent] : value * fsv_exact_pow10_f32[d.exponent];
+    } else
+#endif // FLT_EVAL_METHOD
+    {
+        fsv_float_bits_t bits = fsv_decimal_to_bits(&d, &fsv_binary32);
+        if (bits.power2 < 0) {
+            value = (float)fsv_parse_fallback(&d, true);
+        } else {
+            uint32_t word = (uint32_t)(bits.mantissa | ((uint64_t)bits.power2 << 23));
+            memcpy(&value, &word, sizeof(value));
+        }
+    }
+    *out = d.negative ? -value : value;
+    sv->datas  += length;
+    sv->length -= length;
+    return isinf(value) ? FSV_PARSE_OVERFLOW : FSV_PARSE_OK;
+}
+
 ///////////////////////// End of String View /////////////////////////
 
+///////////////////////// Allocator /////////////////////////
+
+FSV_DEF void *fsv_allocator_alloc(const fsv_allocator_t *allocator, size_t size) {
+    if (allocator == NULL) return FSV_REALLOC(NULL, size);
+    return allocator->alloc(allocator->ctx, size);
+}
+
+FSV_DEF void *fsv_allocator_resize(const fsv_allocator_t *allocator, void *ptr, size_t old_size, size_t new_size) {
+    if (allocator == NULL) return FSV_REALLOC(ptr, new_size);
+    if (ptr == NULL) return allocator->alloc(allocator->ctx, new_size);
+    return allocator->resize(allocator->ctx, ptr, old_size, new_size);
+}
+
+FSV_DEF void fsv_allocator_release(const fsv_allocator_t *allocator, void *ptr, size_t size) {
+    if (ptr == NULL) return;
+    if (allocator == NULL) FSV_FREE(ptr);
+    else allocator->release(allocator->ctx, ptr, size);
+}
+
+///////////////////////// End of Allocator /////////////////////////
+
 ///////////////////////// String Builder /////////////////////////
 
 #include <stdarg.h>
@@ -430,7 +2871,13 @@ FSV_DEF bool fsv_split_by_pair(fsv_t *right, const char *pair, fsv_t *middle, fs
 #else
 #    include <dirent.h>
 #    include <errno.h>
+#    include <fcntl.h>
+#    include <sys/mman.h>
 #    include <sys/stat.h>
+#    include <unistd.h>
+#    ifdef __linux__
+#        include <sys/syscall.h>
+#    endif // __linux__
 #endif // _WIN32
 
 FSV_DEF bool fsb_read_entire_file(const char *file_path, fsb_t *sb) {
@@ -470,7 +2917,7 @@ FSV_DEF bool fsb_read_entire_file(const char *file_path, fsb_t *sb) {
         goto result;
     }
 
-    fda_reserve(sb, sb->length + file_size + 1);
+    fda_reserve_a(sb, sb->length + file_size + 1);
     byte_read = fread(sb->datas + sb->length, 1, file_size, file);
     FSV_ASSERT(byte_read == (size_t)file_size);
     if (ferror(file)) {
@@ -486,6 +2933,107 @@ result:
     return ret;
 }
 
+// Only "." and "..", not any name ending with a dot
+static inline bool fsv_is_dot_entry(const char *name) {
+    return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+#ifdef __linux__
+// What getdents64 fills its buffer with, glibc only wraps it since 2.30
+typedef struct {
+    uint64_t       d_ino;
+    int64_t        d_off;
+    unsigned short d_reclen;
+    unsigned char  d_type;
+    char           d_name[1];  // NUL terminated, `d_reclen` covers the rest
+} fsv_dirent64_t;
+
+#define FSV_GETDENTS_BUFFER_SIZE (32*1024)
+
+// `path` is the path of `dir_fd` with a trailing '/', entries are appended to it
+// in place and it is restored before returning. Subdirectories are opened
+// relative to `dir_fd`, and `d_type` saves the stat call unless the
+// filesystem reports DT_UNKNOWN.
+static bool fsb_read_dir_fd_linux(int dir_fd, fsb_t *path, ffp_t *children, bool recursive) {
+    bool ret           = true;
+    size_t path_length = path->length;
+    char *buffer       = (char*) FSV_REALLOC(NULL, FSV_GETDENTS_BUFFER_SIZE);
+    FSV_ASSERT(buffer != NULL && "Out of Memory!!!");
+
+    while (true) {
+        long n = syscall(SYS_getdents64, dir_fd, buffer, FSV_GETDENTS_BUFFER_SIZE);
+        if (n == 0) break;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            ret = false;
+            FSV_LOGE("Could not read directory `%s`. %s", path->datas, strerror(errno));
+            break;
+        }
+
+        for (long offset = 0; offset < n;) {
+            const fsv_dirent64_t *ent = (const fsv_dirent64_t*)(buffer + offset);
+            const char *name          = ent->d_name;
+            offset += ent->d_reclen;
+            if (fsv_is_dot_entry(name)) continue;
+
+            path->length = path_length;
+            fsb_append_cstr(path, name);
+            bool is_dir = ent->d_type == DT_DIR;
+            if (ent->d_type == DT_UNKNOWN) {
+                struct stat ent_stat = {};
+                if (fstatat(dir_fd, name, &ent_stat, AT_SYMLINK_NOFOLLOW) < 0) {
+                    ret = false;
+                    FSV_LOGE("Could not lstat entity `%s`. %s", path->datas, strerror(errno));
+                    goto result;
+                }
+                is_dir = S_ISDIR(ent_stat.st_mode);
+            }
+
+            if (!recursive || !is_dir) {
+                ffe_t file  = {};
+                file.name   = fsb_from_sv_with(fsv_from_sb(*path), children->allocator);
+                file.is_dir = is_dir;
+                fda_append_a(children, file);
+                continue;
+            }
+
+            int child_fd = openat(dir_fd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (child_fd < 0) {
+                FSV_LOGE("Could not list contents of subdir `%s`. %s", path->datas, strerror(errno));
+                continue;
+            }
+            fsb_append_char(path, '/');
+            if (!fsb_read_dir_fd_linux(child_fd, path, children, recursive)) {
+                FSV_LOGE("Could not list contents of subdir `%s`", path->datas);
+            }
+            close(child_fd);
+        }
+    }
+
+result:
+    path->length = path_length;
+    path->datas[path_length] = '\0';
+    FSV_FREE(buffer);
+    return ret;
+}
+
+bool fsb_read_entire_dir_linux(const char *parent, ffp_t *children, bool recursive) {
+    int dir_fd = open(parent, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir_fd < 0) {
+        FSV_LOGE("Could not open folder `%s`. %s", parent, strerror(errno));
+        return false;
+    }
+    fsb_t path = {};
+    fsb_append_cstr(&path, parent);
+    if (!fsv_ends_with_cstr(fsv_from_sb(path), "/", false)) fsb_append_char(&path, '/');
+
+    bool ret = fsb_read_dir_fd_linux(dir_fd, &path, children, recursive);
+    close(dir_fd);
+    fsb_free(&path);
+    return ret;
+}
+#endif // __linux__
+
 #ifndef _WIN32
 bool fsb_read_entire_dir_posix(const char *parent, ffp_t *children, bool recursive) {
     bool ret             = true;
@@ -510,11 +3058,7 @@ bool fsb_read_entire_dir_posix(const char *parent, ffp_t *children, bool recursi
     while (true) {
         ent = readdir(dir);
         if (ent == NULL) break;
-        curr_ent = fsv_from_cstr(ent->d_name);
-        if (fsv_ends_with_cstr(curr_ent, ".", false)
-            || fsv_ends_with_cstr(curr_ent, "..", false)) {
-            continue;
-        }
+        if (fsv_is_dot_entry(ent->d_name)) continue;
 
         fsv_tmp_rewind(save_point);
         curr_ent = fsv_tmp_concat_cstr(full_path, ent->d_name);
@@ -527,12 +3071,12 @@ bool fsb_read_entire_dir_posix(const char *parent, ffp_t *children, bool recursi
         file.is_dir = S_ISDIR(ent_stat.st_mode);
 
         if (!recursive) {
-            file.name = fsb_from_sv(curr_ent);
-            fda_append(children, file);
+            file.name = fsb_from_sv_with(curr_ent, children->allocator);
+            fda_append_a(children, file);
         } else {
             if (!file.is_dir) {
-                file.name = fsb_from_sv(curr_ent);
-                fda_append(children, file);
+                file.name = fsb_from_sv_with(curr_ent, children->allocator);
+                fda_append_a(children, file);
             } else {
                 if (!fsb_read_entire_dir_posix(curr_ent.datas, children, recursive)) {
                     FSV_LOGE("Could not list contents of subdir `" fsv_fmt "`. %s",
@@ -593,22 +3137,19 @@ bool fsb_read_entire_dir_windows(const char *parent, ffp_t *children, bool recur
     }
 
     do {
+        if (fsv_is_dot_entry(fd.cFileName)) continue;
         fsv_tmp_rewind(save_point);
         curr_ent = fsv_tmp_concat_continuous_cstr(root, "\\");
         curr_ent = fsv_tmp_concat_cstr(curr_ent, fd.cFileName);
-        if (fsv_ends_with_cstr(curr_ent, ".", false)
-            || fsv_ends_with_cstr(curr_ent, "..", false)) {
-            continue;
-        }
         file.is_dir = fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY;
 
         if (!recursive) {
-            file.name = fsb_from_sv(curr_ent);
-            fda_append(children, file);
+            file.name = fsb_from_sv_with(curr_ent, children->allocator);
+            fda_append_a(children, file);
         } else {
             if (!file.is_dir) {
-                file.name = fsb_from_sv(curr_ent);
-                fda_append(children, file);
+                file.name = fsb_from_sv_with(curr_ent, children->allocator);
+                fda_append_a(children, file);
             } else {
                 if (!fsb_read_entire_dir_windows(curr_ent.datas, children, recursive)) {
                     FSV_LOGE("Could not list contents of subdir `" fsv_fmt "`. %s",
@@ -627,93 +3168,3291 @@ result:
 #endif // _WIN32
 
 FSV_DEF bool fsb_read_entire_dir(const char *parent, ffp_t *children, bool recursive) {
-#ifndef _WIN32
+#if defined(__linux__)
+    return fsb_read_entire_dir_linux(parent, children, recursive);
+#elif !defined(_WIN32)
     return fsb_read_entire_dir_posix(parent, children, recursive);
 #else
     return fsb_read_entire_dir_windows(parent, children, recursive);
 #endif // _WIN32
 }
 
-FSV_DEF int fsb_append_strf(fsb_t *sb, const char *fmt, ...) {
-    va_list args;
-    va_start(args, fmt);
-    int n = vsnprintf(NULL, 0, fmt, args);
-    va_end(args);
+static size_t fpt_push(fpt_t *table, uint32_t parent, const char *name, size_t length, bool is_dir) {
+    FSV_ASSERT(table->size < FPT_NO_PARENT && "Too many entities");
+    FSV_ASSERT(table->names.length + length + 1 <= UINT32_MAX && "Names do not fit in 4 GiB");
+    FSV_ASSERT(length <= UINT16_MAX);
+    fpe_t entity  = {};
+    entity.name   = (uint32_t)table->names.length;
+    entity.parent = parent;
+    entity.length = (uint16_t)length;
+    entity.is_dir = is_dir;
+    table->names.allocator = table->allocator;
+    fsb_append_sv(&table->names, fsv_from_parts(name, length));
+    // Keep the NUL of every name so they can be passed to the OS as they are
+    table->names.length++;
+    fda_append_a(table, entity);
+    return table->size - 1;
+}
 
-    fda_reserve(sb, sb->length + n + 1);
-    char *dest = sb->datas + sb->length;
-    va_start(args, fmt);
-    vsnprintf(dest, n + 1, fmt, args);
-    va_end(args);
+#ifdef __linux__
+// Entities of a directory are pushed first, then its subdirectories are read
+// relative to `dir_fd`
+static bool fpt_read_dir_fd_linux(int dir_fd, fpt_t *table, uint32_t dir, bool recursive, char *buffer) {
+    size_t first = table->size;
+    while (true) {
+        long n = syscall(SYS_getdents64, dir_fd, buffer, FSV_GETDENTS_BUFFER_SIZE);
+        if (n == 0) break;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            FSV_LOGE("Could not read directory `%s`. %s", table->names.datas + table->datas[dir].name, strerror(errno));
+            return false;
+        }
+        for (long offset = 0; offset < n;) {
+            const fsv_dirent64_t *ent = (const fsv_dirent64_t*)(buffer + offset);
+            offset += ent->d_reclen;
+            if (fsv_is_dot_entry(ent->d_name)) continue;
+
+            bool is_dir = ent->d_type == DT_DIR;
+            if (ent->d_type == DT_UNKNOWN) {
+                struct stat ent_stat = {};
+                if (fstatat(dir_fd, ent->d_name, &ent_stat, AT_SYMLINK_NOFOLLOW) < 0) {
+                    FSV_LOGE("Could not lstat entity `%s`. %s", ent->d_name, strerror(errno));
+                    return false;
+                }
+                is_dir = S_ISDIR(ent_stat.st_mode);
+            }
+            fpt_push(table, dir, ent->d_name, strlen(ent->d_name), is_dir);
+        }
+    }
+    if (!recursive) return true;
+
+    size_t last = table->size;
+    for (size_t i = first; i < last; ++i) {
+        if (!table->datas[i].is_dir) continue;
+        const char *name = table->names.datas + table->datas[i].name;
+        int child_fd = openat(dir_fd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (child_fd < 0 || !fpt_read_dir_fd_linux(child_fd, table, (uint32_t)i, recursive, buffer)) {
+            // Recursing may have moved `names`, so `name` can dangle by now
+            FSV_LOGE("Could not list contents of subdir `%s`", table->names.datas + table->datas[i].name);
+        }
+        if (child_fd >= 0) close(child_fd);
+    }
+    return true;
+}
+#else
+// Without directory fds the path of every directory is rebuilt in `path`
+static bool fpt_read_dir_path(fpt_t *table, uint32_t dir, bool recursive, fsb_t *path) {
+    size_t first = table->size;
+    path->length = 0;
+    fpt_append_path(table, dir, path);
+#    ifndef _WIN32
+    DIR *dir_handle = opendir(path->datas);
+    if (dir_handle == NULL) {
+        FSV_LOGE("Could not open folder `%s`. %s", path->datas, strerror(errno));
+        return false;
+    }
+    fsb_append_char(path, '/');
+    size_t path_length = path->length;
+    struct dirent *ent = NULL;
+    while ((ent = readdir(dir_handle)) != NULL) {
+        if (fsv_is_dot_entry(ent->d_name)) continue;
+        path->length = path_length;
+        fsb_append_cstr(path, ent->d_name);
+        struct stat ent_stat = {};
+        if (lstat(path->datas, &ent_stat) < 0) {
+            FSV_LOGE("Could not lstat entity `%s`. %s", path->datas, strerror(errno));
+            closedir(dir_handle);
+            return false;
+        }
+        fpt_push(table, dir, ent->d_name, strlen(ent->d_name), S_ISDIR(ent_stat.st_mode));
+    }
+    closedir(dir_handle);
+#    else
+    WIN32_FIND_DATA fd = {};
+    fsb_append_cstr(path, "\\*.*");
+    HANDLE find_handle = FindFirstFile(path->datas, &fd);
+    if (find_handle == INVALID_HANDLE_VALUE) {
+        FSV_LOGE("Could not open folder `%s`. %s", path->datas, fsv_tmp_get_last_errmsg());
+        return false;
+    }
+    do {
+        if (fsv_is_dot_entry(fd.cFileName)) continue;
+        fpt_push(table, dir, fd.cFileName, strlen(fd.cFileName), fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY);
+    } while (FindNextFile(find_handle, &fd));
+    FindClose(find_handle);
+#    endif // _WIN32
+    if (!recursive) return true;
+
+    size_t last = table->size;
+    for (size_t i = first; i < last; ++i) {
+        if (!table->datas[i].is_dir) continue;
+        if (!fpt_read_dir_path(table, (uint32_t)i, recursive, path)) {
+            FSV_LOGE("Could not list contents of subdir `%s`", table->names.datas + table->datas[i].name);
+        }
+    }
+    return true;
+}
+#endif // __linux__
+
+FSV_DEF bool fpt_read_entire_dir(const char *parent, fpt_t *table, bool recursive) {
+    fsv_t root = fsv_from_cstr(parent);
+    // "logs/" would give "logs//app.log". Roots like "/" and "C:\\" keep theirs,
+    // "C:" alone is the current directory of the drive
+    while (root.length > 1 && (root.datas[root.length - 1] == '/' || root.datas[root.length - 1] == '\\')
+            && root.datas[root.length - 2] != ':') {
+        root.length--;
+    }
+    uint32_t dir = (uint32_t)fpt_push(table, FPT_NO_PARENT, root.datas, root.length, true);
 
-    sb->length += n;
-    return n;
+#ifdef __linux__
+    int dir_fd = open(parent, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir_fd < 0) {
+        FSV_LOGE("Could not open folder `%s`. %s", parent, strerror(errno));
+        return false;
+    }
+    char *buffer = (char*) FSV_REALLOC(NULL, FSV_GETDENTS_BUFFER_SIZE);
+    FSV_ASSERT(buffer != NULL && "Out of Memory!!!");
+    bool ret = fpt_read_dir_fd_linux(dir_fd, table, dir, recursive, buffer);
+    FSV_FREE(buffer);
+    close(dir_fd);
+#else
+    fsb_t path = {};
+    bool ret = fpt_read_dir_path(table, dir, recursive, &path);
+    fsb_free(&path);
+#endif // __linux__
+    return ret;
 }
 
-FSV_DEF void fsb_free(fsb_t *sb) {
-    fda_free(sb);
+FSV_DEF fsv_t fpt_name(const fpt_t *table, size_t index) {
+    const fpe_t *entity = &table->datas[index];
+    return fsv_from_parts(table->names.datas + entity->name, entity->length);
 }
 
-FSV_DEF void ffp_free(ffp_t *fp) {
-    if (fp->datas == NULL) return;
-    ffe_t *fe = NULL;
-    for (size_t i = 0; i < fp->length; ++i) {
-        fe = &fp->datas[i];
-        fsb_free(&fe->name);
-        fe->is_dir = false;
+// No separator after a root like "/" or "C:\\"
+static inline bool fpt_needs_separator(const fpt_t *table, uint32_t index) {
+    const fpe_t *parent = &table->datas[table->datas[index].parent];
+    char last = table->names.datas[parent->name + parent->length - 1];
+    return last != '/' && last != '\\';
+}
+
+FSV_DEF void fpt_append_path(const fpt_t *table, size_t index, fsb_t *sb) {
+    // Walk up to the root to know the length first, then fill it from the end
+    size_t length = 0;
+    for (uint32_t i = (uint32_t)index; i != FPT_NO_PARENT; i = table->datas[i].parent) {
+        length += table->datas[i].length;
+        if (table->datas[i].parent != FPT_NO_PARENT) length += fpt_needs_separator(table, i);
+    }
+    if (sb->length + length + 1 > sb->capacity) fda_realloc_a(sb, length + 1);
+    char *end = sb->datas + sb->length + length;
+    *end = '\0';
+    for (uint32_t i = (uint32_t)index; i != FPT_NO_PARENT; i = table->datas[i].parent) {
+        const fpe_t *entity = &table->datas[i];
+        end -= entity->length;
+        memcpy(end, table->names.datas + entity->name, entity->length);
+        if (entity->parent != FPT_NO_PARENT && fpt_needs_separator(table, i)) {
+#ifdef _WIN32
+            *--end = '\\';
+#else
+            *--end = '/';
+#endif // _WIN32
+        }
     }
-    fda_free(fp);
+    sb->length += length;
 }
 
-FSV_DEF fsv_t fsv_from_sb(const fsb_t sb) {
-    return fsv_from_partial_cstr(sb.datas, sb.length);
+FSV_DEF void fpt_free(fpt_t *table) {
+    fda_free_a(table);
+    fsb_free(&table->names);
 }
 
-FSV_DEF fsb_t fsb_from_sv(const fsv_t sv) {
-    fsb_t ret = {};
-    fda_reserve(&ret, sv.length + 1);
-    for (size_t i = 0; i < sv.length; ++i) {
-        fda_append(&ret, sv.datas[i]);
+#ifndef _WIN32
+// Open without blocking, FIFOs would otherwise wait for a writer. Only regular
+// files are kept, return -1 for the others and keep `file_stat` for the size
+static int fsv_open_regular_file(const char *file_path, struct stat *file_stat) {
+    int fd = open(file_path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return -1;
+    int err = 0;
+    if (fstat(fd, file_stat) < 0) {
+        err = errno;
+    } else if (!S_ISREG(file_stat->st_mode)) {
+        err = EINVAL;
     }
-    // Set null-terminated for passing into
-    // `fsb_read_entire_dir` or `fsb_read_entire_file`
-    // while doesn't make `fsv_eq` produce wrong result
-    ret.datas[sv.length] = '\0';
-    return ret;
+    if (err != 0) {
+        close(fd);
+        errno = err;
+        return -1;
+    }
+    return fd;
 }
 
-///////////////////////// End of String Builder /////////////////////////
+// Map the regular file `fd` and close it
+static bool fsv_mmap_fd(int fd, const struct stat *file_stat, const char *file_path, int hints, fsv_t *out) {
+    (void)file_path;  // Only for the log
+    *out = fsv_from_parts("", 0);
+    size_t size = (size_t)file_stat->st_size;
+    if (size == 0) {
+        close(fd);
+        return true;
+    }
 
-///////////////////////// Temporary Buffer /////////////////////////
-#ifndef FSV_DISABLE_TMP_BUFFER
+    void *datas = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file
+    close(fd);
+    if (datas == MAP_FAILED) {
+        FSV_LOGE("Could not mmap file `%s`. %s", file_path, strerror(errno));
+        return false;
+    }
 
-#ifndef FSV_TMP_CAPACITY
-#define FSV_TMP_CAPACITY (10*1024)
-#endif // FSV_TMP_CAPACITY
+    // Hints are only advices, a kernel that doesn't know them is fine
+    if (hints & FSV_MMAP_SEQUENTIAL) (void)madvise(datas, size, MADV_SEQUENTIAL);
+    if (hints & FSV_MMAP_WILLNEED)   (void)madvise(datas, size, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+    if (hints & FSV_MMAP_HUGEPAGES)  (void)madvise(datas, size, MADV_HUGEPAGE);
+#endif // MADV_HUGEPAGE
 
-static char fsv_tmp_buffer[FSV_TMP_CAPACITY] = {0};
-static size_t fsv_tmp_size = 0;
+    *out = fsv_from_parts((const char*)datas, size);
+    return true;
+}
+#endif // _WIN32
 
-FSV_DEF char *fsv_tmp_alloc(size_t how_many_chars) {
-    if (fsv_tmp_size + how_many_chars >= FSV_TMP_CAPACITY) {
-        FSV_ASSERT(false && "Extend the size of temporary allocator");
-        return NULL;
+FSV_DEF bool fsv_mmap_file(const char *file_path, int hints, fsv_t *out) {
+    *out = fsv_from_parts("", 0);
+#ifndef _WIN32
+    struct stat file_stat = {};
+    int fd = fsv_open_regular_file(file_path, &file_stat);
+    if (fd < 0) {
+        FSV_LOGE("Could not open regular file `%s`. %s", file_path, strerror(errno));
+        return false;
     }
-    char *ret = &fsv_tmp_buffer[fsv_tmp_size];
-    fsv_tmp_size += how_many_chars;
-    return ret;
+    return fsv_mmap_fd(fd, &file_stat, file_path, hints, out);
+#else
+    LARGE_INTEGER file_size = {};
+    HANDLE mapping          = NULL;
+    void *datas             = NULL;
+    DWORD flags             = (hints & FSV_MMAP_SEQUENTIAL) ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL;
+    HANDLE file             = CreateFileA(file_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        FSV_LOGE("Could not open file `%s`. %s", file_path, fsv_tmp_get_last_errmsg());
+        return false;
+    }
+    if (!GetFileSizeEx(file, &file_size)) {
+        FSV_LOGE("Could not get the size of file `%s`. %s", file_path, fsv_tmp_get_last_errmsg());
+        CloseHandle(file);
+        return false;
+    }
+    if (file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return true;
+    }
+
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping != NULL) datas = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (datas == NULL) FSV_LOGE("Could not map file `%s`. %s", file_path, fsv_tmp_get_last_errmsg());
+    // The view keeps its own references to the mapping and the file
+    if (mapping != NULL) CloseHandle(mapping);
+    CloseHandle(file);
+    if (datas == NULL) return false;
+
+    if (hints & FSV_MMAP_WILLNEED) {
+        WIN32_MEMORY_RANGE_ENTRY range = { datas, (SIZE_T)file_size.QuadPart };
+        (void)PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+
+    *out = fsv_from_parts((const char*)datas, (size_t)file_size.QuadPart);
+    return true;
+#endif // _WIN32
 }
 
-FSV_DEF void fsv_tmp_reset(void) {
-    fsv_tmp_size = 0;
+FSV_DEF void fsv_munmap_file(fsv_t *sv) {
+    if (sv->length > 0) {
+#ifndef _WIN32
+        munmap((void*)sv->datas, sv->length);
+#else
+        UnmapViewOfFile(sv->datas);
+#endif // _WIN32
+    }
+    sv->datas  = NULL;
+    sv->length = 0;
+}
+
+// Spare room kept before formatting, so short appends are done in one pass
+#define FSB_STRF_MIN_SPARE (64)
+
+FSV_DEF int fsb_append_strf(fsb_t *sb, const char *fmt, ...) {
+    va_list args;
+    if (sb->length + FSB_STRF_MIN_SPARE > sb->capacity) fda_realloc_a(sb, FSB_STRF_MIN_SPARE);
+
+    // Format into the spare capacity first, only run a second pass when it didn't fit
+    size_t spare = sb->capacity - sb->length;
+    va_start(args, fmt);
+    int n = vsnprintf(sb->datas + sb->length, spare, fmt, args);
+    va_end(args);
+    if (n < 0) {
+        sb->datas[sb->length] = '\0';
+        return n;
+    }
+
+    if ((size_t)n >= spare) {
+        fda_realloc_a(sb, (size_t)n + 1);
+        va_start(args, fmt);
+        vsnprintf(sb->datas + sb->length, (size_t)n + 1, fmt, args);
+        va_end(args);
+    }
+    sb->length += n;
+    return n;
+}
+
+// Room for `n` more chars and the NUL terminator
+static inline char *fsb_spare(fsb_t *sb, size_t n) {
+    if (sb->length + n + 1 > sb->capacity) fda_realloc_a(sb, n + 1);
+    return sb->datas + sb->length;
+}
+
+FSV_DEF void fsb_append_sv(fsb_t *sb, fsv_t sv) {
+    if (sv.datas == NULL) sv.length = 0;
+    char *dest = fsb_spare(sb, sv.length);
+    if (sv.length > 0) memcpy(dest, sv.datas, sv.length);
+    sb->length += sv.length;
+    sb->datas[sb->length] = '\0';
+}
+
+FSV_DEF void fsb_append_cstr(fsb_t *sb, const char *cstr) {
+    fsb_append_sv(sb, fsv_from_cstr(cstr));
+}
+
+FSV_DEF void fsb_append_char(fsb_t *sb, char c) {
+    char *dest = fsb_spare(sb, 1);
+    dest[0] = c;
+    dest[1] = '\0';
+    sb->length += 1;
+}
+
+static const char fsv_digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static inline size_t fsv_count_digits(uint64_t value) {
+    size_t n = 1;
+    for (;;) {
+        if (value < 10)    return n;
+        if (value < 100)   return n + 1;
+        if (value < 1000)  return n + 2;
+        if (value < 10000) return n + 3;
+        value /= 10000;
+        n += 4;
+    }
+}
+
+// Write the digits of `value` backward, two at a time, ending right before `end`
+static inline void fsv_write_digits(char *end, uint64_t value) {
+    while (value >= 100) {
+        size_t pair = (size_t)(value % 100)*2;
+        value /= 100;
+        *--end = fsv_digit_pairs[pair + 1];
+        *--end = fsv_digit_pairs[pair];
+    }
+    if (value >= 10) {
+        *--end = fsv_digit_pairs[value*2 + 1];
+        *--end = fsv_digit_pairs[value*2];
+    } else {
+        *--end = (char)('0' + value);
+    }
+}
+
+FSV_DEF void fsb_append_u64(fsb_t *sb, uint64_t value) {
+    size_t n = fsv_count_digits(value);
+    char *dest = fsb_spare(sb, n);
+    fsv_write_digits(dest + n, value);
+    dest[n] = '\0';
+    sb->length += n;
+}
+
+FSV_DEF void fsb_append_i64(fsb_t *sb, int64_t value) {
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    size_t n = fsv_count_digits(magnitude) + (value < 0);
+    char *dest = fsb_spare(sb, n);
+    if (value < 0) dest[0] = '-';
+    fsv_write_digits(dest + n, magnitude);
+    dest[n] = '\0';
+    sb->length += n;
+}
+
+// Shortest decimal of a double is Schubfach by Raffaello Giulietti, following
+// the reference Java implementation: https://github.com/c4f7fcce9cb06515/Schubfach
+#define FSV_SCHUBFACH_K_MIN (-324)
+#define FSV_SCHUBFACH_K_MAX (292)
+
+// For k in [-324, 292]: 10^-k = b 2^r with 2^125 <= b < 2^126, g = floor(b) + 1
+// split in two 63 bits halves
+static const uint64_t fsv_schubfach_g[2*(FSV_SCHUBFACH_K_MAX - FSV_SCHUBFACH_K_MIN + 1)] = {
+    0x4f0cedc95a718dd4ull, 0x5b01e8b09aa0d1b5ull,
+    0x7e7b160ef71c1621ull, 0x119ca780f767b5eeull,
+    0x652f44d8c5b011b4ull, 0x0e16ec672c52f7f2ull,
+    0x50f29d7a37c00e29ull, 0x581256b8f0425ff5ull,
+    0x40c21794f96671baull, 0x79a84560c0351991ull,
+    0x679cf287f570b5f7ull, 0x75da089acd21c281ull,
+    0x52e3f5399126f7f9ull, 0x44ae6d48a41b0201ull,
+    0x424ff76140ebf994ull, 0x36f1f106e9af34cdull,
+    0x6a198bcece465c20ull, 0x57e981a4a918547bull,
+    0x54e13ca571d1e34dull, 0x2cbace1d541376c9ull,
+    0x43e763b78e4182a4ull, 0x23c8a4e44342c56eull,
+    0x6ca56c58e39c043aull, 0x060dd4a06b9e08b0ull,
+    0x56eabd13e9499cfbull, 0x1e7176e6bc7e6d59ull,
+    0x458897432107b0c8ull, 0x7ec12bebc9febde1ull,
+    0x6f40f20501a5e7a7ull, 0x7e01dfdfa9979635ull,
+    0x5900c19d9aeb1fb9ull, 0x4b34b319547944f7ull,
+    0x4733ce17af227fc7ull, 0x55c3c27aa9fa9d93ull,
+    0x71ec7cf2b1d0cc72ull, 0x560603f7765dc8eaull,
+    0x5b2397288e40a38eull, 0x7804cff92b7e3a55ull,
+    0x48e945ba0b66e93full, 0x13370cc755fe9511ull,
+    0x74a86f90123e41feull, 0x51f1ae0bbcca881bull,
+    0x5d538c7341cb67feull, 0x74c1580963d539afull,
+    0x4aa93d29016f8665ull, 0x43cde0078310faf3ull,
+    0x77752ea8024c0a3cull, 0x0616333f381b2b1eull,
+    0x5f90f22001d66e96ull, 0x3811c298f9af55b1ull,
+    0x4c73f4e667debedeull, 0x600e35472e25de28ull,
+    0x7a532170a6313164ull, 0x3349eed849d6303full,
+    0x61dc1ac084f42783ull, 0x42a18be03b11c033ull,
+    0x4e49af006a5cec69ull, 0x1bb46fe695a7ccf5ull,
+    0x7d42b19a43c7e0a8ull, 0x2c53e63dbc3fae55ull,
+    0x64355ae1cfd31a20ull, 0x237651cafcffbeaaull,
+    0x502aaf1b0ca8e1b3ull, 0x35f8416f30cc9888ull,
+    0x402225af3d53e7c2ull, 0x5e603458f3d6e06dull,
+    0x669d0918621fd937ull, 0x4a3386f4b957cd7bull,
+    0x52173a79e8197a92ull, 0x6e8f9f2a2ddfd796ull,
+    0x41ac2ec7ece12edbull, 0x720c7f54f17fdfabull,
+    0x69137e0cae3517c6ull, 0x1ce0cbbb1bffcc45ull,
+    0x540f980a24f74638ull, 0x171a3c95afffd69eull,
+    0x433facd4ea5f6b60ull, 0x127b63aaf3331218ull,
+    0x6b991487dd657899ull, 0x6a5f05de51eb5026ull,
+    0x5614106cb11dfa14ull, 0x5518d17ea7ef7352ull,
+    0x44dcd9f08db194ddull, 0x2a7a41321ff2c2a8ull,
+    0x6e2e2980e2b5bafbull, 0x5d906850331e043full,
+    0x5824ee00b55e2f2full, 0x647386a68f4b3699ull,
+    0x4683f19a2ab1bf59ull, 0x36c2d21ed908f87bull,
+    0x70d31c29dde93228ull, 0x579e1cfe280e5a5dull,
+    0x5a427cee4b20f4edull, 0x2c7e7d98200b7b7eull,
+    0x483530bea280c3f1ull, 0x09fecae019a2c932ull,
+    0x73884dfdd0ce064eull, 0x43314499c29e0eb6ull,
+    0x5c6d0b3173d8050bull, 0x4f5a9d47cee4d891ull,
+    0x49f0d5c129799da2ull, 0x72aee4397250ad41ull,
+    0x764e22cea8c295d1ull, 0x377e39f583b44868ull,
+    0x5ea4e8a553cede41ull, 0x12cb61913629d387ull,
+    0x4bb72084430be500ull, 0x756f8140f8217605ull,
+    0x792500d39e796e67ull, 0x6f18cece59cf233cull,
+    0x60ea670fb1fabeb9ull, 0x3f470bd847d8e8fdull,
+    0x4d885272f4c89894ull, 0x329f3cad064720caull,
+    0x7c0d50b7ee0dc0edull, 0x37652de1a3a50143ull,
+    0x633dda2cbe716724ull, 0x2c50f1814fb73436ull,
+    0x4f64ae8a31f45283ull, 0x3d0d8e010c92902bull,
+    0x7f077da9e986ea6bull, 0x7b48e334e0ea8045ull,
+    0x659f97bb2138bb89ull, 0x49071c2a4d88669dull,
+    0x514c796280fa2fa1ull, 0x20d27ceea46d1ee4ull,
+    0x4109fab533fb594dull, 0x670eca58838a7f1dull,
+    0x680ff788532bc216ull, 0x0b4add5a6c10cb62ull,
+    0x533ff939dc2301abull, 0x22a24aaebcda3c4eull,
+    0x4299942e49b59aefull, 0x354ea22563e1c9d8ull,
+    0x6a8f537d42bc2b18ull, 0x554a9d089fcfa95aull,
+    0x553f75fdcefcef46ull, 0x776ee406e63fbaaeull,
+    0x4432c4cb0bfd8c38ull, 0x5f8be99f1e996225ull,
+    0x6d1e07ab466279f4ull, 0x327975cb64289d08ull,
+    0x574b3955d1e86190ull, 0x28612b091ced4a6dull,
+    0x45d5c777db204e0dull, 0x06b4226db0bdd524ull,
+    0x6fbc72595e9a167bull, 0x24536a491ac95506ull,
+    0x59638eade54811fcull, 0x1d0f883a7bd44405ull,
+    0x4782d88b1dd34196ull, 0x4a72d361fca9d004ull,
+    0x726af411c952028aull, 0x43eaebcffaa94cd3ull,
+    0x5b88c3416ddb353bull, 0x4fef230cc88770a9ull,
+    0x493a35cdf17c2a96ull, 0x0cbf4f3d6d3926eeull,
+    0x7529efafe8c6aa89ull, 0x61321862485b717cull,
+    0x5dbb262653d22207ull, 0x675b46b506af8dfdull,
+    0x4afc1e850fdb4e6cull, 0x52af6bc405593e64ull,
+    0x77f9ca6e7fc54a47ull, 0x377f12d33bc1fd6dull,
+    0x5ffb085866376e9full, 0x45ff42429634cabdull,
+    0x4cc8d379eb5f8bb2ull, 0x6b329b68782a3bcbull,
+    0x7adaebf64565ac51ull, 0x2b842bda59dd2c77ull,
+    0x6248bcc5045156a7ull, 0x3c69bcaeae4a89f9ull,
+    0x4ea0970403744552ull, 0x6387ca25583ba194ull,
+    0x7dcdbe6cd253a21eull, 0x05a6103bc05f68edull,
+    0x64a498570ea94e7eull, 0x37b80cfc99e5ed8aull,
+    0x5083ad1272210b98ull, 0x2c933d96e184be08ull,
+    0x40695741f4e73c79ull, 0x7075cadf1ad09807ull,
+    0x670ef2032171fa5cull, 0x4d8944982ae759a4ull,
+    0x52725b35b45b2eb0ull, 0x3e076a135585e150ull,
+    0x41f515c49048f226ull, 0x64d2bb42aad1810dull,
+    0x698822d41a0e503eull, 0x07b7920444826815ull,
+    0x546ce8a9ae71d9cbull, 0x1fc60e69d0685344ull,
+    0x438a53baf1f4ae3cull, 0x196b3ebb0d20429dull,
+    0x6c1085f7e9877d2dull, 0x0f11fdf815006a94ull,
+    0x56739e5fee05fdbdull, 0x58db319344005543ull,
+    0x45294b7ff19e6497ull, 0x60af5adc3666aa9cull,
+    0x6ea878ccb5ca3a8cull, 0x344bc4938a3dddc7ull,
+    0x5886c70a2b082ed6ull, 0x5d096a0fa1cb17d2ull,
+    0x46d238d4ef39bf12ull, 0x173abb3fb4a27975ull,
+    0x71505aee4b8f981dull, 0x0b912b992103f588ull,
+    0x5aa6af25093face4ull, 0x0940efadb4032ad3ull,
+    0x488558ea6dcc8a50ull, 0x07672624900288a9ull,
+    0x74088e43e2e0dd4cull, 0x723ea36db337410eull,
+    0x5cd3a5031be71770ull, 0x5b654f8af5c5cda5ull,
+    0x4a42ea68e31f45f3ull, 0x62b772d5916b0aebull,
+    0x76d1770e38320986ull, 0x0458b7bc1bde77ddull,
+    0x5f0df8d82cf4d46bull, 0x1d13c630164b9318ull,
+    0x4c0b2d79bd90a9efull, 0x30dc9e8cdea2dc13ull,
+    0x79ab7bf5fc1aa97full, 0x0160fdae31049351ull,
+    0x6155fcc4c9aeedffull, 0x1ab3fe24f403a90eull,
+    0x4dde63d0a158be65ull, 0x6229981d9002eda5ull,
+    0x7c97061a9bc130a2ull, 0x69dc2695b337e2a1ull,
+    0x63ac04e2163426e8ull, 0x54b01ede28f9821bull,
+    0x4fbcd0b4de901f20ull, 0x43c018b1ba6134e2ull,
+    0x7f9481216419cb67ull, 0x1f99c11c5d68549dull,
+    0x6610674de9ae3c52ull, 0x4c7b00e37ded107eull,
+    0x51a6b90b21583042ull, 0x09fc00b5fe574065ull,
+    0x41522da2811359ceull, 0x3b3000919845cd1dull,
+    0x68837c3734ebc2e3ull, 0x784ccdb5c06fae95ull,
+    0x539c635f5d8968b6ull, 0x2d0a3e2b00595877ull,
+    0x42e382b2b13aba2bull, 0x3da1cb5599e11393ull,
+    0x6b059deab52ac378ull, 0x629c7888f634ec1eull,
+    0x559e17eef755692dull, 0x3549fa072b5d89b1ull,
+    0x447e798bf91120f1ull, 0x1107fb38ef7e07c1ull,
+    0x6d9728dff4e834b5ull, 0x01a65ec17f300c68ull,
+    0x57ac20b32a535d5dull, 0x4e1eb23465c009edull,
+    0x46234d5c21dc4ab1ull, 0x24e55b5d1e333b24ull,
+    0x70387bc69c93aab5ull, 0x216ef894fd1ec506ull,
+    0x59c6c96bb076222aull, 0x4df2607730e56a6cull,
+    0x47d23abc8d2b4e88ull, 0x3e5b805f5a5121f0ull,
+    0x72e9f79415121740ull, 0x63c59a322a1b697full,
+    0x5bee5fa9aa74df67ull, 0x03047b5b54e2baccull,
+    0x498b7fbaeec3e5ecull, 0x0269fc4910b5623dull,
+    0x75abff917e063cacull, 0x6a432d41b45569fbull,
+    0x5e2332dacb38308aull, 0x21cf5767c37787fcull,
+    0x4b4f5be23c2cf3a1ull, 0x67d912b9692c6ccaull,
+    0x787ef969f9e185cfull, 0x595b5128a8471476ull,
+    0x60659454c7e79e3full, 0x6115da86ed05a9f8ull,
+    0x4d1e1043d31fb1ccull, 0x4dab1538bd9e2193ull,
+    0x7b634d3951cc4fadull, 0x62ab552795c9cf52ull,
+    0x62b5d7610e3d0c8bull, 0x0222aa86116e3f75ull,
+    0x4ef7df80d830d6d5ull, 0x4e822204dabe992aull,
+    0x7e59659af38157bcull, 0x17369cd49130f510ull,
+    0x65145148c2cddfc9ull, 0x5f5ee3dd40f3f740ull,
+    0x50dd0dd3cf0b196eull, 0x1918b64a9a5cc5cdull,
+    0x40b0d7dca5a27abeull, 0x4746f83baeb09e3eull,
+    0x678159610903f797ull, 0x253e59f91780fd2full,
+    0x52cde11a6d9cc612ull, 0x50feae60df9a6426ull,
+    0x423e4daebe1704dbull, 0x5a65584d7faeb685ull,
+    0x69fd4917968b3af9ull, 0x10a226e265e4573bull,
+    0x54caa0dfaba29594ull, 0x0d4e8581eb1d1295ull,
+    0x43d54d7fbc821143ull, 0x243ed134bc174211ull,
+    0x6c887bff94034ed2ull, 0x06cae85460253682ull,
+    0x56d396661002a574ull, 0x6bd586a9e6842b9bull,
+    0x457611eb40021df7ull, 0x09779eee52035616ull,
+    0x6f234fdeccd02ff1ull, 0x5bf297e3b66bbcefull,
+    0x58e90cb23d73598eull, 0x165bacb62b8963f3ull,
+    0x4720d6f4fdf5e13eull, 0x451623c4efa11cc2ull,
+    0x71ce24bb2fefcecaull, 0x3b569fa17f682e03ull,
+    0x5b0b5095bff30bd5ull, 0x15dee61acc535803ull,
+    0x48d5da11665c0977ull, 0x2b18b8157042accfull,
+    0x74895ce8a3c6758bull, 0x5e8df355806aae18ull,
+    0x5d3ab0ba1c9ec46full, 0x653e5c4466bbbe7aull,
+    0x4a955a2e7d4bd059ull, 0x3765169d1efc9861ull,
+    0x77555d172edfb3c2ull, 0x256e8a94fe60f3cfull,
+    0x5f777dac257fc301ull, 0x6abed543feb3f63full,
+    0x4c5f97bceacc9c01ull, 0x3bcbddcffef65e99ull,
+    0x7a328c6177adc668ull, 0x5fac961997f0975bull,
+    0x61c209e792f16b86ull, 0x7fbd44e1465a12afull,
+    0x4e34d4b9425abc6bull, 0x7fca9d810514dbbfull,
+    0x7d21545b9d5dfa46ull, 0x32ddc8ce6e87c5ffull,
+    0x641aa9e2e44b2e9eull, 0x5be4a0a525396b32ull,
+    0x501554b5836f587eull, 0x7cb6e6ea842def5cull,
+    0x4011109135f2ad32ull, 0x30925255368b25e3ull,
+    0x6681b41b89844850ull, 0x4db6ea21f0dea304ull,
+    0x52015ce2d469d373ull, 0x57c5881b2718826aull,
+    0x419ab0b576bb0f8full, 0x5fd139af527a01efull,
+    0x68f781225791b27full, 0x4c81f5e550c3364aull,
+    0x53f9341b79415b99ull, 0x239b2b1dda35c508ull,
+    0x432dc3492dcde2e1ull, 0x02e288e4ae916a6dull,
+    0x6b7c6ba849496b01ull, 0x516a74a1174f10aeull,
+    0x55fd22ed076def34ull, 0x4121f6e745d8da25ull,
+    0x44ca82573924bf5dull, 0x1a8192529e4714ebull,
+    0x6e10d08b8ea1322eull, 0x5d9c1d50fd3e87ddull,
+    0x580d73a2d880f4f2ull, 0x17b01773fdcb9fe4ull,
+    0x4671294f139a5d8eull, 0x4626792997d61984ull,
+    0x70b50ee4ec2a2f4aull, 0x3d0a5b75bfbcf59full,
+    0x5a2a7250bcee8c3bull, 0x4a6eaf916630c47full,
+    0x4821f50d63f209c9ull, 0x21f2260deb5a36ccull,
+    0x736988156cb6760eull, 0x69837016455d247aull,
+    0x5c546cddf091f80bull, 0x6e02c011d1175062ull,
+    0x49dd23e4c074c66full, 0x719bccdb0dac404eull,
+    0x762e9fd467213d7full, 0x68f947c4e2ad33b0ull,
+    0x5e8bb3105280fdffull, 0x6d94396a4ef0f627ull,
+    0x4ba2f5a6a8673199ull, 0x3e102deea58d91b9ull,
+    0x7904bc3dda3eb5c2ull, 0x3019e3176f48e927ull,
+    0x60d09697e1cbc49bull, 0x4014b5ac590720ecull,
+    0x4d73abacb4a303afull, 0x4cdd5e237a6c1a57ull,
+    0x7bec45e12104d2b2ull, 0x47c8969f2a46908aull,
+    0x63236b1a80d0a88eull, 0x6ca0787f5505406full,
+    0x4f4f88e200a6ed3full, 0x0a19f9ff773766bfull,
+    0x7ee5a7d0010b1531ull, 0x5cf65ccbf1f23dfeull,
+    0x6584864000d5aa8eull, 0x172b7d6ff4c1cb32ull,
+    0x5136d1cccd77bba4ull, 0x78ef978cc3ce3c28ull,
+    0x40f8a7d70ac62fb7ull, 0x13f2dfa3cfd83020ull,
+    0x67f43fbe77a37f8bull, 0x398499061959e699ull,
+    0x5329cc985fb5ffa2ull, 0x6136e0d1ade18548ull,
+    0x4287d6e04c91994full, 0x00f8b3daf181376dull,
+    0x6a72f166e0e8f54bull, 0x1b27862b1c01f247ull,
+    0x5528c11f1a53f76full, 0x2f52d1bc1667f506ull,
+    0x44209a7f48432c59ull, 0x0c424163451ff738ull,
+    0x6d00f7320d3846f4ull, 0x7a039bd208332526ull,
+    0x5733f8f4d76038c3ull, 0x7b361641a028ea85ull,
+    0x45c32d90ac4cfa36ull, 0x2f5e78348020bb9eull,
+    0x6f9eaf4de07b29f0ull, 0x4bca59ed99cdf8fcull,
+    0x594bbf71806287f3ull, 0x563b7b247b0b2d96ull,
+    0x476fcc5acd1b9ff6ull, 0x11c92f50626f57acull,
+    0x724c7a2ae1c5ccbdull, 0x02db7ee703e55912ull,
+    0x5b7061bbe7d17097ull, 0x1be2cbec031de0dcull,
+    0x4926b496530df3acull, 0x164f09899c17e716ull,
+    0x750aba8a1e7cb913ull, 0x3d4b4275c68ca4f0ull,
+    0x5da22ed4e530940full, 0x4aa29b916ba3b726ull,
+    0x4ae825771dc07672ull, 0x6ee87c74561c9285ull,
+    0x77d9d58b62cd8a51ull, 0x3173fa53bcfa8408ull,
+    0x5fe177a2b5713b74ull, 0x278ffb7630c869a0ull,
+    0x4cb45fb55df42f90ull, 0x1fa662c4f3d387b3ull,
+    0x7aba32bbc986b280ull, 0x32a3d13b1fb8d91full,
+    0x622e8efca1388ecdull, 0x0ee9742f4c93e0e6ull,
+    0x4e8ba596e760723dull, 0x58bac3590a0fe71eull,
+    0x7dac3c24a5671d2full, 0x412ad228101971c9ull,
+    0x6489c9b6eab8e426ull, 0x00ef0e8673478e3bull,
+    0x506e3af8bbc71cebull, 0x1a58d86b8f6c71c9ull,
+    0x40582f2d6305b0bcull, 0x1513e0560c56c16eull,
+    0x66f37eaf04d5e793ull, 0x3b530089ad579be2ull,
+    0x525c6558d0ab1fa9ull, 0x15dc006e2446164full,
+    0x41e384470d55b2edull, 0x5e4999f1b69e783full,
+    0x696c06d81555eb15ull, 0x7d428fe92430c065ull,
+    0x54566be0111188deull, 0x31020cba835a3384ull,
+    0x4378564cda746d7eull, 0x5a680a2ecf7b5c69ull,
+    0x6bf3bd47c3ed7bfdull, 0x770cdd17b25efa42ull,
+    0x565c976c9cbdfccbull, 0x1270b0dfc1e59502ull,
+    0x4516df8a16fe63d5ull, 0x5b8d5a4c9b1e10ceull,
+    0x6e8aff4357fd6c89ull, 0x127bc3adc4fce7b0ull,
+    0x586f329c466456d4ull, 0x0ec96957d0ca52f3ull,
+    0x46bf5bb038504576ull, 0x3f07877973d50f29ull,
+    0x71322c4d26e6d58aull, 0x31a5a58f1fbb4b75ull,
+    0x5a8e89d75252446eull, 0x5aeaead8e62f6f91ull,
+    0x487207df750e9d25ull, 0x2f22557a51bf8c74ull,
+    0x73e9a63254e42ea2ull, 0x1836ef2a1c65ad86ull,
+    0x5cbaeb5b771cf21bull, 0x2cf8bf54e3848ad2ull,
+    0x4a2f22af927d8e7cull, 0x23fa32aa4f9d3bdbull,
+    0x76b1d118ea627d93ull, 0x5329eaaa18fb92f8ull,
+    0x5ef4a74721e86476ull, 0x0f54bbbb472fa8c6ull,
+    0x4bf6ec38e7ed1d2bull, 0x25dd62fc38f2ed6cull,
+    0x798b138e3fe1c845ull, 0x22fbd1938e517bdfull,
+    0x613c0fa4ffe7d36aull, 0x4f2fdadc71dac97full,
+    0x4dc9a61d998642bbull, 0x58f3157d27e23accull,
+    0x7c75d695c2706ac5ull, 0x74b82261d969f7adull,
+    0x63917877cec0556bull, 0x10934eb4adee5fbeull,
+    0x4fa793930bcd1122ull, 0x4075d8908b251965ull,
+    0x7f7285b812e1b504ull, 0x00bc8db411d4f56eull,
+    0x65f537c675815d9cull, 0x66fd3e29a7dd9125ull,
+    0x5190f96b91344ae3ull, 0x6bfdcb54864ada84ull,
+    0x4140c78940f6a24full, 0x6ffe3c439ea2486aull,
+    0x6867a5a867f103b2ull, 0x7ffd2d38fdd073dcull,
+    0x53861e2053273628ull, 0x6664242d97d9f64aull,
+    0x42d1b1b375b8f820ull, 0x51e9b68adfe191d5ull,
+    0x6ae91c5255f4c034ull, 0x1ca924116635b621ull,
+    0x558749db77f70029ull, 0x63ba83411e915e81ull,
+    0x446c3b15f9926687ull, 0x6962029a7edab201ull,
+    0x6d79f82328ea3da6ull, 0x0f03375d97c45001ull,
+    0x5794c6828721caebull, 0x259c2c4adfd04001ull,
+    0x46109eced2816f22ull, 0x5149bd08b30d0001ull,
+    0x701a97b150cf1837ull, 0x3542c80deb480001ull,
+    0x59aedfc10d7279c5ull, 0x7768a00b22a00001ull,
+    0x47bf19673df52e37ull, 0x79208008e8800001ull,
+    0x72cb5bd86321e38cull, 0x5b67334174000001ull,
+    0x5bd5e313828182d6ull, 0x7c528f6790000001ull,
+    0x4977e8dc68679bdfull, 0x16a872b940000001ull,
+    0x758ca7c70d7292feull, 0x5773eac200000001ull,
+    0x5e0a1fd271287598ull, 0x45f6556800000001ull,
+    0x4b3b4ca85a86c47aull, 0x04c5112000000001ull,
+    0x785ee10d5da46d90ull, 0x07a1b50000000001ull,
+    0x604be73de4838ad9ull, 0x52e7c40000000001ull,
+    0x4d0985cb1d3608aeull, 0x0f1fd00000000001ull,
+    0x7b426fab61f00de3ull, 0x31cc800000000001ull,
+    0x629b8c891b267182ull, 0x5b0a000000000001ull,
+    0x4ee2d6d415b85aceull, 0x7c08000000000001ull,
+    0x7e37be2022c0914bull, 0x1340000000000001ull,
+    0x64f964e68233a76full, 0x2900000000000001ull,
+    0x50c783eb9b5c85f2ull, 0x5400000000000001ull,
+    0x409f9cbc7c4a04c2ull, 0x1000000000000001ull,
+    0x6765c793fa10079dull, 0x0000000000000001ull,
+    0x52b7d2dcc80cd2e4ull, 0x0000000000000001ull,
+    0x422ca8b0a00a4250ull, 0x0000000000000001ull,
+    0x69e10de76676d080ull, 0x0000000000000001ull,
+    0x54b40b1f852bda00ull, 0x0000000000000001ull,
+    0x43c33c1937564800ull, 0x0000000000000001ull,
+    0x6c6b935b8bbd4000ull, 0x0000000000000001ull,
+    0x56bc75e2d6310000ull, 0x0000000000000001ull,
+    0x4563918244f40000ull, 0x0000000000000001ull,
+    0x6f05b59d3b200000ull, 0x0000000000000001ull,
+    0x58d15e1762800000ull, 0x0000000000000001ull,
+    0x470de4df82000000ull, 0x0000000000000001ull,
+    0x71afd498d0000000ull, 0x0000000000000001ull,
+    0x5af3107a40000000ull, 0x0000000000000001ull,
+    0x48c2739500000000ull, 0x0000000000000001ull,
+    0x746a528800000000ull, 0x0000000000000001ull,
+    0x5d21dba000000000ull, 0x0000000000000001ull,
+    0x4a817c8000000000ull, 0x0000000000000001ull,
+    0x7735940000000000ull, 0x0000000000000001ull,
+    0x5f5e100000000000ull, 0x0000000000000001ull,
+    0x4c4b400000000000ull, 0x0000000000000001ull,
+    0x7a12000000000000ull, 0x0000000000000001ull,
+    0x61a8000000000000ull, 0x0000000000000001ull,
+    0x4e20000000000000ull, 0x0000000000000001ull,
+    0x7d00000000000000ull, 0x0000000000000001ull,
+    0x6400000000000000ull, 0x0000000000000001ull,
+    0x5000000000000000ull, 0x0000000000000001ull,
+    0x4000000000000000ull, 0x0000000000000001ull,
+    0x6666666666666666ull, 0x3333333333333334ull,
+    0x51eb851eb851eb85ull, 0x0f5c28f5c28f5c29ull,
+    0x4189374bc6a7ef9dull, 0x5916872b020c49bbull,
+    0x68db8bac710cb295ull, 0x74f0d844d013a92bull,
+    0x53e2d6238da3c211ull, 0x43f3e0370cdc8755ull,
+    0x431bde82d7b634daull, 0x698fe69270b06c44ull,
+    0x6b5fca6af2bd215eull, 0x0f4ca41d811a46d4ull,
+    0x55e63b88c230e77eull, 0x3f70834acdae9f10ull,
+    0x44b82fa09b5a52cbull, 0x4c5a02a23e254c0dull,
+    0x6df37f675ef6eadfull, 0x2d5cd10396a21347ull,
+    0x57f5ff85e592557full, 0x3de3da69454e75d3ull,
+    0x465e6604b7a84465ull, 0x7e4fe1edd10b9175ull,
+    0x709709a125da0709ull, 0x4a19697c81ac1befull,
+    0x5a126e1a84ae6c07ull, 0x54e1213067bce326ull,
+    0x480ebe7b9d58566cull, 0x43e74dc052fd8285ull,
+    0x734aca5f6226f0adull, 0x530baf9a1e626a6dull,
+    0x5c3bd5191b525a24ull, 0x426fbfae7eb521f1ull,
+    0x49c97747490eae83ull, 0x4ebfcc8b9890e7f4ull,
+    0x760f253edb4ab0d2ull, 0x4acc7a78f41b0cbaull,
+    0x5e72843249088d75ull, 0x223d2ec729af3d62ull,
+    0x4b8ed0283a6d3df7ull, 0x34fdbf05baf29781ull,
+    0x78e480405d7b9658ull, 0x54c931a2c4b758cfull,
+    0x60b6cd004ac94513ull, 0x5d6dc14f03c5e0a5ull,
+    0x4d5f0a66a23a9da9ull, 0x31249aa59c9e4d51ull,
+    0x7bcb43d769f762a8ull, 0x4ea0f76f60fd4882ull,
+    0x63090312bb2c4eedull, 0x254d92bf80caa068ull,
+    0x4f3a68dbc8f03f24ull, 0x1dd7a89933d54d20ull,
+    0x7ec3daf941806506ull, 0x62f2a75b86221500ull,
+    0x65697bfa9acd1d9full, 0x025bb91604e810cdull,
+    0x51212ffbaf0a7e18ull, 0x684960de6a5340a4ull,
+    0x40e7599625a1fe7aull, 0x203ab3e521dc33b6ull,
+    0x67d88f56a29cca5dull, 0x19f7863b696052bdull,
+    0x5313a5dee87d6eb0ull, 0x7b2c6b62bab37564ull,
+    0x42761e4bed31255aull, 0x2f56bc4efbc2c450ull,
+    0x6a5696dfe1e83bc3ull, 0x655793b192d13a1aull,
+    0x5512124cb4b9c969ull, 0x377942f475742e7bull,
+    0x440e750a2a2e3abaull, 0x5f9435905df68b96ull,
+    0x6ce3ee76a9e3912aull, 0x65b9ef4d63241289ull,
+    0x571cbec554b60dbbull, 0x6afb25d782834207ull,
+    0x45b0989ddd5e7163ull, 0x08c8eb12cecf6806ull,
+    0x6f80f42fc8971bd1ull, 0x5adb11b7b14bd9a3ull,
+    0x5933f68ca078e30eull, 0x157c0e2c8dd647b5ull,
+    0x475cc53d4d2d8271ull, 0x5dfcd823a4ab6c91ull,
+    0x722e086215159d82ull, 0x632e269f6ddf141bull,
+    0x5b5806b4ddaae468ull, 0x4f581ee5f17f4349ull,
+    0x49133890b1558386ull, 0x72ace584c1329c3bull,
+    0x74eb8db44eef38d7ull, 0x6aae3c079b842d2aull,
+    0x5d893e29d8bf60acull, 0x5558300616035755ull,
+    0x4ad431bb13cc4d56ull, 0x7779c004de6912abull,
+    0x77b9e92b52e07bbeull, 0x258f99a163db5111ull,
+    0x5fc7edbc424d2fcbull, 0x37a614811caf740dull,
+    0x4c9ff163683dbfd5ull, 0x7951aa00e3bf900bull,
+    0x7a998238a6c932efull, 0x754f7667d2cc19abull,
+    0x6214682d523a8f26ull, 0x2aa5f8530f09ae22ull,
+    0x4e76b9bddb620c1eull, 0x55519375a5a1581bull,
+    0x7d8ac2c95f034697ull, 0x3bb5b8bc3c3559c5ull,
+    0x646f023ab2690545ull, 0x7c9160969691149eull,
+    0x5058ce955b87376bull, 0x16dab3ababa743b2ull,
+    0x40470baaaf9f5f88ull, 0x78aef622efb902f5ull,
+    0x66d812aab29898dbull, 0x0de4bd04b2c19e54ull,
+    0x524675555bad4715ull, 0x57ea30d08f014b76ull,
+    0x41d1f7777c8a9f44ull, 0x4654f3da0c01092cull,
+    0x694ff258c7443207ull, 0x23bb1fc346680eacull,
+    0x543ff513d29cf4d2ull, 0x4fc8e635d1ecd88aull,
+    0x43665da9754a5d75ull, 0x263a51c4a7f0ad3bull,
+    0x6bd6fc425543c8bbull, 0x56c3b607731aaec4ull,
+    0x5645969b77696d62ull, 0x789c919f8f488bd0ull,
+    0x4504787c5f878ab5ull, 0x46e3a7b2d906d640ull,
+    0x6e6d8d93cc0c1122ull, 0x3e390c515b3e239aull,
+    0x5857a4763cd6741bull, 0x4b60d6a77c31b615ull,
+    0x46ac8391ca4529afull, 0x55e7121f968e2b44ull,
+    0x711405b6106ea919ull, 0x0971b698f0e3786dull,
+    0x5a766af80d255414ull, 0x078e2bad8d82c6bdull,
+    0x485ebbf9a41ddcdcull, 0x6c71bc8ad79bd231ull,
+    0x73cac65c39c96161ull, 0x2d82c7448c2c8382ull,
+    0x5ca23849c7d44de7ull, 0x3e023903a356cf9bull,
+    0x4a1b603b06437185ull, 0x7e682d9c82abd949ull,
+    0x76923391a39f1c09ull, 0x4a4048fa6aac8edbull,
+    0x5edb5c7482e5b007ull, 0x55003a61eef07249ull,
+    0x4be2b05d35848cd2ull, 0x773361e7f259f507ull,
+    0x796ab3c855a0e151ull, 0x3eb89ca6508fee71ull,
+    0x6122296d114d810dull, 0x7efa16eb73a6585bull,
+    0x4db4edf0daa4673eull, 0x3261abef8fb846afull,
+    0x7c54afe7c43a3ecaull, 0x1d691318e5f3a44bull,
+    0x6376f31fd02e98a1ull, 0x64540f471e5c836full,
+    0x4f925c1973587a1bull, 0x0376729f4b7d35f3ull,
+    0x7f50935bebc0c35eull, 0x38bd84321261efebull,
+    0x65da0f7cbc9a35e5ull, 0x13cad0280eb4bfefull,
+    0x517b3f96fd482b1dull, 0x5ca240200bc3ccbfull,
+    0x412f66126439bc17ull, 0x63b50019a3030a33ull,
+    0x684bd683d38f9359ull, 0x1f88002904d1a9eaull,
+    0x536fdecfdc72dc47ull, 0x32d3335403daee55ull,
+    0x42bfe57316c249d2ull, 0x5bdc291003158b77ull,
+    0x6acca251be03a951ull, 0x12f9db4cd1bc1258ull,
+    0x557081dafe695440ull, 0x7594af70a7c9a847ull,
+    0x445a017bfebaa9cdull, 0x4476f2c0863aed06ull,
+    0x6d5ccf2ccac442e2ull, 0x3a57eacda3917b3cull,
+    0x577d728a3bd03581ull, 0x7b7988a482dac8fdull,
+    0x45fdf53b630cf79bull, 0x15fad3b6cf156d97ull,
+    0x6ffcbb923814bf5eull, 0x565e1f8ae4ef15beull,
+    0x5996fc74f9aa32b2ull, 0x11e4e608b725aaffull,
+    0x47abfd2a6154f55bull, 0x27ea51a0928488ccull,
+    0x72acc843ceee555eull, 0x7310829a84074146ull,
+    0x5bbd6d030bf1dde5ull, 0x42739baed005cdd2ull,
+    0x49645735a327e4b7ull, 0x4ec2e2f24004a4a8ull,
+    0x756d5855d1d96df2ull, 0x4ad16b1d333aa10cull,
+    0x5df11377db1457f5ull, 0x2241227dc2954da3ull,
+    0x4b2742c648dd132aull, 0x4e9a81fe35443e1cull,
+    0x783ed13d4161b844ull, 0x175d9cc9eed39694ull,
+    0x603240fdcde7c69cull, 0x7917b0a18bdc7876ull,
+    0x4cf500cb0b1fd217ull, 0x1412f3b46fe39392ull,
+    0x7b219ade7832e9beull, 0x535185ed7fd285b6ull,
+    0x628148b1f9c25498ull, 0x42a79e57997537c5ull,
+    0x4ecdd3c1949b76e0ull, 0x3552e512e12a9304ull,
+    0x7e161f9c20f8be33ull, 0x6eeb081e3510eb39ull,
+    0x64de7fb01a609829ull, 0x3f226ce4f740bc2eull,
+    0x50b1ffc0151a1354ull, 0x3281f0b72c33c9beull,
+    0x408e66334414dc43ull, 0x42018d5f568fd498ull,
+    0x674a3d1ed354939full, 0x1ccf48988a7fba8dull,
+    0x52a1ca7f0f76dc7full, 0x30a5d3ad3b99620bull,
+    0x421b0865a5f8b065ull, 0x73b7dc8a96144e6full,
+    0x69c4da3c3cc11a3cull, 0x52bfc7442353b0b1ull,
+    0x549d7b6363cdae96ull, 0x756639034f7626f4ull,
+    0x43b12f82b63e2545ull, 0x4451c735d92b525dull,
+    0x6c4eb26abd303ba2ull, 0x3a1c71efc1deea2eull,
+    0x56a55b889759c94eull, 0x61b05b2634b254f2ull,
+    0x45511606df7b0772ull, 0x1af37c1e908eaa5bull,
+    0x6ee8233e325e7250ull, 0x2b1f2cfdb41776f8ull,
+    0x58b9b5cb5b7ec1d9ull, 0x6f4c23fe29ac5f2dull,
+    0x46faf7d5e2cbce47ull, 0x72a34ffe87bd18f1ull,
+    0x71918c896adfb073ull, 0x04387ffda5fb5b1bull,
+    0x5adad6d4557fc05cull, 0x0360666484c915afull,
+    0x48af1243779966b0ull, 0x02b3851d3707448cull,
+    0x744b506bf28f0ab3ull, 0x1dec082ebe720746ull,
+    0x5d090d2328726ef5ull, 0x64bcd358985b3905ull,
+    0x4a6da41c205b8bf7ull, 0x6a30a913ad15c738ull,
+    0x7715d36033c5acbfull, 0x5d1aa81f7b560b8cull,
+    0x5f44a919c3048a32ull, 0x7daeece5fc44d609ull,
+    0x4c36edae359d3b5bull, 0x7e258a51969d7808ull,
+    0x79f17c49ef61f893ull, 0x16a276e8f0fbf33full,
+    0x618dfd07f2b4c6dcull, 0x121b9253f3fcc299ull,
+    0x4e0b30d328909f16ull, 0x41afa84329970214ull,
+    0x7cdeb4850db431bdull, 0x4f7f739ea8f19cedull,
+    0x63e55d373e29c164ull, 0x3f99294bba5ae3f1ull,
+    0x4feab0f8fe87cde9ull, 0x7fadbaa2fb7be98dull,
+    0x7fdde7f4ca72e30full, 0x7f7c5dd1925fdc15ull,
+    0x664b1ff7085be8d9ull, 0x4c637e4141e649abull,
+    0x51d5b32c06afed7aull, 0x704f983434b83aefull,
+    0x4177c2899ef32462ull, 0x26a6135cf6f9c8bfull,
+    0x68bf9da8fe51d3d0ull, 0x3dd685618b294132ull,
+    0x53cc7e20cb74a973ull, 0x4b12044e08edcdc2ull,
+    0x4309fe80a2c3bac2ull, 0x6f419d0b3a57d7ceull,
+    0x6b4330cdd1392ad1ull, 0x320294dec3bfbfb0ull,
+    0x55cf5a3e40fa88a7ull, 0x419baa4bcfcc995aull,
+    0x44a5e1cb672ed3b9ull, 0x1ae2eea30ca3ade1ull,
+    0x6dd636123eb152c1ull, 0x77d17dd1add2afcfull,
+    0x57de91a832277567ull, 0x797464a7be42263full,
+    0x464ba7b9c1b92ab9ull, 0x4790508631ce84ffull,
+    0x70790c5c6928445cull, 0x0c1a1a704fb0d4ccull,
+    0x59fa7049edb9d049ull, 0x567b4859d95a43d6ull,
+    0x47fb8d07f161736eull, 0x11fc39e17aae9cabull,
+    0x732c14d98235857dull, 0x032d2968c44a9445ull,
+    0x5c2343e134f79dfdull, 0x4f575453d03ba9d1ull,
+    0x49b5cfe75d92e4caull, 0x72ac4376402fbb0eull,
+    0x75efb30bc8eb07abull, 0x0446d256cd192b49ull,
+    0x5e595c096d88d2efull, 0x1d0575123dadbc3aull,
+    0x4b7ab0078ad3dbf2ull, 0x4a6ac40e97be302full,
+    0x78c44cd8de1fc650ull, 0x771139b0f2c9e6b1ull,
+    0x609d0a4718196b73ull, 0x78da948d8f07ebc1ull,
+    0x4d4a6e9f467abc5cull, 0x60aedd3e0c065634ull,
+    0x7baa4a9870c46094ull, 0x344afb9679a3bd20ull,
+    0x62eea2138d69e6ddull, 0x103bfc78614fca80ull,
+    0x4f254e760abb1f17ull, 0x26966393810ca200ull,
+    0x7ea21723445e9825ull, 0x2423d2859b476999ull,
+    0x654e78e9037ee01dull, 0x69b642047c392148ull,
+    0x510b93ed9c658017ull, 0x6e2b680396941aa0ull,
+    0x40d60ff149eaccdfull, 0x71bc53361210154dull,
+    0x67bce64edcaae166ull, 0x1c6085235019bbaeull,
+    0x52fd850be3bbe784ull, 0x7d1a041c40149625ull,
+    0x42646a6fe9631f9dull, 0x4a7b367d0010781dull,
+    0x6a3a43e642383295ull, 0x5d91f0c8001a59c8ull,
+    0x54fb698501c68edeull, 0x17a7f3d3334847d4ull,
+    0x43fc546a67d20be4ull, 0x79532975c2a03976ull,
+    0x6cc6ed770c83463bull, 0x0eeb75893766c256ull,
+    0x57058ac5a39c382full, 0x25892ad42c523512ull,
+    0x459e089e1c7cf9bfull, 0x37a0ef102374f742ull,
+    0x6f6340fcfa618f98ull, 0x59017e8038bb2536ull,
+    0x591c33fd951ad946ull, 0x7a67986693c8ea91ull,
+    0x4749c33144157a9full, 0x151fad1edca0bba8ull,
+    0x720f9eb539bbf765ull, 0x0832ae97c76792a5ull,
+    0x5b3fb22a94965f84ull, 0x068ef21305ec7551ull,
+    0x48ffc1bbaa11e603ull, 0x1ed8c1a8d189f774ull,
+    0x74cc692c434fd66bull, 0x4af4690e1c0ff253ull,
+    0x5d705423690cab89ull, 0x225d20d816732843ull,
+    0x4ac0434f873d5607ull, 0x35174d79ab8f5369ull,
+    0x779a054c0b955672ull, 0x21bee25c45b21f0eull,
+    0x5fae6aa33c77785bull, 0x3498b5169e2818d8ull,
+    0x4c8b888296c5f9e2ull, 0x5d46f7454b534713ull,
+    0x7a78da6a8ad65c9dull, 0x7ba4bed545520b52ull,
+    0x61fa48553bdeb07eull, 0x2fb6ff110441a2a8ull,
+    0x4e61d37763188d31ull, 0x72f8cc0d9d014eedull,
+    0x7d6952589e8daeb6ull, 0x1e5ae015c80217e1ull,
+    0x645441e07ed7bef8ull, 0x1848b344a001acb4ull,
+    0x504367e6cbdfcbf9ull, 0x603a2903b3348a2aull,
+    0x4035ecb8a3196ffbull, 0x002e873628f6d4eeull,
+    0x66bcadf43828b32bull, 0x19e40b89db2487e3ull,
+    0x52308b29c686f5bcull, 0x14b66fa17c1d3983ull,
+    0x41c06f549ed25e30ull, 0x1091f2e7967dc79cull,
+    0x6933e554315096b3ull, 0x341cb7d8f0c93f5full,
+    0x542984435aa6def5ull, 0x767d5fe0c0a0ff80ull,
+    0x435469cf7bb8b25eull, 0x2b977fe70080cc66ull,
+    0x6bba42e592c11d63ull, 0x5f58cca4cd9ae0a3ull,
+    0x562e9beadbcdb11cull, 0x4c470a1d7148b3b6ull,
+    0x44f216557ca48db0ull, 0x3d05a1b1276d5c92ull,
+    0x6e5023bbfaa0e2b3ull, 0x7b3c35e83f1560e9ull,
+    0x58401c96621a4ef6ull, 0x2f635e5365aab3edull,
+    0x4699b0784e7b725eull, 0x591c4b75eaeef658ull,
+    0x70f5e726e3f8b6fdull, 0x74fa125644b18a26ull,
+    0x5a5e5285832d5f31ull, 0x43fb41de9d5ad4ebull,
+    0x484b75379c244c27ull, 0x4ffc34b2177bdd89ull,
+    0x73abeebf603a1372ull, 0x4cc6bab68bf96274ull,
+    0x5c898bcc4cfb42c2ull, 0x0a38955ed6611b90ull,
+    0x4a07a309d72f689bull, 0x21c6dde5784dafa7ull,
+    0x76729e762518a75eull, 0x693e2fd58d49190bull,
+    0x5ec2185e8413b918ull, 0x5431bfde0aa0e0d5ull,
+    0x4bce79e536762dadull, 0x29c1664b3bb3e711ull,
+    0x794a5ca1f0bd15e2ull, 0x0f9bd6dec5eca4e8ull,
+    0x61084a1b26fdab1bull, 0x2616457f04bd50baull,
+    0x4da03b48ebfe227cull, 0x1e783798d09773c8ull,
+    0x7c33920e46636a60ull, 0x30c058f480f252d9ull,
+    0x635c74d8384f884dull, 0x0d66ad9067284247ull,
+    0x4f7d2a469372d370ull, 0x711ef14052869b6cull,
+    0x7f2eaa0a85848581ull, 0x34fe4ecd50d75f14ull,
+    0x65beee6ed136d134ull, 0x2a650bd773df7f43ull,
+    0x51658b8bda9240f6ull, 0x551da312c319329cull,
+    0x411e093caedb672bull, 0x5db14f4235adc217ull,
+    0x68300ec77e2bd845ull, 0x7c4ee536bc49368aull,
+    0x5359a56c64efe037ull, 0x7d0bea92303a9208ull,
+    0x42ae1df050bfe693ull, 0x173cbba8269541a0ull,
+    0x6ab02fe6e79970ebull, 0x3ec792a6a422029aull,
+    0x5559bfebec7ac0bcull, 0x3239421ee9b4cee1ull,
+    0x4447ccbcbd2f0096ull, 0x5b6101b25490a581ull,
+    0x6d3fadfac84b3424ull, 0x2bce691d541aa268ull,
+    0x576624c8a03c29b6ull, 0x563eba7ddce21b87ull,
+    0x45eb50a08030215eull, 0x78322ecb171b4939ull,
+    0x6fdee76733803564ull, 0x59e9e47824f87527ull,
+    0x597f1f85c2ccf783ull, 0x6187e9f9b72d2a86ull,
+    0x4798e6049bd72c69ull, 0x346cbb2e2c242205ull,
+    0x728e3cd42c8b7a42ull, 0x20adf849e039d007ull,
+    0x5ba4fd768a092e9bull, 0x33be603b19c7d99full,
+    0x4950cac53b3a8bafull, 0x42feb3627b0647b3ull,
+    0x754e113b91f745e5ull, 0x5197856a5e7072b8ull,
+    0x5dd80dc941929e51ull, 0x27ac6abb7ec05bc6ull,
+    0x4b133e3a9adbb1daull, 0x52f05562cbcd1638ull,
+    0x781ec9f75e2c4fc4ull, 0x1e4d556adfae89f3ull,
+    0x6018a192b1bd0c9cull, 0x7ea444557fbed4c3ull,
+    0x4ce0814227ca707dull, 0x4bb69d1132ff109cull,
+    0x7b00ced03faa4d95ull, 0x5f8a94e851981a93ull,
+    0x62670bd9cc883e11ull, 0x32d543ed0e134875ull,
+    0x4eb8d647d6d364daull, 0x5bddcff0d80f6d2bull,
+    0x7df48a0c8aebd491ull, 0x12fc7fe7c018aeabull,
+    0x64c3a1a3a25643a7ull, 0x28c9ffec99ad5889ull,
+    0x509c814fb511cfb9ull, 0x0707fff07af113a1ull,
+    0x407d343fc40e3fc7ull, 0x1f39998d2f2742e7ull,
+    0x672eb9ffa016cc71ull, 0x7ec28f484b7204a4ull,
+    0x528bc7ffb345705bull, 0x189ba5d36f8e6a1dull,
+    0x42096ccc8f6ac048ull, 0x7a161e42bfa521b1ull,
+    0x69a8ae1418aacd41ull, 0x435696d132a1cf81ull,
+    0x5486f1a9ad557101ull, 0x1c454574288172ceull,
+    0x439f27baf1112734ull, 0x169dd129ba0128a5ull,
+    0x6c31d92b1b4ea520ull, 0x242fb50f9001daa1ull,
+    0x568e4755af721db3ull, 0x368c90d940017bb4ull,
+    0x453e9f77bf8e7e29ull, 0x120a0d7a999ac95dull,
+    0x6eca98bf98e3fd0eull, 0x50101590f5c47561ull,
+    0x58a213cc7a4ffda5ull, 0x26734473f7d05de8ull,
+    0x46e80fd6c83ffe1dull, 0x6b8f69f65fd9e4b9ull,
+    0x71734c8ad9fffcfcull, 0x45b24323cc8fd45cull,
+    0x5ac2a3a247fffd96ull, 0x6af502830a0ca9e3ull,
+    0x489bb61b6ccccadfull, 0x08c402026e7087e9ull,
+    0x742c569247ae1164ull, 0x746cd003e3e73fdbull,
+    0x5cf04541d2f1a783ull, 0x76bd73364fec3315ull,
+    0x4a59d101758e1f9cull, 0x5efdf5c50cbcf5abull,
+    0x76f61b3588e365c7ull, 0x4b2fefa1adfb22abull,
+    0x5f2b48f7a0b5eb06ull, 0x08f3261af195b555ull,
+    0x4c22a0c61a2b226bull, 0x20c284e25ade2aabull,
+    0x79d1013cf6ab6a45ull, 0x1ad0d49d5e304444ull,
+    0x617400fd9222bb6aull, 0x48a7107de4f369d0ull,
+    0x4df6673141b562bbull, 0x53b8d9fe50c2bb0dull,
+    0x7cbd71e869223792ull, 0x52c15cca1ad12b48ull,
+    0x63cac186ba81c60eull, 0x75677d6e7bda8906ull,
+    0x4fd5679efb9b04d8ull, 0x5dec645863153a6cull,
+    0x7fbbd8fe5f5e6e27ull, 0x497a3a2704eec3dfull,
+};
+
+// floor(log10(2^q)), floor(log10(3/4 2^q)) and floor(log2(10^e)) for the exponents of doubles
+static inline int fsv_flog10_pow2(int q)               { return (int)(((int64_t)q*661971961083ll) >> 41); }
+static inline int fsv_flog10_three_quarters_pow2(int q) { return (int)(((int64_t)q*661971961083ll - 274743187321ll) >> 41); }
+static inline int fsv_flog2_pow10(int e)               { return (int)(((int64_t)e*913124641741ll) >> 38); }
+
+// Round to odd of g*cp / 2^127
+static inline uint64_t fsv_schubfach_rop(uint64_t g1, uint64_t g0, uint64_t cp) {
+    const uint64_t mask63 = 0x7FFFFFFFFFFFFFFFull;
+    uint64_t x0 = g0, x1 = cp;
+    fsv_hash_mum(&x0, &x1);
+    uint64_t y0 = g1, y1 = cp;
+    fsv_hash_mum(&y0, &y1);
+    uint64_t z = (y0 >> 1) + x1;
+    uint64_t vbp = y1 + (z >> 63);
+    return vbp | (((z & mask63) + mask63) >> 63);
+}
+
+// c 2^q is between the two closest decimals, pick the shortest one: value = *f 10^*e
+static void fsv_schubfach(int q, uint64_t c, int dk, uint64_t *f, int *e) {
+    const uint64_t out = c & 1;
+    const uint64_t cb  = c << 2;
+    const uint64_t cbr = cb + 2;
+    uint64_t cbl;
+    int k;
+    if (c != ((uint64_t)1 << 52) || q == -1074) {
+        // Regular spacing
+        cbl = cb - 2;
+        k = fsv_flog10_pow2(q);
+    } else {
+        // Irregular spacing, the next smaller double is closer than the next larger one
+        cbl = cb - 1;
+        k = fsv_flog10_three_quarters_pow2(q);
+    }
+    const int h = q + fsv_flog2_pow10(-k) + 2;
+    const uint64_t g1 = fsv_schubfach_g[2*(k - FSV_SCHUBFACH_K_MIN)];
+    const uint64_t g0 = fsv_schubfach_g[2*(k - FSV_SCHUBFACH_K_MIN) + 1];
+
+    const uint64_t vb  = fsv_schubfach_rop(g1, g0, cb << h);
+    const uint64_t vbl = fsv_schubfach_rop(g1, g0, cbl << h);
+    const uint64_t vbr = fsv_schubfach_rop(g1, g0, cbr << h);
+
+    const uint64_t s = vb >> 2;
+    // The reference only does this for s >= 100 because Java wants at least 2 digits
+    {
+        // One digit less if exactly one of the two multiples of 10 around s is in the interval
+        const uint64_t sp10 = s/10*10;
+        const uint64_t tp10 = sp10 + 10;
+        const bool upin = vbl + out <= sp10 << 2;
+        const bool wpin = (tp10 << 2) + out <= vbr;
+        if (upin != wpin) {
+            *f = upin ? sp10 : tp10;
+            *e = k + dk;
+            return;
+        }
+    }
+
+    const uint64_t t = s + 1;
+    const bool uin = vbl + out <= s << 2;
+    const bool win = (t << 2) + out <= vbr;
+    *e = k + dk;
+    if (uin != win) {
+        *f = uin ? s : t;
+        return;
+    }
+    // Both are in the interval, the closest one wins and ties go to even
+    const int64_t cmp = (int64_t)(vb - ((s + t) << 1));
+    *f = (cmp < 0 || (cmp == 0 && (s & 1) == 0)) ? s : t;
+}
+
+// Write a finite non zero double as `f 10^e` with the fewest digits
+static void fsv_f64_to_decimal(uint64_t bits, uint64_t *f, int *e) {
+    const uint64_t t  = bits & (((uint64_t)1 << 52) - 1);
+    const int      bq = (int)((bits >> 52) & 0x7FF);
+    if (bq != 0) {
+        const int mq = 1075 - bq;
+        const uint64_t c = ((uint64_t)1 << 52) | t;
+        // Small integers are exact
+        if (0 < mq && mq < 53 && ((c >> mq) << mq) == c) {
+            *f = c >> mq;
+            *e = 0;
+        } else {
+            fsv_schubfach(-mq, c, 0, f, e);
+        }
+    } else {
+        // Subnormal. Unlike the Java reference the 2 smallest ones are not given an
+        // extra digit, "5e-324" is shorter than "4.9e-324" and still reads back the same
+        fsv_schubfach(-1074, t, 0, f, e);
+    }
+    while (*f % 10 == 0) {
+        *f /= 10;
+        *e += 1;
+    }
+}
+
+// Enough for "-" + 17 digits + "." + "e-324"
+#define FSV_F64_MAX_CHARS (32)
+
+// `%f` prints every digit of an integer instead of the shortest ones padded
+// with zeros, which only differs for c 2^q above 2^53. Return how many digits
+static size_t fsv_write_exact_integer(char *dest, uint64_t c, int q) {
+    uint64_t lo = c << q, hi = c >> (64 - q);  // 0 < q < 64
+    uint32_t limbs[4] = { (uint32_t)lo, (uint32_t)(lo >> 32), (uint32_t)hi, (uint32_t)(hi >> 32) };
+    char reversed[40];
+    size_t n = 0;
+    while (limbs[0] | limbs[1] | limbs[2] | limbs[3]) {
+        uint64_t remainder = 0;
+        for (int i = 3; i >= 0; --i) {
+            uint64_t current = (remainder << 32) | limbs[i];
+            limbs[i]  = (uint32_t)(current / 10);
+            remainder = current % 10;
+        }
+        reversed[n++] = (char)('0' + remainder);
+    }
+    for (size_t i = 0; i < n; ++i) dest[i] = reversed[n - 1 - i];
+    return n;
+}
+
+static size_t fsv_format_f64(char *out, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    size_t n = 0;
+    if (bits >> 63) out[n++] = '-';
+    const uint64_t magnitude = bits & 0x7FFFFFFFFFFFFFFFull;
+    if (magnitude >= 0x7FF0000000000000ull) {
+        memcpy(out + n, magnitude == 0x7FF0000000000000ull ? "inf" : "nan", 3);
+        return n + 3;
+    }
+    if (magnitude == 0) {
+        out[n] = '0';
+        return n + 1;
+    }
+
+    uint64_t f = 0;
+    int e = 0;
+    fsv_f64_to_decimal(magnitude, &f, &e);
+    const int digits = (int)fsv_count_digits(f);
+    const int exponent = e + digits - 1;  // Of the first digit
+
+    // Same rule as `std::to_chars`: the shortest of %f and %e, %f on a tie
+    const int abs_exponent = exponent < 0 ? -exponent : exponent;
+    const int sci_length   = digits + (digits > 1) + 2 + (abs_exponent >= 100 ? 3 : 2);
+    int fixed_length;
+    if (e >= 0)             fixed_length = digits + e;
+    else if (exponent >= 0) fixed_length = digits + 1;
+    else                    fixed_length = digits + 1 - exponent;
+
+    char *dest = out + n;
+    if (fixed_length <= sci_length) {
+        const int q = (int)(magnitude >> 52) - 1075;
+        if (e > 0 && q > 0) {
+            return n + fsv_write_exact_integer(dest, (magnitude & (((uint64_t)1 << 52) - 1)) | ((uint64_t)1 << 52), q);
+        } else if (e >= 0) {
+            fsv_write_digits(dest + digits, f);
+            memset(dest + digits, '0', (size_t)e);
+        } else if (exponent >= 0) {
+            // Dot inside the digits
+            fsv_write_digits(dest + digits + 1, f);
+            memmove(dest, dest + 1, (size_t)exponent + 1);
+            dest[exponent + 1] = '.';
+        } else {
+            dest[0] = '0';
+            dest[1] = '.';
+            memset(dest + 2, '0', (size_t)(-exponent - 1));
+            fsv_write_digits(dest + fixed_length, f);
+        }
+        return n + (size_t)fixed_length;
+    }
+
+    fsv_write_digits(dest + digits + 1, f);
+    dest[0] = dest[1];
+    if (digits > 1) dest[1] = '.';
+    char *end = dest + digits + (digits > 1);
+    *end++ = 'e';
+    *end++ = exponent < 0 ? '-' : '+';
+    if (abs_exponent >= 100) *end++ = (char)('0' + abs_exponent/100);
+    *end++ = fsv_digit_pairs[(abs_exponent % 100)*2];
+    *end++ = fsv_digit_pairs[(abs_exponent % 100)*2 + 1];
+    return n + (size_t)sci_length;
+}
+
+FSV_DEF void fsb_append_f64(fsb_t *sb, double value) {
+    char *dest = fsb_spare(sb, FSV_F64_MAX_CHARS);
+    size_t n = fsv_format_f64(dest, value);
+    dest[n] = '\0';
+    sb->length += n;
+}
+
+FSV_DEF void fsb_free(fsb_t *sb) {
+    fda_free_a(sb);
+}
+
+FSV_DEF void ffp_free(ffp_t *fp) {
+    if (fp->datas == NULL) return;
+    ffe_t *fe = NULL;
+    for (size_t i = 0; i < fp->length; ++i) {
+        fe = &fp->datas[i];
+        fsb_free(&fe->name);
+        fe->is_dir = false;
+    }
+    fda_free_a(fp);
+}
+
+FSV_DEF fsv_t fsv_from_sb(const fsb_t sb) {
+    return fsv_from_parts(sb.datas, sb.length);
+}
+
+FSV_DEF fsb_t fsb_from_sv(const fsv_t sv) {
+    return fsb_from_sv_with(sv, NULL);
+}
+
+FSV_DEF fsb_t fsb_from_sv_with(const fsv_t sv, const fsv_allocator_t *allocator) {
+    fsb_t ret = {};
+    ret.allocator = allocator;
+    size_t length = sv.datas == NULL ? 0 : sv.length;
+    fda_reserve_a(&ret, length + 1);
+    if (length > 0) memcpy(ret.datas, sv.datas, length);
+    ret.length = length;
+    // Set null-terminated for passing into
+    // `fsb_read_entire_dir` or `fsb_read_entire_file`
+    // while doesn't make `fsv_eq` produce wrong result
+    ret.datas[length] = '\0';
+    return ret;
+}
+
+static inline bool fssb_on_heap(const fssb_t *sb) {
+    return sb->capacity > FSSB_INLINE_CAPACITY;
+}
+
+static inline char *fssb_datas(fssb_t *sb) {
+    return fssb_on_heap(sb) ? sb->u.heap : sb->u.inline_datas;
+}
+
+FSV_DEF fssb_t fssb_from_sv(fsv_t sv) {
+    fssb_t ret = {};
+    fssb_append_sv(&ret, sv);
+    return ret;
+}
+
+FSV_DEF void fssb_append_sv(fssb_t *sb, fsv_t sv) {
+    if (sv.datas == NULL) sv.length = 0;
+    size_t length = sb->length + sv.length;
+    if (length > FSSB_INLINE_CAPACITY && length + 1 > sb->capacity) {
+        // Spill to the heap, or grow it, geometrically
+        size_t capacity = sb->capacity > FSSB_INLINE_CAPACITY ? sb->capacity : 2*(FSSB_INLINE_CAPACITY + 1);
+        while (capacity < length + 1) capacity *= 2;
+        char *heap = (char*) FSV_REALLOC(fssb_on_heap(sb) ? sb->u.heap : NULL, capacity);
+        FSV_ASSERT(heap != NULL && "Out of Memory!!!");
+        if (!fssb_on_heap(sb)) memcpy(heap, sb->u.inline_datas, sb->length);
+        sb->u.heap   = heap;
+        sb->capacity = capacity;
+    }
+    char *datas = fssb_datas(sb);
+    if (sv.length > 0) memcpy(datas + sb->length, sv.datas, sv.length);
+    sb->length = length;
+    datas[length] = '\0';
+}
+
+FSV_DEF const char *fssb_cstr(const fssb_t *sb) {
+    return fssb_on_heap(sb) ? sb->u.heap : sb->u.inline_datas;
+}
+
+FSV_DEF fsv_t fsv_from_fssb(const fssb_t *sb) {
+    return fsv_from_parts(fssb_cstr(sb), sb->length);
+}
+
+FSV_DEF void fssb_free(fssb_t *sb) {
+    if (fssb_on_heap(sb)) FSV_FREE(sb->u.heap);
+    sb->length   = 0;
+    sb->capacity = 0;
+    sb->u.inline_datas[0] = '\0';
+}
+
+///////////////////////// End of String Builder /////////////////////////
+
+///////////////////////// Tokenizer /////////////////////////
+
+#define FSV_TOKENIZER_BLOCK (64)
+
+// Append the offset of every bit set in `mask`
+static inline void fsv_tokenizer_push(fsv_tokenizer_t *tokenizer, size_t base, uint64_t mask) {
+    if (mask == 0) return;
+    // Make room for the worst case so the loop below never checks capacity
+    if (tokenizer->size + FSV_TOKENIZER_BLOCK > tokenizer->capacity) {
+        fda_realloc(tokenizer, FSV_TOKENIZER_BLOCK);
+    }
+    size_t *offsets = tokenizer->datas + tokenizer->size;
+    size_t count = 0;
+    while (mask != 0) {
+        offsets[count++] = base + fsv_ctz64(mask);
+        mask &= mask - 1;
+    }
+    tokenizer->size += count;
+}
+
+// Every `fsv_tokenizer_scan_*` scans whole blocks from `base` and returns where it stopped
+static size_t fsv_tokenizer_scan_scalar(fsv_tokenizer_t *tokenizer, size_t base, const fsv_delims_t *delims) {
+    fsv_t source = tokenizer->source;
+    for (; base < source.length; base += FSV_TOKENIZER_BLOCK) {
+        size_t length = source.length - base;
+        if (length > FSV_TOKENIZER_BLOCK) length = FSV_TOKENIZER_BLOCK;
+        uint64_t mask = 0;
+        for (size_t i = 0; i < length; ++i) {
+            mask |= (uint64_t)delims->table[(uint8_t)source.datas[base + i]] << i;
+        }
+        fsv_tokenizer_push(tokenizer, base, mask);
+    }
+    return base;
+}
+
+#ifdef FSV_SIMD_X86
+
+FSV_TARGET("avx2")
+static size_t fsv_tokenizer_scan_avx2(fsv_tokenizer_t *tokenizer, size_t base, const fsv_delims_t *delims) {
+    const __m256i low  = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)delims->low));
+    const __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)delims->high));
+    fsv_t source = tokenizer->source;
+    for (; base + FSV_TOKENIZER_BLOCK <= source.length; base += FSV_TOKENIZER_BLOCK) {
+        uint64_t lo = fsv_match_any_avx2(_mm256_loadu_si256((const __m256i*)(source.datas + base)), low, high);
+        uint64_t hi = fsv_match_any_avx2(_mm256_loadu_si256((const __m256i*)(source.datas + base + 32)), low, high);
+        fsv_tokenizer_push(tokenizer, base, lo | (hi << 32));
+    }
+    return base;
+}
+
+FSV_TARGET("avx512f,avx512bw")
+static size_t fsv_tokenizer_scan_avx512(fsv_tokenizer_t *tokenizer, size_t base, const fsv_delims_t *delims) {
+    const __m512i low  = fsv_broadcast16_avx512(delims->low);
+    const __m512i high = fsv_broadcast16_avx512(delims->high);
+    fsv_t source = tokenizer->source;
+    for (; base + FSV_TOKENIZER_BLOCK <= source.length; base += FSV_TOKENIZER_BLOCK) {
+        __m512i block = _mm512_loadu_si512((const void*)(source.datas + base));
+        fsv_tokenizer_push(tokenizer, base, fsv_match_any_avx512(block, low, high));
+    }
+    return base;
+}
+
+#endif // FSV_SIMD_X86
+
+FSV_DEF size_t fsv_tokenizer_scan(fsv_tokenizer_t *tokenizer, fsv_t source, const fsv_delims_t *delims) {
+    size_t base = 0;
+    tokenizer->source = source;
+    tokenizer->size   = 0;
+    tokenizer->cursor = 0;
+
+    if (delims->vectorized) {
+        switch (fsv_simd_get()) {
+#ifdef FSV_SIMD_X86
+        case FSV_SIMD_AVX512: base = fsv_tokenizer_scan_avx512(tokenizer, base, delims); break;
+        case FSV_SIMD_AVX2:   base = fsv_tokenizer_scan_avx2(tokenizer, base, delims);   break;
+#endif // FSV_SIMD_X86
+        default: break;
+        }
+    }
+    fsv_tokenizer_scan_scalar(tokenizer, base, delims);
+    return tokenizer->size;
+}
+
+FSV_DEF bool fsv_tokenizer_next(fsv_tokenizer_t *tokenizer, fsv_t *out) {
+    if (tokenizer->cursor >= tokenizer->size) return false;
+    size_t start = tokenizer->cursor == 0 ? 0 : tokenizer->datas[tokenizer->cursor - 1] + 1;
+    size_t end   = tokenizer->datas[tokenizer->cursor++];
+    *out = fsv_from_parts(tokenizer->source.datas + start, end - start);
+    return true;
+}
+
+FSV_DEF fsv_t fsv_tokenizer_rest(const fsv_tokenizer_t *tokenizer) {
+    size_t start = tokenizer->cursor == 0 ? 0 : tokenizer->datas[tokenizer->cursor - 1] + 1;
+    return fsv_slice(tokenizer->source, start, SIZE_MAX);
+}
+
+FSV_DEF void fsv_tokenizer_free(fsv_tokenizer_t *tokenizer) {
+    fda_free(tokenizer);
+    tokenizer->source = fsv_from_parts(NULL, 0);
+    tokenizer->cursor = 0;
+}
+
+#ifndef FSV_DISABLE_THREADS
+#    ifdef _WIN32
+#        include <windows.h>
+typedef HANDLE fsv_thread_t;
+typedef SRWLOCK fsv_mutex_t;
+#    else
+#        include <pthread.h>
+#        include <sched.h>
+#        include <unistd.h>
+typedef pthread_t fsv_thread_t;
+typedef pthread_mutex_t fsv_mutex_t;
+#    endif // _WIN32
+#else
+typedef int fsv_mutex_t;
+#endif // FSV_DISABLE_THREADS
+
+static inline void fsv_mutex_init(fsv_mutex_t *mutex) {
+#if defined(FSV_DISABLE_THREADS)
+    *mutex = 0;
+#elif defined(_WIN32)
+    InitializeSRWLock(mutex);
+#else
+    pthread_mutex_init(mutex, NULL);
+#endif // FSV_DISABLE_THREADS
+}
+
+static inline void fsv_mutex_lock(fsv_mutex_t *mutex) {
+#if defined(FSV_DISABLE_THREADS)
+    (void)mutex;
+#elif defined(_WIN32)
+    AcquireSRWLockExclusive(mutex);
+#else
+    pthread_mutex_lock(mutex);
+#endif // FSV_DISABLE_THREADS
+}
+
+static inline void fsv_mutex_unlock(fsv_mutex_t *mutex) {
+#if defined(FSV_DISABLE_THREADS)
+    (void)mutex;
+#elif defined(_WIN32)
+    ReleaseSRWLockExclusive(mutex);
+#else
+    pthread_mutex_unlock(mutex);
+#endif // FSV_DISABLE_THREADS
+}
+
+static inline void fsv_mutex_destroy(fsv_mutex_t *mutex) {
+#if defined(FSV_DISABLE_THREADS) || defined(_WIN32)
+    (void)mutex;
+#else
+    pthread_mutex_destroy(mutex);
+#endif // FSV_DISABLE_THREADS
+}
+
+// Partitions smaller than this are not worth a thread
+#define FSV_PARALLEL_MIN_PARTITION (64*1024)
+#define FSV_PARALLEL_MAX_THREADS   (64)
+
+FSV_DEF size_t fsv_cpu_count(void) {
+#if defined(FSV_DISABLE_THREADS)
+    return 1;
+#elif defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (size_t)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (size_t)count : 1;
+#endif // FSV_DISABLE_THREADS
+}
+
+typedef struct {
+    fsv_partitions_t   *partitions;
+    const fsv_delims_t *delims;
+    size_t              next;  // Next partition to scan, shared by every worker
+} fsv_parallel_job_t;
+
+static size_t fsv_parallel_take(fsv_parallel_job_t *job) {
+#if defined(FSV_DISABLE_THREADS)
+    return job->next++;
+#elif defined(_WIN32)
+    return (size_t)InterlockedExchangeAdd64((volatile LONG64*)&job->next, 1);
+#else
+    return __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED);
+#endif // FSV_DISABLE_THREADS
+}
+
+#ifdef _WIN32
+static DWORD WINAPI fsv_parallel_worker(LPVOID arg) {
+#else
+static void *fsv_parallel_worker(void *arg) {
+#endif // _WIN32
+    fsv_parallel_job_t *job = (fsv_parallel_job_t*) arg;
+    for (size_t i = fsv_parallel_take(job); i < job->partitions->size; i = fsv_parallel_take(job)) {
+        fsv_tokenizer_t *tokenizer = &job->partitions->datas[i];
+        fsv_tokenizer_scan(tokenizer, tokenizer->source, job->delims);
+    }
+    return 0;
+}
+
+FSV_DEF size_t fsv_split_parallel(fsv_t sv, const fsv_delims_t *delims, size_t thread_count, fsv_partitions_t *partitions) {
+    if (sv.datas == NULL) sv.length = 0;
+    if (thread_count == 0) thread_count = fsv_cpu_count();
+    if (thread_count > FSV_PARALLEL_MAX_THREADS) thread_count = FSV_PARALLEL_MAX_THREADS;
+    size_t count = sv.length / FSV_PARALLEL_MIN_PARTITION;
+    if (count > thread_count) count = thread_count;
+    if (count == 0) count = 1;
+
+    // Keep the tokenizers of the previous call around so their offsets can be reused
+    for (size_t i = count; i < partitions->size; ++i) fsv_tokenizer_free(&partitions->datas[i]);
+    if (partitions->size < count) {
+        fda_reserve(partitions, count);
+        memset(partitions->datas + partitions->size, 0, (count - partitions->size)*sizeof(*partitions->datas));
+    }
+    partitions->size = count;
+
+    // Move every evenly spaced cut right after the next delimiter so no token is split in half.
+    // A cut without any delimiter after it swallows the rest of the view
+    size_t start = 0;
+    for (size_t i = 0; i < count; ++i) {
+        size_t end = sv.length;
+        if (i + 1 < count) {
+            size_t cut = sv.length/count*(i + 1);
+            if (cut < start) cut = start;
+            end = cut + fsv_find_any(sv.datas + cut, sv.length - cut, delims);
+            if (end < sv.length) end += 1;
+        }
+        partitions->datas[i].source = fsv_slice(sv, start, end - start);
+        start = end;
+        if (end == sv.length) count = i + 1;
+    }
+    for (size_t i = count; i < partitions->size; ++i) fsv_tokenizer_free(&partitions->datas[i]);
+    partitions->size = count;
+
+    fsv_parallel_job_t job = { partitions, delims, 0 };
+#ifndef FSV_DISABLE_THREADS
+    size_t spawned = 0;
+    fsv_thread_t threads[FSV_PARALLEL_MAX_THREADS];
+    for (; spawned + 1 < count; ++spawned) {
+#    ifdef _WIN32
+        threads[spawned] = CreateThread(NULL, 0, fsv_parallel_worker, &job, 0, NULL);
+        if (threads[spawned] == NULL) break;
+#    else
+        if (pthread_create(&threads[spawned], NULL, fsv_parallel_worker, &job) != 0) break;
+#    endif // _WIN32
+    }
+#endif // FSV_DISABLE_THREADS
+
+    // The calling thread works too, it also covers threads that failed to start
+    fsv_parallel_worker(&job);
+
+#ifndef FSV_DISABLE_THREADS
+    for (size_t i = 0; i < spawned; ++i) {
+#    ifdef _WIN32
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#    else
+        pthread_join(threads[i], NULL);
+#    endif // _WIN32
+    }
+#endif // FSV_DISABLE_THREADS
+
+    size_t tokens = 0;
+    for (size_t i = 0; i < partitions->size; ++i) tokens += partitions->datas[i].size;
+    return tokens;
+}
+
+FSV_DEF void fsv_partitions_free(fsv_partitions_t *partitions) {
+    for (size_t i = 0; i < partitions->size; ++i) fsv_tokenizer_free(&partitions->datas[i]);
+    fda_free(partitions);
+}
+
+///////////////////////// End of Tokenizer /////////////////////////
+
+///////////////////////// Reader /////////////////////////
+
+// One read of a whole chunk, on its own thread when threads are enabled.
+// A thread per chunk costs little next to reading a chunk of a megabyte.
+struct fstring_view_reader_job {
+#ifndef FSV_DISABLE_THREADS
+    fsv_thread_t thread;
+    bool running;
+#endif // FSV_DISABLE_THREADS
+#ifdef _WIN32
+    HANDLE file;
+#else
+    int fd;
+#endif // _WIN32
+    bool requested;
+    bool failed;
+    int error;  // errno of the worker thread
+    char *dest;
+    size_t size;
+    uint64_t offset;
+    size_t read;
+};
+
+static void fsv_reader_read(struct fstring_view_reader_job *job) {
+    job->read   = 0;
+    job->failed = false;
+    while (job->read < job->size) {
+        uint64_t offset = job->offset + job->read;
+#ifdef _WIN32
+        OVERLAPPED overlapped = {};
+        DWORD n               = 0;
+        DWORD to_read         = job->size - job->read > (1u << 30) ? (1u << 30) : (DWORD)(job->size - job->read);
+        overlapped.Offset     = (DWORD)offset;
+        overlapped.OffsetHigh = (DWORD)(offset >> 32);
+        if (!ReadFile(job->file, job->dest + job->read, to_read, &n, &overlapped)) {
+            if (GetLastError() != ERROR_HANDLE_EOF) job->failed = true;
+            break;
+        }
+#else
+        ssize_t n = pread(job->fd, job->dest + job->read, job->size - job->read, (off_t)offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            job->failed = true;
+            job->error  = errno;
+            break;
+        }
+#endif // _WIN32
+        if (n == 0) break;
+        job->read += (size_t)n;
+    }
+}
+
+#ifndef FSV_DISABLE_THREADS
+#    ifdef _WIN32
+static DWORD WINAPI fsv_reader_worker(LPVOID arg) {
+#    else
+static void *fsv_reader_worker(void *arg) {
+#    endif // _WIN32
+    fsv_reader_read((struct fstring_view_reader_job*) arg);
+    return 0;
+}
+#endif // FSV_DISABLE_THREADS
+
+static void fsv_reader_start(fsv_reader_t *reader) {
+    struct fstring_view_reader_job *job = reader->job;
+    job->dest      = reader->buffers[reader->back] + reader->chunk_size;
+    job->size      = reader->chunk_size;
+    job->offset    = reader->offset;
+    job->requested = true;
+#ifndef FSV_DISABLE_THREADS
+#    ifdef _WIN32
+    job->thread  = CreateThread(NULL, 0, fsv_reader_worker, job, 0, NULL);
+    job->running = job->thread != NULL;
+#    else
+    job->running = pthread_create(&job->thread, NULL, fsv_reader_worker, job) == 0;
+#    endif // _WIN32
+#endif // FSV_DISABLE_THREADS
+}
+
+static void fsv_reader_wait(fsv_reader_t *reader) {
+    struct fstring_view_reader_job *job = reader->job;
+    if (!job->requested) {
+        job->read = 0;
+        return;
+    }
+    job->requested = false;
+#ifndef FSV_DISABLE_THREADS
+    if (job->running) {
+#    ifdef _WIN32
+        WaitForSingleObject(job->thread, INFINITE);
+        CloseHandle(job->thread);
+#    else
+        pthread_join(job->thread, NULL);
+#    endif // _WIN32
+        job->running = false;
+        return;
+    }
+#endif // FSV_DISABLE_THREADS
+    // No thread could be started, read it now
+    fsv_reader_read(job);
+}
+
+FSV_DEF bool fsv_reader_open(fsv_reader_t *reader, const char *file_path, size_t chunk_size, char delim) {
+    memset(reader, 0, sizeof(*reader));
+    reader->chunk_size = chunk_size == 0 ? FSV_READER_CHUNK_SIZE : chunk_size;
+    reader->delim      = delim;
+
+    struct fstring_view_reader_job *job = (struct fstring_view_reader_job*) FSV_REALLOC(NULL, sizeof(*job));
+    FSV_ASSERT(job != NULL && "Out of Memory!!!");
+    memset(job, 0, sizeof(*job));
+#ifdef _WIN32
+    job->file = CreateFileA(file_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (job->file == INVALID_HANDLE_VALUE) {
+        FSV_LOGE("Could not open file `%s`. %s", file_path, fsv_tmp_get_last_errmsg());
+        FSV_FREE(job);
+        return false;
+    }
+#else
+    job->fd = open(file_path, O_RDONLY);
+    if (job->fd < 0) {
+        FSV_LOGE("Could not open file `%s`. %s", file_path, strerror(errno));
+        FSV_FREE(job);
+        return false;
+    }
+#    ifdef POSIX_FADV_SEQUENTIAL
+    (void)posix_fadvise(job->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#    endif // POSIX_FADV_SEQUENTIAL
+#endif // _WIN32
+    reader->job = job;
+
+    for (size_t i = 0; i < 2; ++i) {
+        reader->buffers[i] = (char*) FSV_REALLOC(NULL, 2*reader->chunk_size);
+        FSV_ASSERT(reader->buffers[i] != NULL && "Out of Memory!!!");
+    }
+    fsv_reader_start(reader);
+    return true;
+}
+
+FSV_DEF bool fsv_reader_next(fsv_reader_t *reader, fsv_t *window) {
+    struct fstring_view_reader_job *job = reader->job;
+    if (job == NULL) return false;
+
+    fsv_reader_wait(reader);
+    if (job->failed) {
+        FSV_LOGE("Could not read at offset %llu. %s", (unsigned long long)job->offset, strerror(job->error));
+        reader->eof  = true;
+        reader->tail = fsv_from_parts(NULL, 0);
+        return false;
+    }
+    reader->offset += job->read;
+    if (job->read < reader->chunk_size) reader->eof = true;
+
+    // The carry-over goes right before the new chunk, it comes from the other buffer
+    char *chunk   = reader->buffers[reader->back] + reader->chunk_size;
+    char *start   = chunk - reader->tail.length;
+    size_t length = reader->tail.length + job->read;
+    if (reader->tail.length > 0) memcpy(start, reader->tail.datas, reader->tail.length);
+
+    size_t cut = length;
+    if (!reader->eof) {
+        size_t i = length;
+        while (i > 0 && start[i - 1] != reader->delim) --i;
+        // Without any delimiter the record is split where the window ends
+        if (i > 0) cut = i;
+        if (length - cut > reader->chunk_size) cut = length - reader->chunk_size;
+    }
+    reader->tail = fsv_from_parts(start + cut, length - cut);
+
+    // Read the next chunk while this window is parsed
+    reader->back = 1 - reader->back;
+    if (!reader->eof) fsv_reader_start(reader);
+
+    *window = fsv_from_parts(start, cut);
+    return cut > 0;
+}
+
+FSV_DEF void fsv_reader_close(fsv_reader_t *reader) {
+    struct fstring_view_reader_job *job = reader->job;
+    if (job != NULL) {
+        fsv_reader_wait(reader);
+#ifdef _WIN32
+        CloseHandle(job->file);
+#else
+        close(job->fd);
+#endif // _WIN32
+        FSV_FREE(job);
+    }
+    for (size_t i = 0; i < 2; ++i) {
+        if (reader->buffers[i] != NULL) FSV_FREE(reader->buffers[i]);
+    }
+    memset(reader, 0, sizeof(*reader));
+}
+
+///////////////////////// End of Reader /////////////////////////
+
+///////////////////////// Directory Walker /////////////////////////
+
+typedef struct {
+    // Directories left to read, the owner takes from the end, thieves from `head`
+    union { size_t size; size_t length; };
+    size_t capacity;
+    fsv_t *datas;
+    size_t head;
+    fsv_mutex_t mutex;
+    fsv_arena_t arena;  // Paths of the directories found by this worker
+    fsb_t path;
+    char *buffer;
+} fsv_walk_worker_t;
+
+typedef struct {
+    fsv_walk_worker_t *workers;
+    size_t count;
+    size_t pending;  // Directories found but not read yet
+    int stop;
+    fsv_walk_fn_t fn;
+    void *ctx;
+} fsv_walk_job_t;
+
+typedef struct {
+    fsv_walk_job_t *job;
+    size_t worker;
+} fsv_walk_thread_arg_t;
+
+static size_t fsv_walk_pending_add(fsv_walk_job_t *job, int delta) {
+#if defined(FSV_DISABLE_THREADS)
+    return job->pending += (size_t)(ptrdiff_t)delta;
+#elif defined(_WIN32)
+    return (size_t)InterlockedExchangeAdd64((volatile LONG64*)&job->pending, delta) + (size_t)(ptrdiff_t)delta;
+#else
+    return __atomic_add_fetch(&job->pending, (size_t)(ptrdiff_t)delta, __ATOMIC_ACQ_REL);
+#endif // FSV_DISABLE_THREADS
+}
+
+static bool fsv_walk_stopped(fsv_walk_job_t *job) {
+#if defined(FSV_DISABLE_THREADS)
+    return job->stop != 0;
+#elif defined(_WIN32)
+    return InterlockedCompareExchange((volatile LONG*)&job->stop, 0, 0) != 0;
+#else
+    return __atomic_load_n(&job->stop, __ATOMIC_RELAXED) != 0;
+#endif // FSV_DISABLE_THREADS
+}
+
+static void fsv_walk_set_stop(fsv_walk_job_t *job) {
+#if defined(FSV_DISABLE_THREADS)
+    job->stop = 1;
+#elif defined(_WIN32)
+    InterlockedExchange((volatile LONG*)&job->stop, 1);
+#else
+    __atomic_store_n(&job->stop, 1, __ATOMIC_RELAXED);
+#endif // FSV_DISABLE_THREADS
+}
+
+static void fsv_walk_push(fsv_walk_job_t *job, size_t index, fsv_t dir) {
+    fsv_walk_worker_t *worker = &job->workers[index];
+    fsv_t copy = fsv_arena_sv_dup(&worker->arena, dir);
+    fsv_walk_pending_add(job, 1);
+    fsv_mutex_lock(&worker->mutex);
+    fda_append(worker, copy);
+    fsv_mutex_unlock(&worker->mutex);
+}
+
+static bool fsv_walk_pop(fsv_walk_worker_t *worker, bool steal, fsv_t *dir) {
+    bool ret = false;
+    fsv_mutex_lock(&worker->mutex);
+    if (worker->head < worker->size) {
+        // Stealing the oldest directories takes the biggest part of the tree
+        *dir = steal ? worker->datas[worker->head++] : worker->datas[--worker->size];
+        if (worker->head == worker->size) worker->head = worker->size = 0;
+        ret = true;
+    }
+    fsv_mutex_unlock(&worker->mutex);
+    return ret;
+}
+
+static void fsv_walk_yield(void) {
+#if defined(FSV_DISABLE_THREADS)
+#elif defined(_WIN32)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif // FSV_DISABLE_THREADS
+}
+
+// Hands every entity of `dir` to the callback and queues its subdirectories
+static bool fsv_walk_read_dir(fsv_walk_job_t *job, size_t index, fsv_t dir) {
+    fsv_walk_worker_t *worker = &job->workers[index];
+    fsb_t *path = &worker->path;
+    path->length = 0;
+    fsb_append_sv(path, dir);
+#ifdef _WIN32
+    if (!fsv_ends_with_cstr(dir, "\\", false)) fsb_append_char(path, '\\');
+#else
+    if (!fsv_ends_with_cstr(dir, "/", false)) fsb_append_char(path, '/');
+#endif // _WIN32
+    size_t path_length = path->length;
+
+#if defined(__linux__)
+    int dir_fd = open(path->datas, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir_fd < 0) {
+        FSV_LOGE("Could not open folder `" fsv_fmt "`. %s", fsv_arg(dir), strerror(errno));
+        return false;
+    }
+    if (worker->buffer == NULL) {
+        worker->buffer = (char*) FSV_REALLOC(NULL, FSV_GETDENTS_BUFFER_SIZE);
+        FSV_ASSERT(worker->buffer != NULL && "Out of Memory!!!");
+    }
+    while (!fsv_walk_stopped(job)) {
+        long n = syscall(SYS_getdents64, dir_fd, worker->buffer, FSV_GETDENTS_BUFFER_SIZE);
+        if (n == 0) break;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            FSV_LOGE("Could not read directory `" fsv_fmt "`. %s", fsv_arg(dir), strerror(errno));
+            break;
+        }
+        for (long offset = 0; offset < n;) {
+            const fsv_dirent64_t *ent = (const fsv_dirent64_t*)(worker->buffer + offset);
+            offset += ent->d_reclen;
+            if (fsv_is_dot_entry(ent->d_name)) continue;
+
+            path->length = path_length;
+            fsb_append_cstr(path, ent->d_name);
+            bool is_dir = ent->d_type == DT_DIR;
+            if (ent->d_type == DT_UNKNOWN) {
+                struct stat ent_stat = {};
+                if (fstatat(dir_fd, ent->d_name, &ent_stat, AT_SYMLINK_NOFOLLOW) < 0) {
+                    FSV_LOGE("Could not lstat entity `%s`. %s", path->datas, strerror(errno));
+                    continue;
+                }
+                is_dir = S_ISDIR(ent_stat.st_mode);
+            }
+            if (is_dir) fsv_walk_push(job, index, fsv_from_sb(*path));
+            if (!job->fn(job->ctx, index, fsv_from_sb(*path), is_dir)) {
+                fsv_walk_set_stop(job);
+                break;
+            }
+        }
+    }
+    close(dir_fd);
+#elif !defined(_WIN32)
+    DIR *dir_handle = opendir(path->datas);
+    if (dir_handle == NULL) {
+        FSV_LOGE("Could not open folder `" fsv_fmt "`. %s", fsv_arg(dir), strerror(errno));
+        return false;
+    }
+    struct dirent *ent = NULL;
+    while (!fsv_walk_stopped(job) && (ent = readdir(dir_handle)) != NULL) {
+        if (fsv_is_dot_entry(ent->d_name)) continue;
+        path->length = path_length;
+        fsb_append_cstr(path, ent->d_name);
+        struct stat ent_stat = {};
+        if (lstat(path->datas, &ent_stat) < 0) {
+            FSV_LOGE("Could not lstat entity `%s`. %s", path->datas, strerror(errno));
+            continue;
+        }
+        bool is_dir = S_ISDIR(ent_stat.st_mode);
+        if (is_dir) fsv_walk_push(job, index, fsv_from_sb(*path));
+        if (!job->fn(job->ctx, index, fsv_from_sb(*path), is_dir)) fsv_walk_set_stop(job);
+    }
+    closedir(dir_handle);
+#else
+    WIN32_FIND_DATA fd = {};
+    fsb_append_cstr(path, "*.*");
+    HANDLE find_handle = FindFirstFile(path->datas, &fd);
+    if (find_handle == INVALID_HANDLE_VALUE) {
+        FSV_LOGE("Could not open folder `" fsv_fmt "`. %s", fsv_arg(dir), fsv_tmp_get_last_errmsg());
+        return false;
+    }
+    do {
+        if (fsv_is_dot_entry(fd.cFileName)) continue;
+        path->length = path_length;
+        fsb_append_cstr(path, fd.cFileName);
+        bool is_dir = (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+                   && !(fd.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT);
+        if (is_dir) fsv_walk_push(job, index, fsv_from_sb(*path));
+        if (!job->fn(job->ctx, index, fsv_from_sb(*path), is_dir)) fsv_walk_set_stop(job);
+    } while (!fsv_walk_stopped(job) && FindNextFile(find_handle, &fd));
+    FindClose(find_handle);
+#endif // __linux__
+    return true;
+}
+
+static void fsv_walk_work(fsv_walk_job_t *job, size_t index) {
+    while (true) {
+        fsv_t dir = {};
+        bool found = fsv_walk_pop(&job->workers[index], false, &dir);
+        for (size_t i = 1; !found && i < job->count; ++i) {
+            found = fsv_walk_pop(&job->workers[(index + i) % job->count], true, &dir);
+        }
+        if (found) {
+            // After a stop the queues are only drained
+            if (!fsv_walk_stopped(job)) fsv_walk_read_dir(job, index, dir);
+            fsv_walk_pending_add(job, -1);
+            continue;
+        }
+        // Directories being read by other workers may still add more
+        if (fsv_walk_pending_add(job, 0) == 0) break;
+        fsv_walk_yield();
+    }
+}
+
+#ifndef FSV_DISABLE_THREADS
+#    ifdef _WIN32
+static DWORD WINAPI fsv_walk_worker(LPVOID arg) {
+#    else
+static void *fsv_walk_worker(void *arg) {
+#    endif // _WIN32
+    fsv_walk_thread_arg_t *thread_arg = (fsv_walk_thread_arg_t*) arg;
+    fsv_walk_work(thread_arg->job, thread_arg->worker);
+#    ifndef FSV_DISABLE_TMP_BUFFER
+    // Error messages and callbacks may have used the temporary buffer of this thread
+    fsv_tmp_free();
+#    endif // FSV_DISABLE_TMP_BUFFER
+    return 0;
+}
+#endif // FSV_DISABLE_THREADS
+
+static size_t fsv_walk_thread_count(size_t thread_count) {
+#if defined(FSV_DISABLE_THREADS)
+    (void)thread_count;
+    return 1;
+#else
+    if (thread_count == 0) thread_count = fsv_cpu_count();
+    return thread_count > FSV_PARALLEL_MAX_THREADS ? FSV_PARALLEL_MAX_THREADS : thread_count;
+#endif // FSV_DISABLE_THREADS
+}
+
+FSV_DEF bool fsv_walk_parallel(const char *parent, size_t thread_count, fsv_walk_fn_t fn, void *ctx) {
+    fsv_walk_worker_t workers[FSV_PARALLEL_MAX_THREADS];
+    fsv_walk_job_t job = {};
+    job.workers = workers;
+    job.count   = fsv_walk_thread_count(thread_count);
+    job.fn      = fn;
+    job.ctx     = ctx;
+    memset(workers, 0, job.count*sizeof(*workers));
+    for (size_t i = 0; i < job.count; ++i) fsv_mutex_init(&workers[i].mutex);
+
+    // The root is read before starting the threads, its subdirectories seed the queues
+    bool ret = fsv_walk_read_dir(&job, 0, fsv_from_cstr(parent));
+    if (ret) {
+#ifndef FSV_DISABLE_THREADS
+        fsv_thread_t threads[FSV_PARALLEL_MAX_THREADS];
+        fsv_walk_thread_arg_t args[FSV_PARALLEL_MAX_THREADS];
+        size_t spawned = 0;
+        for (; spawned + 1 < job.count; ++spawned) {
+            args[spawned].job    = &job;
+            args[spawned].worker = spawned + 1;
+#    ifdef _WIN32
+            threads[spawned] = CreateThread(NULL, 0, fsv_walk_worker, &args[spawned], 0, NULL);
+            if (threads[spawned] == NULL) break;
+#    else
+            if (pthread_create(&threads[spawned], NULL, fsv_walk_worker, &args[spawned]) != 0) break;
+#    endif // _WIN32
+        }
+#endif // FSV_DISABLE_THREADS
+
+        // Queues of threads that failed to start are stolen by the others
+        fsv_walk_work(&job, 0);
+
+#ifndef FSV_DISABLE_THREADS
+        for (size_t i = 0; i < spawned; ++i) {
+#    ifdef _WIN32
+            WaitForSingleObject(threads[i], INFINITE);
+            CloseHandle(threads[i]);
+#    else
+            pthread_join(threads[i], NULL);
+#    endif // _WIN32
+        }
+#endif // FSV_DISABLE_THREADS
+    }
+
+    for (size_t i = 0; i < job.count; ++i) {
+        fda_free(&workers[i]);
+        fsv_mutex_destroy(&workers[i].mutex);
+        fsv_arena_free(&workers[i].arena);
+        fsb_free(&workers[i].path);
+        if (workers[i].buffer != NULL) FSV_FREE(workers[i].buffer);
+    }
+    return ret;
+}
+
+typedef struct {
+    ffp_t files[FSV_PARALLEL_MAX_THREADS];  // One per worker, merged at the end
+} fsv_walk_collect_t;
+
+static bool fsv_walk_collect(void *ctx, size_t worker, fsv_t path, bool is_dir) {
+    fsv_walk_collect_t *collect = (fsv_walk_collect_t*) ctx;
+    if (is_dir) return true;
+    ffe_t file  = {};
+    file.name   = fsb_from_sv(path);
+    file.is_dir = false;
+    fda_append_a(&collect->files[worker], file);
+    return true;
+}
+
+static int fsv_walk_compare(const void *a, const void *b) {
+    return strcmp(((const ffe_t*)a)->name.datas, ((const ffe_t*)b)->name.datas);
+}
+
+FSV_DEF bool fsb_read_entire_dir_parallel(const char *parent, ffp_t *children, size_t thread_count, bool sorted) {
+    fsv_walk_collect_t *collect = (fsv_walk_collect_t*) FSV_REALLOC(NULL, sizeof(*collect));
+    FSV_ASSERT(collect != NULL && "Out of Memory!!!");
+    memset(collect, 0, sizeof(*collect));
+    thread_count = fsv_walk_thread_count(thread_count);
+
+    bool ret = fsv_walk_parallel(parent, thread_count, fsv_walk_collect, collect);
+
+    size_t total = children->size;
+    for (size_t i = 0; i < thread_count; ++i) total += collect->files[i].size;
+    fda_reserve_a(children, total);
+    size_t first = children->size;
+    for (size_t i = 0; i < thread_count; ++i) {
+        ffp_t *files = &collect->files[i];
+        for (size_t j = 0; j < files->size; ++j) {
+            ffe_t file = files->datas[j];
+            // Worker threads can only use the default allocator, it's thread safe
+            if (children->allocator != NULL) {
+                fsb_t name = fsb_from_sv_with(fsv_from_sb(file.name), children->allocator);
+                fsb_free(&file.name);
+                file.name = name;
+            }
+            children->datas[children->size++] = file;
+        }
+        fda_free_a(files);
+    }
+    if (sorted && children->size > first) qsort(children->datas + first, children->size - first, sizeof(*children->datas), fsv_walk_compare);
+
+    FSV_FREE(collect);
+    return ret;
+}
+
+///////////////////////// End of Directory Walker /////////////////////////
+
+///////////////////////// Batch Reader /////////////////////////
+
+#define FSV_BATCH_THREADS_PER_CPU (4)
+#define FSV_BATCH_READ_GROWTH     (64*1024)
+
+typedef struct {
+    const char *const *paths;  // Either `paths` or `entities`
+    const ffe_t *entities;
+    size_t count;
+    fsb_t *contents;
+    int *errors;
+    size_t next;  // Next file to read, shared by every worker
+    int failed;
+} fsv_batch_job_t;
+
+static size_t fsv_batch_take(fsv_batch_job_t *job) {
+#if defined(FSV_DISABLE_THREADS)
+    return job->next++;
+#elif defined(_WIN32)
+    return (size_t)InterlockedExchangeAdd64((volatile LONG64*)&job->next, 1);
+#else
+    return __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED);
+#endif // FSV_DISABLE_THREADS
+}
+
+static void fsv_batch_fail(fsv_batch_job_t *job) {
+#if defined(FSV_DISABLE_THREADS)
+    job->failed = 1;
+#elif defined(_WIN32)
+    InterlockedExchange((volatile LONG*)&job->failed, 1);
+#else
+    __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+#endif // FSV_DISABLE_THREADS
+}
+
+// Return 0 or the errno of the failure, `sb` is left as it was on failure
+static int fsv_batch_read_file(const char *file_path, fsb_t *sb) {
+#ifdef _WIN32
+    errno = 0;
+    if (fsb_read_entire_file(file_path, sb)) return 0;
+    return errno != 0 ? errno : EIO;
+#else
+    // No fseek/ftell dance, one open, one fstat and the reads. A FIFO from a
+    // listing would block the worker forever, non-regular files give EINVAL
+    struct stat file_stat = {};
+    int fd = fsv_open_regular_file(file_path, &file_stat);
+    if (fd < 0) return errno;
+
+    // The size is only a hint, the file can change while it is read.
+    // One spare byte past the NUL lets the read that sees the end fit without growing
+    size_t length = sb->length;
+    fda_reserve_a(sb, length + (size_t)file_stat.st_size + 2);
+    int err = 0;
+    while (true) {
+        if (sb->length + 1 >= sb->capacity) fda_realloc_a(sb, FSV_BATCH_READ_GROWTH);
+        ssize_t n = read(fd, sb->datas + sb->length, sb->capacity - sb->length - 1);
+        if (n == 0) break;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            err = errno;
+            sb->length = length;
+            break;
+        }
+        sb->length += (size_t)n;
+    }
+    sb->datas[sb->length] = '\0';
+    close(fd);
+    return err;
+#endif // _WIN32
+}
+
+static void fsv_batch_work(fsv_batch_job_t *job) {
+    for (size_t i = fsv_batch_take(job); i < job->count; i = fsv_batch_take(job)) {
+        const char *file_path = job->paths != NULL ? job->paths[i] : job->entities[i].name.datas;
+        int err = fsv_batch_read_file(file_path, &job->contents[i]);
+        if (job->errors != NULL) job->errors[i] = err;
+        if (err != 0) {
+            FSV_LOGE("Could not read file `%s`. %s", file_path, strerror(err));
+            fsv_batch_fail(job);
+        }
+    }
+}
+
+#ifndef FSV_DISABLE_THREADS
+#    ifdef _WIN32
+static DWORD WINAPI fsv_batch_worker(LPVOID arg) {
+#    else
+static void *fsv_batch_worker(void *arg) {
+#    endif // _WIN32
+    fsv_batch_work((fsv_batch_job_t*) arg);
+#    ifndef FSV_DISABLE_TMP_BUFFER
+    // `fsb_read_entire_file` formats its Windows errors in the temporary buffer of this thread
+    fsv_tmp_free();
+#    endif // FSV_DISABLE_TMP_BUFFER
+    return 0;
+}
+#endif // FSV_DISABLE_THREADS
+
+static bool fsv_batch_read(fsv_batch_job_t *job, size_t thread_count) {
+#ifndef FSV_DISABLE_THREADS
+    if (thread_count == 0) thread_count = fsv_cpu_count()*FSV_BATCH_THREADS_PER_CPU;
+    if (thread_count > FSV_PARALLEL_MAX_THREADS) thread_count = FSV_PARALLEL_MAX_THREADS;
+    if (thread_count > job->count) thread_count = job->count;
+
+    size_t spawned = 0;
+    fsv_thread_t threads[FSV_PARALLEL_MAX_THREADS];
+    for (; spawned + 1 < thread_count; ++spawned) {
+#    ifdef _WIN32
+        threads[spawned] = CreateThread(NULL, 0, fsv_batch_worker, job, 0, NULL);
+        if (threads[spawned] == NULL) break;
+#    else
+        if (pthread_create(&threads[spawned], NULL, fsv_batch_worker, job) != 0) break;
+#    endif // _WIN32
+    }
+#else
+    (void)thread_count;
+#endif // FSV_DISABLE_THREADS
+
+    // The calling thread works too, it also covers threads that failed to start
+    fsv_batch_work(job);
+
+#ifndef FSV_DISABLE_THREADS
+    for (size_t i = 0; i < spawned; ++i) {
+#    ifdef _WIN32
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#    else
+        pthread_join(threads[i], NULL);
+#    endif // _WIN32
+    }
+#endif // FSV_DISABLE_THREADS
+    return job->failed == 0;
+}
+
+FSV_DEF bool fsb_read_entire_files(const char *const *paths, size_t count, fsb_t *contents, int *errors, size_t thread_count) {
+    fsv_batch_job_t job = {};
+    job.paths    = paths;
+    job.count    = count;
+    job.contents = contents;
+    job.errors   = errors;
+    return fsv_batch_read(&job, thread_count);
+}
+
+FSV_DEF bool ffp_read_entire_files(const ffp_t *files, fsb_t *contents, int *errors, size_t thread_count) {
+    fsv_batch_job_t job = {};
+    job.entities = files->datas;
+    job.count    = files->size;
+    job.contents = contents;
+    job.errors   = errors;
+    return fsv_batch_read(&job, thread_count);
+}
+
+///////////////////////// End of Batch Reader /////////////////////////
+
+///////////////////////// Grep /////////////////////////
+
+// How much of a file is checked for NUL bytes before searching it
+#define FSV_GREP_BINARY_PROBE (8*1024)
+
+typedef struct {
+    const fsv_grep_t *grep;
+    size_t *cursors;  // `pattern_count` per worker: next match of every pattern in the current file
+    size_t claimed;   // Lines reported or about to be, shared by every worker
+    int stop;
+} fsv_grep_job_t;
+
+static size_t fsv_grep_claim(fsv_grep_job_t *job) {
+#if defined(FSV_DISABLE_THREADS)
+    return job->claimed++;
+#elif defined(_WIN32)
+    return (size_t)InterlockedExchangeAdd64((volatile LONG64*)&job->claimed, 1);
+#else
+    return __atomic_fetch_add(&job->claimed, 1, __ATOMIC_RELAXED);
+#endif // FSV_DISABLE_THREADS
+}
+
+static bool fsv_grep_stopped(fsv_grep_job_t *job) {
+#if defined(FSV_DISABLE_THREADS)
+    return job->stop != 0;
+#elif defined(_WIN32)
+    return InterlockedCompareExchange((volatile LONG*)&job->stop, 0, 0) != 0;
+#else
+    return __atomic_load_n(&job->stop, __ATOMIC_RELAXED) != 0;
+#endif // FSV_DISABLE_THREADS
+}
+
+static void fsv_grep_set_stop(fsv_grep_job_t *job) {
+#if defined(FSV_DISABLE_THREADS)
+    job->stop = 1;
+#elif defined(_WIN32)
+    InterlockedExchange((volatile LONG*)&job->stop, 1);
+#else
+    __atomic_store_n(&job->stop, 1, __ATOMIC_RELAXED);
+#endif // FSV_DISABLE_THREADS
+}
+
+// Next match of `pattern` at or after `from`, `content.length` if there is none
+static size_t fsv_grep_find(const fsv_grep_t *grep, size_t pattern, fsv_t content, size_t from) {
+    fsv_t needle = grep->patterns[pattern];
+    if (needle.length == 0 || needle.datas == NULL) return content.length;
+    return from + fsv_find_sv(content.datas + from, content.length - from, needle.datas, needle.length, grep->ignore_case);
+}
+
+// Return false once the search must stop
+static bool fsv_grep_scan(fsv_grep_job_t *job, size_t worker, fsv_t path, fsv_t content) {
+    const fsv_grep_t *grep = job->grep;
+    const char *datas      = content.datas;
+    size_t n               = content.length;
+    // Every pattern is searched once per match of its own, not once per line
+    size_t *cursors = job->cursors + worker*grep->pattern_count;
+    for (size_t i = 0; i < grep->pattern_count; ++i) cursors[i] = fsv_grep_find(grep, i, content, 0);
+
+    size_t line_number = 1;
+    size_t line_start  = 0;
+    while (true) {
+        size_t at      = n;
+        size_t pattern = 0;
+        for (size_t i = 0; i < grep->pattern_count; ++i) {
+            if (cursors[i] < at) {
+                at      = cursors[i];
+                pattern = i;
+            }
+        }
+        if (at >= n) return true;
+
+        // Lines are only counted up to the matches, the start of the line is then found backwards
+        size_t lines = fsv_count_byte(datas + line_start, at - line_start, '\n');
+        if (lines > 0) {
+            line_number += lines;
+            line_start = at;
+            while (datas[line_start - 1] != '\n') line_start--;
+        }
+        size_t line_end = at + fsv_find_byte(datas + at, n - at, '\n');
+
+        if (fsv_grep_stopped(job)) return false;
+        size_t claimed = fsv_grep_claim(job);
+        if (grep->max_matches != 0 && claimed >= grep->max_matches) return false;
+
+        fsv_grep_match_t match = {};
+        match.path        = path;
+        match.line        = fsv_from_parts(datas + line_start, line_end - line_start);
+        match.line_number = line_number;
+        match.column      = at - line_start + 1;
+        match.pattern     = pattern;
+        if (match.line.length > 0 && match.line.datas[match.line.length - 1] == '\r') match.line.length--;
+        if (!grep->fn(grep->ctx, worker, &match)) return false;
+        if (grep->max_matches != 0 && claimed + 1 >= grep->max_matches) return false;
+        if (line_end >= n) return true;
+
+        line_number++;
+        line_start = line_end + 1;
+        for (size_t i = 0; i < grep->pattern_count; ++i) {
+            if (cursors[i] < line_start) cursors[i] = fsv_grep_find(grep, i, content, line_start);
+        }
+    }
+}
+
+static bool fsv_grep_file(void *ctx, size_t worker, fsv_t path, bool is_dir) {
+    fsv_grep_job_t *job = (fsv_grep_job_t*) ctx;
+    if (is_dir) return !fsv_grep_stopped(job);
+
+    fsv_t content = {};
+    int hints     = FSV_MMAP_SEQUENTIAL | FSV_MMAP_WILLNEED;
+    // Unreadable files are logged and skipped, like unreadable directories.
+    // FIFOs, sockets and devices are not searched at all
+#ifndef _WIN32
+    struct stat file_stat = {};
+    int fd = fsv_open_regular_file(path.datas, &file_stat);
+    if (fd < 0) {
+        if (errno != EINVAL) {
+            FSV_LOGE("Could not open file `%s`. %s", path.datas, strerror(errno));
+        }
+        return !fsv_grep_stopped(job);
+    }
+    if (!fsv_mmap_fd(fd, &file_stat, path.datas, hints, &content)) return !fsv_grep_stopped(job);
+#else
+    if (!fsv_mmap_file(path.datas, hints, &content)) return !fsv_grep_stopped(job);
+#endif // _WIN32
+    bool ret = true;
+    size_t probe = content.length < FSV_GREP_BINARY_PROBE ? content.length : FSV_GREP_BINARY_PROBE;
+    if (content.length > 0 && fsv_find_byte(content.datas, probe, '\0') == probe) {
+        ret = fsv_grep_scan(job, worker, path, content);
+    }
+    fsv_munmap_file(&content);
+
+    if (!ret) fsv_grep_set_stop(job);
+    return ret && !fsv_grep_stopped(job);
+}
+
+FSV_DEF bool fsv_grep_parallel(const char *parent, const fsv_grep_t *grep, size_t *matches) {
+    size_t thread_count = fsv_walk_thread_count(grep->thread_count);
+    fsv_grep_job_t job  = {};
+    job.grep            = grep;
+    job.cursors         = (size_t*) FSV_REALLOC(NULL, (thread_count*grep->pattern_count + 1)*sizeof(size_t));
+    FSV_ASSERT(job.cursors != NULL && "Out of Memory!!!");
+
+    bool ret = fsv_walk_parallel(parent, thread_count, fsv_grep_file, &job);
+
+    // Workers that lost the race for the last slots did not report anything
+    if (matches != NULL) {
+        *matches = grep->max_matches != 0 && job.claimed > grep->max_matches ? grep->max_matches : job.claimed;
+    }
+    FSV_FREE(job.cursors);
+    return ret;
+}
+
+///////////////////////// End of Grep /////////////////////////
+
+///////////////////////// Hash Map /////////////////////////
+
+#define FSV_MAP_EMPTY   ((int8_t)-128)
+#define FSV_MAP_DELETED ((int8_t)-2)
+// Slots are probed 16 at a time, the first 16 control bytes are mirrored
+// after the last one so a group can start on any slot
+#define FSV_MAP_GROUP   (16)
+
+// Every group helper returns one bit per slot of the group
+static inline uint32_t fsv_map_pack_swar(uint64_t high_bits) {
+    return (uint32_t)(((high_bits >> 7)*0x0102040810204080ull) >> 56);
+}
+
+static inline uint32_t fsv_map_match(const int8_t *group, int8_t h2, bool sse2) {
+#ifdef FSV_SIMD_X86
+    if (sse2) {
+        __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
+    }
+#endif // FSV_SIMD_X86
+    (void) sse2;
+    const uint64_t pattern = FSV_SWAR_ONES*(uint8_t)h2;
+    uint64_t lo = fsv_swar_zeros(fsv_swar_load((const char*)group) ^ pattern);
+    uint64_t hi = fsv_swar_zeros(fsv_swar_load((const char*)group + 8) ^ pattern);
+    return fsv_map_pack_swar(lo) | (fsv_map_pack_swar(hi) << 8);
+}
+
+// Empty and deleted are the only control bytes with the high bit set
+static inline uint32_t fsv_map_match_free(const int8_t *group, bool sse2) {
+#ifdef FSV_SIMD_X86
+    if (sse2) return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#endif // FSV_SIMD_X86
+    (void) sse2;
+    uint64_t lo = fsv_swar_load((const char*)group) & ~FSV_SWAR_LOWS;
+    uint64_t hi = fsv_swar_load((const char*)group + 8) & ~FSV_SWAR_LOWS;
+    return fsv_map_pack_swar(lo) | (fsv_map_pack_swar(hi) << 8);
+}
+
+// Leading zeros of a non zero group mask
+static inline size_t fsv_map_clz16(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_clz(x) - 16;
+#else
+    size_t n = 0;
+    while ((x & 0x8000) == 0) { x <<= 1; n++; }
+    return n;
+#endif
+}
+
+static inline void fsv_map_set_ctrl(fsv_map_t *map, size_t index, int8_t ctrl) {
+    size_t mask = map->capacity - 1;
+    map->ctrl[index] = ctrl;
+    map->ctrl[((index - FSV_MAP_GROUP) & mask) + FSV_MAP_GROUP] = ctrl;
+}
+
+static inline bool fsv_map_key_eq(const fsv_map_t *map, fsv_t a, fsv_t b) {
+    return a.length == b.length && (a.length == 0 || fsv_mem_eq(a.datas, b.datas, a.length, map->ignore_case));
+}
+
+static size_t fsv_map_find_index(const fsv_map_t *map, fsv_t key, uint64_t hash) {
+    if (map->capacity == 0) return SIZE_MAX;
+    const bool sse2 = fsv_simd_get() >= FSV_SIMD_SSE2;
+    const int8_t h2 = (int8_t)(hash & 0x7F);
+    const size_t mask = map->capacity - 1;
+    size_t pos = (size_t)(hash >> 7) & mask;
+    // Triangular probing visits every group once when the capacity is a power of 2
+    for (size_t step = FSV_MAP_GROUP; ; step += FSV_MAP_GROUP) {
+        const int8_t *group = map->ctrl + pos;
+        for (uint32_t match = fsv_map_match(group, h2, sse2); match != 0; match &= match - 1) {
+            size_t index = (pos + fsv_ctz64(match)) & mask;
+            if (fsv_map_key_eq(map, map->datas[index].key, key)) return index;
+        }
+        if (fsv_map_match(group, FSV_MAP_EMPTY, sse2) != 0) return SIZE_MAX;
+        if (step > map->capacity) return SIZE_MAX;
+        pos = (pos + step) & mask;
+    }
+}
+
+// First empty or deleted slot on the probe sequence of `hash`, there is always one
+static size_t fsv_map_find_free(const fsv_map_t *map, uint64_t hash) {
+    const bool sse2 = fsv_simd_get() >= FSV_SIMD_SSE2;
+    const size_t mask = map->capacity - 1;
+    size_t pos = (size_t)(hash >> 7) & mask;
+    for (size_t step = FSV_MAP_GROUP; ; step += FSV_MAP_GROUP) {
+        uint32_t slots = fsv_map_match_free(map->ctrl + pos, sse2);
+        if (slots != 0) return (pos + fsv_ctz64(slots)) & mask;
+        pos = (pos + step) & mask;
+    }
+}
+
+static void fsv_map_rehash(fsv_map_t *map, size_t capacity) {
+    fsv_map_t old = *map;
+    // Slots and control bytes share one allocation
+    map->datas = (fsv_map_entry_t*) FSV_REALLOC(NULL, capacity*sizeof(*map->datas) + capacity + FSV_MAP_GROUP);
+    FSV_ASSERT(map->datas != NULL && "Out of Memory!!!");
+    map->ctrl       = (int8_t*)(map->datas + capacity);
+    map->capacity   = capacity;
+    map->tombstones = 0;
+    memset(map->ctrl, (uint8_t)FSV_MAP_EMPTY, capacity + FSV_MAP_GROUP);
+
+    for (size_t i = 0; i < old.capacity; ++i) {
+        if (old.ctrl[i] < 0) continue;
+        uint64_t hash = fsv_hash(old.datas[i].key, map->seed, map->ignore_case);
+        size_t index = fsv_map_find_free(map, hash);
+        fsv_map_set_ctrl(map, index, (int8_t)(hash & 0x7F));
+        map->datas[index] = old.datas[i];
+    }
+    if (old.datas != NULL) FSV_FREE(old.datas);
+}
+
+FSV_DEF void fsv_map_reserve(fsv_map_t *map, size_t count) {
+    // Keep the load factor under 7/8
+    size_t capacity = map->capacity == 0 ? FSV_MAP_GROUP : map->capacity;
+    while (count > capacity/8*7) capacity *= 2;
+    if (capacity > map->capacity) fsv_map_rehash(map, capacity);
+}
+
+FSV_DEF fsv_map_entry_t *fsv_map_find(const fsv_map_t *map, fsv_t key) {
+    size_t index = fsv_map_find_index(map, key, fsv_hash(key, map->seed, map->ignore_case));
+    return index == SIZE_MAX ? NULL : &map->datas[index];
+}
+
+FSV_DEF fsv_map_entry_t *fsv_map_insert(fsv_map_t *map, fsv_t key, bool *inserted) {
+    uint64_t hash = fsv_hash(key, map->seed, map->ignore_case);
+    size_t index = fsv_map_find_index(map, key, hash);
+    if (inserted != NULL) *inserted = index == SIZE_MAX;
+    if (index != SIZE_MAX) return &map->datas[index];
+
+    if (map->size + map->tombstones + 1 > map->capacity/8*7) {
+        // Mostly tombstones: clean them up without growing
+        if (map->capacity == 0)                       fsv_map_rehash(map, FSV_MAP_GROUP);
+        else if (map->size + 1 <= map->capacity/16*7) fsv_map_rehash(map, map->capacity);
+        else                                          fsv_map_rehash(map, map->capacity*2);
+    }
+    index = fsv_map_find_free(map, hash);
+    if (map->ctrl[index] == FSV_MAP_DELETED) map->tombstones -= 1;
+    fsv_map_set_ctrl(map, index, (int8_t)(hash & 0x7F));
+    map->datas[index].key   = key;
+    map->datas[index].value = NULL;
+    map->size += 1;
+    return &map->datas[index];
+}
+
+FSV_DEF bool fsv_map_put(fsv_map_t *map, fsv_t key, void *value) {
+    bool inserted = false;
+    fsv_map_insert(map, key, &inserted)->value = value;
+    return inserted;
+}
+
+FSV_DEF bool fsv_map_get(const fsv_map_t *map, fsv_t key, void **value) {
+    fsv_map_entry_t *entry = fsv_map_find(map, key);
+    if (entry == NULL) return false;
+    if (value != NULL) *value = entry->value;
+    return true;
+}
+
+FSV_DEF bool fsv_map_remove(fsv_map_t *map, fsv_t key) {
+    size_t index = fsv_map_find_index(map, key, fsv_hash(key, map->seed, map->ignore_case));
+    if (index == SIZE_MAX) return false;
+
+    // The slot can go back to empty if no probe sequence ever went past it:
+    // there is an empty slot in less than a group on both sides
+    const bool sse2 = fsv_simd_get() >= FSV_SIMD_SSE2;
+    const size_t mask = map->capacity - 1;
+    uint32_t after  = fsv_map_match(map->ctrl + index, FSV_MAP_EMPTY, sse2);
+    uint32_t before = fsv_map_match(map->ctrl + ((index - FSV_MAP_GROUP) & mask), FSV_MAP_EMPTY, sse2);
+    bool never_full = after != 0 && before != 0 && fsv_ctz64(after) + fsv_map_clz16(before) < FSV_MAP_GROUP;
+
+    fsv_map_set_ctrl(map, index, never_full ? FSV_MAP_EMPTY : FSV_MAP_DELETED);
+    if (!never_full) map->tombstones += 1;
+    map->size -= 1;
+    return true;
+}
+
+FSV_DEF bool fsv_map_next(const fsv_map_t *map, size_t *cursor, fsv_map_entry_t **entry) {
+    for (; *cursor < map->capacity; ++*cursor) {
+        if (map->ctrl[*cursor] >= 0) {
+            *entry = &map->datas[(*cursor)++];
+            return true;
+        }
+    }
+    return false;
+}
+
+FSV_DEF void fsv_map_clear(fsv_map_t *map) {
+    if (map->capacity > 0) memset(map->ctrl, (uint8_t)FSV_MAP_EMPTY, map->capacity + FSV_MAP_GROUP);
+    map->size       = 0;
+    map->tombstones = 0;
+}
+
+FSV_DEF void fsv_map_free(fsv_map_t *map) {
+    if (map->datas != NULL) FSV_FREE(map->datas);
+    map->datas      = NULL;
+    map->ctrl       = NULL;
+    map->capacity   = 0;
+    map->size       = 0;
+    map->tombstones = 0;
+}
+
+///////////////////////// End of Hash Map /////////////////////////
+
+///////////////////////// Arena /////////////////////////
+
+static inline char *fsv_arena_block_datas(fsv_arena_block_t *block) {
+    return (char*)(block + 1);
+}
+
+static inline size_t fsv_arena_padding(fsv_arena_block_t *block, size_t alignment) {
+    uintptr_t address = (uintptr_t)(fsv_arena_block_datas(block) + block->size);
+    return (alignment - (address & (alignment - 1))) & (alignment - 1);
+}
+
+FSV_DEF void *fsv_arena_alloc_aligned(fsv_arena_t *arena, size_t size, size_t alignment) {
+    FSV_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+    const size_t block_size = arena->block_size == 0 ? FSV_ARENA_BLOCK_SIZE : arena->block_size;
+    fsv_arena_block_t *block = arena->current;
+    // Blocks after `current` are the ones kept by `fsv_arena_reset`
+    while (block != NULL && block->size + fsv_arena_padding(block, alignment) + size > block->capacity) {
+        block = block->next;
+    }
+
+    if (block == NULL) {
+        size_t capacity = block_size;
+        if (capacity < size + alignment) capacity = size + alignment;
+        block = (fsv_arena_block_t*) FSV_REALLOC(NULL, sizeof(*block) + capacity);
+        FSV_ASSERT(block != NULL && "Out of Memory!!!");
+        block->size     = 0;
+        block->capacity = capacity;
+        // Insert it right after the current block, so the blocks after it can still be reused
+        if (arena->current == NULL) {
+            block->next  = NULL;
+            arena->first = block;
+        } else {
+            block->next          = arena->current->next;
+            arena->current->next = block;
+        }
+    }
+    // A block that is too small for a big allocation still has room for the next small ones
+    if (size <= block_size/4 || arena->current == NULL) arena->current = block;
+
+    block->size += fsv_arena_padding(block, alignment);
+    void *result = fsv_arena_block_datas(block) + block->size;
+    block->size += size;
+    return result;
+}
+
+FSV_DEF void *fsv_arena_alloc(fsv_arena_t *arena, size_t size) {
+    return fsv_arena_alloc_aligned(arena, size, FSV_ARENA_ALIGN);
+}
+
+FSV_DEF fsv_t fsv_arena_sv_dup(fsv_arena_t *arena, fsv_t sv) {
+    if (sv.datas == NULL) sv.length = 0;
+    char *datas = (char*) fsv_arena_alloc_aligned(arena, sv.length + 1, 1);
+    if (sv.length > 0) memcpy(datas, sv.datas, sv.length);
+    datas[sv.length] = '\0';
+    return fsv_from_parts(datas, sv.length);
+}
+
+FSV_DEF void fsv_arena_reset(fsv_arena_t *arena) {
+    for (fsv_arena_block_t *block = arena->first; block != NULL; block = block->next) block->size = 0;
+    arena->current = arena->first;
+}
+
+FSV_DEF void fsv_arena_free(fsv_arena_t *arena) {
+    fsv_arena_block_t *block = arena->first;
+    while (block != NULL) {
+        fsv_arena_block_t *next = block->next;
+        FSV_FREE(block);
+        block = next;
+    }
+    arena->first   = NULL;
+    arena->current = NULL;
+}
+
+static void *fsv_arena_allocator_alloc(void *ctx, size_t size) {
+    return fsv_arena_alloc((fsv_arena_t*)ctx, size);
+}
+
+static void *fsv_arena_allocator_resize(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    fsv_arena_t *arena = (fsv_arena_t*)ctx;
+    fsv_arena_block_t *block = arena->current;
+    if (block != NULL
+        && (char*)ptr >= fsv_arena_block_datas(block)
+        && (char*)ptr + old_size == fsv_arena_block_datas(block) + block->size
+        && block->size - old_size + new_size <= block->capacity) {
+        // Last allocation of the block, typically a growing `fsb_t`
+        block->size = block->size - old_size + new_size;
+        return ptr;
+    }
+    void *ret = fsv_arena_alloc(arena, new_size);
+    memcpy(ret, ptr, old_size < new_size ? old_size : new_size);
+    return ret;
+}
+
+static void fsv_arena_allocator_release(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    (void)ptr;
+    (void)size;
+}
+
+FSV_DEF fsv_allocator_t fsv_arena_allocator(fsv_arena_t *arena) {
+    fsv_allocator_t allocator = {};
+    allocator.alloc   = fsv_arena_allocator_alloc;
+    allocator.resize  = fsv_arena_allocator_resize;
+    allocator.release = fsv_arena_allocator_release;
+    allocator.ctx     = arena;
+    return allocator;
+}
+
+static inline size_t fsv_pool_slot_size(const fsv_pool_t *pool) {
+    size_t slot_size = pool->slot_size < sizeof(void*) ? sizeof(void*) : pool->slot_size;
+    return (slot_size + FSV_ARENA_ALIGN - 1) & ~(FSV_ARENA_ALIGN - 1);
+}
+
+FSV_DEF void *fsv_pool_alloc(fsv_pool_t *pool) {
+    if (pool->free_list != NULL) {
+        void *ret = pool->free_list;
+        pool->free_list = *(void**)ret;
+        return ret;
+    }
+    return fsv_arena_alloc(&pool->arena, fsv_pool_slot_size(pool));
+}
+
+FSV_DEF void fsv_pool_release(fsv_pool_t *pool, void *ptr) {
+    if (ptr == NULL) return;
+    *(void**)ptr = pool->free_list;
+    pool->free_list = ptr;
+}
+
+FSV_DEF void fsv_pool_reset(fsv_pool_t *pool) {
+    fsv_arena_reset(&pool->arena);
+    pool->free_list = NULL;
+}
+
+FSV_DEF void fsv_pool_free(fsv_pool_t *pool) {
+    fsv_arena_free(&pool->arena);
+    pool->free_list = NULL;
+}
+
+static void *fsv_pool_allocator_alloc(void *ctx, size_t size) {
+    fsv_pool_t *pool = (fsv_pool_t*)ctx;
+    if (size > fsv_pool_slot_size(pool)) return NULL;
+    return fsv_pool_alloc(pool);
+}
+
+static void *fsv_pool_allocator_resize(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    (void)old_size;
+    if (new_size > fsv_pool_slot_size((fsv_pool_t*)ctx)) return NULL;
+    return ptr;
+}
+
+static void fsv_pool_allocator_release(void *ctx, void *ptr, size_t size) {
+    (void)size;
+    fsv_pool_release((fsv_pool_t*)ctx, ptr);
+}
+
+FSV_DEF fsv_allocator_t fsv_pool_allocator(fsv_pool_t *pool) {
+    fsv_allocator_t allocator = {};
+    allocator.alloc   = fsv_pool_allocator_alloc;
+    allocator.resize  = fsv_pool_allocator_resize;
+    allocator.release = fsv_pool_allocator_release;
+    allocator.ctx     = pool;
+    return allocator;
+}
+
+///////////////////////// End of Arena /////////////////////////
+
+///////////////////////// Interner /////////////////////////
+
+FSV_DEF fsv_atom_t fsv_intern(fsv_interner_t *interner, fsv_t sv) {
+    if (sv.datas == NULL) sv.length = 0;
+    bool inserted = false;
+    fsv_map_entry_t *entry = fsv_map_insert(&interner->map, sv, &inserted);
+    if (!inserted) return (fsv_atom_t)(uintptr_t)entry->value;
+
+    FSV_ASSERT(interner->atoms.size < UINT32_MAX && "Too many atoms!!!");
+    fsv_atom_t atom = (fsv_atom_t)interner->atoms.size;
+    // The map now points into the arena instead of the caller's memory
+    entry->key   = fsv_arena_sv_dup(&interner->arena, sv);
+    entry->value = (void*)(uintptr_t)atom;
+    fda_append(&interner->atoms, entry->key);
+    return atom;
+}
+
+FSV_DEF fsv_atom_t fsv_intern_cstr(fsv_interner_t *interner, const char *cstr) {
+    return fsv_intern(interner, fsv_from_cstr(cstr));
+}
+
+FSV_DEF bool fsv_interner_find(const fsv_interner_t *interner, fsv_t sv, fsv_atom_t *atom) {
+    fsv_map_entry_t *entry = fsv_map_find(&interner->map, sv);
+    if (entry == NULL) return false;
+    if (atom != NULL) *atom = (fsv_atom_t)(uintptr_t)entry->value;
+    return true;
+}
+
+FSV_DEF fsv_t fsv_atom_sv(const fsv_interner_t *interner, fsv_atom_t atom) {
+    FSV_ASSERT(atom < interner->atoms.size);
+    return interner->atoms.datas[atom];
+}
+
+FSV_DEF void fsv_interner_free(fsv_interner_t *interner) {
+    fsv_map_free(&interner->map);
+    fsv_arena_free(&interner->arena);
+    fda_free(&interner->atoms);
+}
+
+///////////////////////// End of Interner /////////////////////////
+
+///////////////////////// Directory Watcher /////////////////////////
+
+#ifdef __linux__
+#    include <sys/inotify.h>
+#    define FSV_WATCH_EVENTS (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR)
+#endif // __linux__
+
+static void fsv_watch_log(fsv_watch_t *watch, fsv_t path, bool added) {
+    if (watch->changes.size >= FSV_WATCH_MAX_CHANGES) {
+        // Drop the oldest half at once, trimming one by one would move the whole log every time
+        size_t dropped = (watch->changes.size + 1) / 2;
+        for (size_t i = 0; i < dropped; ++i) fsb_free(&watch->changes.datas[i].path);
+        watch->trimmed = watch->changes.datas[dropped - 1].generation;
+        watch->changes.size -= dropped;
+        memmove(watch->changes.datas, watch->changes.datas + dropped,
+                watch->changes.size*sizeof(*watch->changes.datas));
+    }
+    fsv_watch_change_t change = {};
+    change.path       = fsb_from_sv(path);
+    change.generation = ++watch->generation;
+    change.added      = added;
+    fda_append(&watch->changes, change);
+}
+
+// Every directory knows its files and subdirectories, so removing a tree
+// only touches what is in it
+typedef struct fstring_view_watch_dir {
+    fsb_t path;
+    int wd;
+    struct fstring_view_watch_dir *parent;
+    size_t slot;  // Index in the `children` of `parent`
+    struct {
+        union { size_t size; size_t length; };
+        size_t capacity;
+        struct fstring_view_watch_dir **datas;
+    } children;
+    struct {
+        union { size_t size; size_t length; };
+        size_t capacity;
+        size_t *datas;  // Indices in `files` of the watch
+    } files;
+} fsv_watch_dir_t;
+
+typedef struct fstring_view_watch_owner {
+    fsv_watch_dir_t *dir;
+    size_t slot;  // Index in the `files` of `dir`
+} fsv_watch_owner_t;
+
+// The bytes of the watch descriptor stored in `dir` are its key in `watches`
+static inline fsv_t fsv_watch_wd_key(const int *wd) {
+    return fsv_from_parts((const char*)wd, sizeof(*wd));
+}
+
+// Forget every directory, without touching `files`
+static void fsv_watch_free_dirs(fsv_watch_t *watch) {
+    size_t cursor = 0;
+    fsv_map_entry_t *entry = NULL;
+    while (fsv_map_next(&watch->dirs, &cursor, &entry)) {
+        fsv_watch_dir_t *dir = (fsv_watch_dir_t*) entry->value;
+        fsb_free(&dir->path);
+        fda_free(&dir->children);
+        fda_free(&dir->files);
+        FSV_FREE(dir);
+    }
+    fsv_map_free(&watch->dirs);
+    fsv_map_free(&watch->watches);
+    fda_free(&watch->owners);
+}
+
+#ifdef __linux__
+static void fsv_watch_join(fsb_t *path, fsv_t dir, const char *name) {
+    path->length = 0;
+    fsb_append_sv(path, dir);
+    if (!fsv_ends_with_cstr(dir, "/", false)) fsb_append_char(path, '/');
+    fsb_append_cstr(path, name);
+}
+
+static void fsv_watch_add_file(fsv_watch_t *watch, fsv_watch_dir_t *dir, fsv_t path, bool log) {
+    // Files created while their directory is being listed are seen twice
+    if (fsv_map_find(&watch->index, path) != NULL) return;
+    ffe_t file = {};
+    file.name  = fsb_from_sv_with(path, watch->files.allocator);
+    fda_append_a(&watch->files, file);
+    size_t index = watch->files.size - 1;
+    fsv_map_put(&watch->index, fsv_from_sb(file.name), (void*)(uintptr_t)index);
+
+    fsv_watch_owner_t owner = {};
+    owner.dir  = dir;
+    owner.slot = dir->files.size;
+    fda_append(&watch->owners, owner);
+    fda_append(&dir->files, index);
+    if (log) fsv_watch_log(watch, path, true);
+}
+
+// Swap with the last entity, in `files` and in the list of its directory
+static void fsv_watch_remove_at(fsv_watch_t *watch, size_t i) {
+    fsv_watch_owner_t *owners = watch->owners.datas;
+    fsv_watch_dir_t *dir      = owners[i].dir;
+    size_t dir_last           = dir->files.size - 1;
+    if (owners[i].slot != dir_last) {
+        size_t moved = dir->files.datas[dir_last];
+        dir->files.datas[owners[i].slot] = moved;
+        owners[moved].slot = owners[i].slot;
+    }
+    dir->files.size--;
+
+    ffe_t *files = watch->files.datas;
+    size_t last  = watch->files.size - 1;
+    fsv_t path   = fsv_from_sb(files[i].name);
+    fsv_map_remove(&watch->index, path);
+    fsv_watch_log(watch, path, false);
+    fsb_free(&files[i].name);
+    if (i != last) {
+        files[i]  = files[last];
+        owners[i] = owners[last];
+        owners[i].dir->files.datas[owners[i].slot] = i;
+        fsv_map_insert(&watch->index, fsv_from_sb(files[i].name), NULL)->value = (void*)(uintptr_t)i;
+    }
+    watch->files.size--;
+    watch->owners.size--;
+}
+
+static void fsv_watch_remove_file(fsv_watch_t *watch, fsv_t path) {
+    void *index = NULL;
+    if (fsv_map_get(&watch->index, path, &index)) fsv_watch_remove_at(watch, (size_t)(uintptr_t)index);
+}
+
+static void fsv_watch_remove_dir(fsv_watch_t *watch, fsv_watch_dir_t *dir) {
+    while (dir->children.size > 0) fsv_watch_remove_dir(watch, dir->children.datas[dir->children.size - 1]);
+    while (dir->files.size > 0) fsv_watch_remove_at(watch, dir->files.datas[dir->files.size - 1]);
+
+    // Deleted or moved away, either way its events do not belong here anymore
+    inotify_rm_watch(watch->fd, dir->wd);
+    fsv_watch_dir_t *parent = dir->parent;
+    if (parent != NULL) {
+        size_t last = parent->children.size - 1;
+        if (dir->slot != last) {
+            parent->children.datas[dir->slot] = parent->children.datas[last];
+            parent->children.datas[dir->slot]->slot = dir->slot;
+        }
+        parent->children.size--;
+    }
+    fsv_map_remove(&watch->dirs, fsv_from_sb(dir->path));
+    fsv_map_remove(&watch->watches, fsv_watch_wd_key(&dir->wd));
+    fsb_free(&dir->path);
+    fda_free(&dir->children);
+    fda_free(&dir->files);
+    FSV_FREE(dir);
+}
+
+// Watch `path` before listing it, so nothing created in between is missed
+static bool fsv_watch_add_tree(fsv_watch_t *watch, fsv_watch_dir_t *parent, fsv_t path, bool log) {
+    fsb_t dir_path = fsb_from_sv(path);
+    int wd = inotify_add_watch(watch->fd, dir_path.datas, FSV_WATCH_EVENTS);
+    if (wd < 0) {
+        // Already gone again, its removal is the next event
+        bool ret = errno == ENOENT || errno == ENOTDIR;
+        if (!ret) {
+            FSV_LOGE("Could not watch directory `%s`. %s", dir_path.datas, strerror(errno));
+        }
+        fsb_free(&dir_path);
+        return ret;
+    }
+    // Seen twice like files, it was listed the first time
+    if (fsv_map_find(&watch->watches, fsv_watch_wd_key(&wd)) != NULL) {
+        fsb_free(&dir_path);
+        return true;
+    }
+    // Replaced by another directory of the same name before its removal was seen
+    void *stale = NULL;
+    if (fsv_map_get(&watch->dirs, path, &stale)) fsv_watch_remove_dir(watch, (fsv_watch_dir_t*) stale);
+
+    fsv_watch_dir_t *dir = (fsv_watch_dir_t*) FSV_REALLOC(NULL, sizeof(*dir));
+    FSV_ASSERT(dir != NULL && "Out of Memory!!!");
+    memset(dir, 0, sizeof(*dir));
+    dir->path   = dir_path;
+    dir->wd     = wd;
+    dir->parent = parent;
+    if (parent != NULL) {
+        dir->slot = parent->children.size;
+        fda_append(&parent->children, dir);
+    }
+    fsv_map_put(&watch->dirs, fsv_from_sb(dir->path), dir);
+    fsv_map_put(&watch->watches, fsv_watch_wd_key(&dir->wd), dir);
+
+    ffp_t children = {};
+    bool ret = fsb_read_entire_dir(dir->path.datas, &children, false);
+    for (size_t i = 0; i < children.size; ++i) {
+        fsv_t child = fsv_from_sb(children.datas[i].name);
+        if (children.datas[i].is_dir) {
+            ret = fsv_watch_add_tree(watch, dir, child, log) && ret;
+        } else {
+            fsv_watch_add_file(watch, dir, child, log);
+        }
+    }
+    ffp_free(&children);
+    return ret;
+}
+
+static bool fsv_watch_read_events(fsv_watch_t *watch) {
+    bool ret = true;
+    fsb_t path = {};
+    // `struct inotify_event` needs 4 byte alignment
+    uint64_t buffer[512];
+
+    while (true) {
+        ssize_t n = read(watch->fd, buffer, sizeof(buffer));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN) {
+                ret = false;
+                FSV_LOGE("Could not read inotify events of `%s`. %s", watch->root.datas, strerror(errno));
+            }
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < n;) {
+            const struct inotify_event *event = (const struct inotify_event*)((const char*)buffer + offset);
+            offset += sizeof(*event) + event->len;
+            if (event->mask & IN_Q_OVERFLOW) {
+                // Events were lost, the rest of the queue cannot be trusted either
+                fsb_free(&path);
+                return fsv_watch_resync(watch);
+            }
+
+            int wd = event->wd;
+            void *value = NULL;
+            // Directories removed with their parent still have events in the queue
+            if (!fsv_map_get(&watch->watches, fsv_watch_wd_key(&wd), &value)) continue;
+            fsv_watch_dir_t *dir = (fsv_watch_dir_t*) value;
+            if (event->mask & IN_IGNORED) {
+                fsv_watch_remove_dir(watch, dir);
+                continue;
+            }
+            if (event->len == 0) continue;
+
+            fsv_watch_join(&path, fsv_from_sb(dir->path), event->name);
+            bool is_dir = (event->mask & IN_ISDIR) != 0;
+            if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                if (is_dir) {
+                    ret = fsv_watch_add_tree(watch, dir, fsv_from_sb(path), true) && ret;
+                } else {
+                    fsv_watch_add_file(watch, dir, fsv_from_sb(path), true);
+                }
+            } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                if (!is_dir) {
+                    fsv_watch_remove_file(watch, fsv_from_sb(path));
+                } else if (fsv_map_get(&watch->dirs, fsv_from_sb(path), &value)) {
+                    fsv_watch_remove_dir(watch, (fsv_watch_dir_t*) value);
+                }
+            }
+        }
+    }
+
+    fsb_free(&path);
+    return ret;
+}
+#endif // __linux__
+
+// Fill the empty `files` and `index` from scratch
+static bool fsv_watch_scan(fsv_watch_t *watch) {
+    fsv_watch_free_dirs(watch);
+#ifdef __linux__
+    // A new descriptor drops the previous watches and whatever events are still queued
+    if (watch->fd >= 0) close(watch->fd);
+    watch->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watch->fd >= 0) return fsv_watch_add_tree(watch, NULL, fsv_from_sb(watch->root), false);
+    FSV_LOGE("Could not initialize inotify, `%s` is rescanned on every poll. %s",
+            watch->root.datas, strerror(errno));
+#endif // __linux__
+
+    bool ret = fsb_read_entire_dir(watch->root.datas, &watch->files, true);
+    for (size_t i = 0; i < watch->files.size; ++i) {
+        fsv_map_put(&watch->index, fsv_from_sb(watch->files.datas[i].name), (void*)(uintptr_t)i);
+    }
+    return ret;
+}
+
+FSV_DEF bool fsv_watch_open(fsv_watch_t *watch, const char *root) {
+    watch->root = fsb_from_sv(fsv_from_cstr(root));
+    watch->fd   = -1;
+    return fsv_watch_scan(watch);
+}
+
+FSV_DEF bool fsv_watch_poll(fsv_watch_t *watch) {
+#ifdef __linux__
+    if (watch->fd >= 0) return fsv_watch_read_events(watch);
+#endif // __linux__
+    return fsv_watch_resync(watch);
+}
+
+FSV_DEF bool fsv_watch_resync(fsv_watch_t *watch) {
+    ffp_t old_files     = watch->files;
+    fsv_map_t old_index = watch->index;
+    fsv_map_t empty     = {};
+    empty.seed          = old_index.seed;
+    watch->index        = empty;
+    watch->files.size     = 0;
+    watch->files.capacity = 0;
+    watch->files.datas    = NULL;
+
+    bool ret = fsv_watch_scan(watch);
+    for (size_t i = 0; i < old_files.size; ++i) {
+        fsv_t path = fsv_from_sb(old_files.datas[i].name);
+        if (fsv_map_find(&watch->index, path) == NULL) fsv_watch_log(watch, path, false);
+    }
+    for (size_t i = 0; i < watch->files.size; ++i) {
+        fsv_t path = fsv_from_sb(watch->files.datas[i].name);
+        if (fsv_map_find(&old_index, path) == NULL) fsv_watch_log(watch, path, true);
+    }
+    fsv_map_free(&old_index);
+    ffp_free(&old_files);
+    return ret;
+}
+
+FSV_DEF bool fsv_watch_changes_since(const fsv_watch_t *watch, uint64_t generation,
+        const fsv_watch_change_t **changes, size_t *count) {
+    *changes = NULL;
+    *count   = 0;
+    if (generation >= watch->generation) return true;
+    if (generation < watch->trimmed) return false;
+    // Generations in the log are consecutive and start right after `trimmed`
+    size_t first = (size_t)(generation - watch->trimmed);
+    *changes = watch->changes.datas + first;
+    *count   = watch->changes.size - first;
+    return true;
+}
+
+FSV_DEF void fsv_watch_close(fsv_watch_t *watch) {
+#ifdef __linux__
+    if (watch->fd >= 0) close(watch->fd);
+#endif // __linux__
+    watch->fd = -1;
+    ffp_free(&watch->files);
+    fsv_map_free(&watch->index);
+    for (size_t i = 0; i < watch->changes.size; ++i) fsb_free(&watch->changes.datas[i].path);
+    fda_free(&watch->changes);
+    fsv_watch_free_dirs(watch);
+    fsb_free(&watch->root);
+    watch->generation = 0;
+    watch->trimmed    = 0;
+}
+
+///////////////////////// End of Directory Watcher /////////////////////////
+
+///////////////////////// Temporary Buffer /////////////////////////
+#ifndef FSV_DISABLE_TMP_BUFFER
+
+#ifndef FSV_TMP_CAPACITY
+#define FSV_TMP_CAPACITY (10*1024)
+#endif // FSV_TMP_CAPACITY
+
+typedef struct fsv_tmp_block_t fsv_tmp_block_t;
+struct fsv_tmp_block_t {
+    fsv_tmp_block_t *prev;
+    fsv_tmp_block_t *next;
+    size_t base;     // Save point at the start of the block
+    size_t size;
+    size_t capacity;
+    // Followed by `capacity` chars
+};
+
+#define fsv_tmp_block_datas(block) ((char*)((block) + 1))
+
+static FSV_THREAD_LOCAL fsv_tmp_block_t *fsv_tmp_first   = NULL;
+static FSV_THREAD_LOCAL fsv_tmp_block_t *fsv_tmp_current = NULL;
+
+static void fsv_tmp_free_after(fsv_tmp_block_t *block) {
+    fsv_tmp_block_t *it = block->next;
+    while (it != NULL) {
+        fsv_tmp_block_t *next = it->next;
+        FSV_FREE(it);
+        it = next;
+    }
+    block->next = NULL;
+}
+
+// Inserts a new block right after `prev`
+static fsv_tmp_block_t *fsv_tmp_block_new(fsv_tmp_block_t *prev, size_t how_many_chars) {
+    size_t capacity = how_many_chars > FSV_TMP_CAPACITY ? how_many_chars : FSV_TMP_CAPACITY;
+    fsv_tmp_block_t *block = (fsv_tmp_block_t*) FSV_REALLOC(NULL, sizeof(*block) + capacity);
+    FSV_ASSERT(block != NULL && "Out of Memory!!!");
+    block->prev     = prev;
+    block->next     = NULL;
+    block->size     = 0;
+    block->capacity = capacity;
+    if (prev != NULL) {
+        block->next = prev->next;
+        prev->next  = block;
+    }
+    // The unused tail of a block is skipped, so a block starts where the previous one ends.
+    // The blocks after `block` are empty, moving their save points is fine
+    for (fsv_tmp_block_t *it = block; it != NULL; it = it->next) {
+        if (it->next != NULL) it->next->prev = it;
+        it->base = it->prev == NULL ? 0 : it->prev->base + it->prev->capacity;
+    }
+    return block;
+}
+
+FSV_DEF char *fsv_tmp_alloc(size_t how_many_chars) {
+    fsv_tmp_block_t *block = fsv_tmp_current;
+    if (block == NULL) {
+        block = fsv_tmp_block_new(NULL, how_many_chars);
+        fsv_tmp_first = block;
+    } else if (block->capacity - block->size < how_many_chars) {
+        // Blocks left over by a rewind are reused, unless they are too small.
+        // They are not freed here, a continuous concat may still read from them
+        fsv_tmp_block_t *next = block->next;
+        if (next == NULL || next->capacity < how_many_chars) {
+            next = fsv_tmp_block_new(block, how_many_chars);
+        }
+        block = next;
+        block->size = 0;
+    }
+    fsv_tmp_current = block;
+
+    char *ret = fsv_tmp_block_datas(block) + block->size;
+    block->size += how_many_chars;
+    return ret;
+}
+
+FSV_DEF void fsv_tmp_reset(void) {
+    if (fsv_tmp_first == NULL) return;
+    fsv_tmp_free_after(fsv_tmp_first);
+    fsv_tmp_first->size = 0;
+    fsv_tmp_current     = fsv_tmp_first;
+}
+
+FSV_DEF void fsv_tmp_free(void) {
+    if (fsv_tmp_first == NULL) return;
+    fsv_tmp_free_after(fsv_tmp_first);
+    FSV_FREE(fsv_tmp_first);
+    fsv_tmp_first   = NULL;
+    fsv_tmp_current = NULL;
 }
 
 FSV_DEF size_t fsv_tmp_save_point(void) {
-    return fsv_tmp_size;
+    if (fsv_tmp_current == NULL) return 0;
+    return fsv_tmp_current->base + fsv_tmp_current->size;
 }
 
 FSV_DEF void fsv_tmp_rewind(size_t checkpoint) {
-    fsv_tmp_size = checkpoint;
+    fsv_tmp_block_t *block = fsv_tmp_current;
+    if (block == NULL) return;
+    while (block->prev != NULL && checkpoint < block->base) block = block->prev;
+    FSV_ASSERT(checkpoint >= block->base && checkpoint - block->base <= block->capacity);
+    // The blocks after it are kept for the next allocations
+    block->size     = checkpoint - block->base;
+    fsv_tmp_current = block;
 }
 
 FSV_DEF char *fsv_tmp_strdup(const char *cstr) {
@@ -758,7 +6497,9 @@ FSV_DEF char *fsv_tmp_sv_to_cstr(fsv_t sv) {
 FSV_DEF fsv_t fsv_tmp_concat(fsv_t sv1, fsv_t sv2) {
     fsv_t ret;
     size_t length = sv1.length + sv2.length;
-    char *buffer = (char*) fsv_tmp_alloc(length);
+    // Room for the NUL is allocated but given back, so repeated concats stay continuous
+    char *buffer = (char*) fsv_tmp_alloc(length + 1);
+    fsv_tmp_current->size -= 1;
     ret.length = length;
     ret.datas = buffer;
 
@@ -773,8 +6514,7 @@ FSV_DEF fsv_t fsv_tmp_concat(fsv_t sv1, fsv_t sv2) {
             buffer[index++] = sv2.datas[i];
         }
     }
-    if (fsv_tmp_save_point() + 1 < FSV_TMP_CAPACITY)
-        buffer[length] = '\0';
+    buffer[length] = '\0';
 
     return ret;
 }
@@ -810,25 +6550,17 @@ FSV_DEF void fsv_log(const char *file, int line, const fsv_log_level_t level, co
     msg_length = vsnprintf(NULL, 0, msg, arg);
     va_end(arg);
 
-    if ((int)fsv_tmp_save_point() < FSV_TMP_CAPACITY - msg_length - 1) {
-        /*                                     [  msg_length  ]
-         * [---------------->------------------<--------------]
-         * [ tmp_save_point ]
-         */
-        char *buffer = fsv_tmp_buffer + (FSV_TMP_CAPACITY - msg_length - 1);
+    // Short messages are formatted on the stack, the temporary buffer is left alone
+    char small[512];
+    if (msg_length < (int)sizeof(small)) {
         va_start(arg, msg);
-        vsnprintf(buffer, msg_length + 1, msg, arg);
+        vsnprintf(small, sizeof(small), msg, arg);
         va_end(arg);
 
-        buffer[msg_length] = '\0';
-        fprintf(output, "%s:%d: %s\n", file, line, buffer);
+        fprintf(output, "%s:%d: %s\n", file, line, small);
     } else {
-        /*               [           msg_length               ]
-         * [-------------<-->---------------------------------]
-         * [ tmp_save_point ]
-         */
         fsb_t sb = {};
-        fda_reserve(&sb, (size_t)(msg_length + 1));
+        fda_reserve_a(&sb, (size_t)(msg_length + 1));
         FSV_ASSERT(sb.datas != NULL);
 
         va_start(arg, msg);
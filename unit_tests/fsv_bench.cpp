@@ -0,0 +1,428 @@
+// Micro benchmarks for the hot paths of fsv.h
+// Build type should be Release: `cmake -DCMAKE_BUILD_TYPE=Release ...`
+// Usage: ./fsv_bench [size in MiB]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#define FSV_IMPLEMENTATION
+#include "../fsv.h"
+
+static const char *simd_names[] = { "swar", "sse2", "avx2", "avx512" };
+
+template <typename F>
+static void bench(const char *name, size_t bytes, F &&f) {
+    // Warm up the caches and the branch predictors first
+    f();
+    auto start = std::chrono::steady_clock::now();
+    size_t runs = 0;
+    double elapsed = 0;
+    do {
+        f();
+        runs++;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed < 0.5);
+    printf("%-40s %8.2f GiB/s\n", name, (double)bytes*runs/elapsed/(1024.0*1024.0*1024.0));
+}
+
+static volatile size_t sink = 0;
+
+static void bench_find_byte(const std::string &haystack) {
+    bench("memchr", haystack.size(), [&] {
+        sink += (const char*)memchr(haystack.data(), '#', haystack.size()) == NULL;
+    });
+
+    fsv_simd_t best = fsv_simd_detect();
+    for (int simd = FSV_SIMD_SWAR; simd <= best; ++simd) {
+        fsv_simd_set((fsv_simd_t)simd);
+        std::string name = std::string("fsv_index_of/") + simd_names[simd];
+        fsv_t sv = fsv_from_parts(haystack.data(), haystack.size());
+        bench(name.c_str(), haystack.size(), [&] { sink += fsv_index_of(sv, '#'); });
+    }
+    fsv_simd_set(best);
+}
+
+static void bench_split_by_delim(const std::string &csv) {
+    bench("fsv_split_by_delim", csv.size(), [&] {
+        fsv_t sv = fsv_from_parts(csv.data(), csv.size());
+        fsv_t column = {};
+        while (fsv_split_by_delim(&sv, ',', &column)) sink += column.length;
+    });
+}
+
+static void bench_split_by_sv(const std::string &text) {
+    bench("fsv_split_by_cstr(\"\\r\\n\")", text.size(), [&] {
+        fsv_t sv = fsv_from_parts(text.data(), text.size());
+        fsv_t line = {};
+        while (fsv_split_by_cstr(&sv, "\r\n", false, &line)) sink += line.length;
+    });
+    bench("fsv_split_by_cstr(\"\\r\\n\", ignore_case)", text.size(), [&] {
+        fsv_t sv = fsv_from_parts(text.data(), text.size());
+        fsv_t line = {};
+        while (fsv_split_by_cstr(&sv, "\r\n", true, &line)) sink += line.length;
+    });
+
+    const char *long_needle = "a needle that is long enough for the Horspool search";
+    fsv_t sv = fsv_from_parts(text.data(), text.size());
+    bench("fsv_index_of_sv(long needle)", text.size(), [&] {
+        sink += fsv_index_of_sv(sv, fsv_from_cstr(long_needle), false);
+    });
+}
+
+// Every derived view is O(1), so the throughput must not drop when the
+// buffer grows (it used to rescan up to the end of the buffer per view)
+static void bench_trim_lines(const std::string &text) {
+    bench("fsv_split_by_delim + fsv_trim", text.size(), [&] {
+        fsv_t sv = fsv_from_parts(text.data(), text.size());
+        fsv_t line = {};
+        while (fsv_split_by_delim(&sv, '\n', &line)) sink += fsv_trim(line).length;
+    });
+}
+
+static void bench_split_by_any(const std::string &log) {
+    fsv_delims_t delims = fsv_delims_from_cstr(" \t,;=");
+    bench("fsv_split_by_any(\" \\t,;=\")", log.size(), [&] {
+        fsv_t sv = fsv_from_parts(log.data(), log.size());
+        fsv_t token = {};
+        while (fsv_split_by_any(&sv, &delims, &token)) sink += token.length;
+    });
+
+    fsv_tokenizer_t tokenizer = {};
+    bench("fsv_tokenizer_scan + next", log.size(), [&] {
+        fsv_tokenizer_scan(&tokenizer, fsv_from_parts(log.data(), log.size()), &delims);
+        fsv_t token = {};
+        while (fsv_tokenizer_next(&tokenizer, &token)) sink += token.length;
+    });
+    fsv_tokenizer_free(&tokenizer);
+
+    fsv_partitions_t partitions = {};
+    std::string name = "fsv_split_parallel/" + std::to_string(fsv_cpu_count()) + " threads";
+    bench(name.c_str(), log.size(), [&] {
+        sink += fsv_split_parallel(fsv_from_parts(log.data(), log.size()), &delims, 0, &partitions);
+    });
+    fsv_partitions_free(&partitions);
+}
+
+static void bench_hash(const std::string &text) {
+    bench("fsv_hash", text.size(), [&] {
+        sink += fsv_hash(fsv_from_parts(text.data(), text.size()), 0, false);
+    });
+    bench("fsv_hash(ignore_case)", text.size(), [&] {
+        sink += fsv_hash(fsv_from_parts(text.data(), text.size()), 0, true);
+    });
+
+    // Short keys, the usual case of a hash map
+    const size_t key_length = 12;
+    bench("fsv_hash(12 bytes keys)", text.size(), [&] {
+        for (size_t i = 0; i + key_length <= text.size(); i += key_length) {
+            sink += fsv_hash(fsv_from_parts(text.data() + i, key_length), 0, false);
+        }
+    });
+    bench("fnv1a(12 bytes keys)", text.size(), [&] {
+        for (size_t i = 0; i + key_length <= text.size(); i += key_length) {
+            uint64_t hash = 0xcbf29ce484222325ull;
+            for (size_t j = 0; j < key_length; ++j) hash = (hash ^ (uint8_t)text[i + j])*0x100000001b3ull;
+            sink += hash;
+        }
+    });
+}
+
+static void bench_map(void) {
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1000000; ++i) keys.push_back("host-" + std::to_string(i*2654435761u) + ".example.com");
+    size_t bytes = 0;
+    for (const std::string &key : keys) bytes += key.size();
+
+    bench("fsv_map put + get", bytes, [&] {
+        fsv_map_t map = {};
+        for (const std::string &key : keys) fsv_map_put(&map, fsv_from_parts(key.data(), key.size()), NULL);
+        for (const std::string &key : keys) sink += fsv_map_find(&map, fsv_from_parts(key.data(), key.size())) != NULL;
+        fsv_map_free(&map);
+    });
+    bench("std::unordered_map put + get", bytes, [&] {
+        std::unordered_map<std::string_view, void*> map;
+        for (const std::string &key : keys) map[key] = NULL;
+        for (const std::string &key : keys) sink += map.count(key);
+    });
+}
+
+static void bench_intern(const std::string &log) {
+    // Every token of the log is a repeated value
+    fsv_delims_t delims = fsv_delims_from_cstr(" \t,;=\n");
+    std::vector<fsb_t> copies;
+    bench("fsb_from_sv every token", log.size(), [&] {
+        fsv_t sv = fsv_from_parts(log.data(), log.size());
+        fsv_t token = {};
+        while (fsv_split_by_any(&sv, &delims, &token)) copies.push_back(fsb_from_sv(token));
+        for (fsb_t &sb : copies) fsb_free(&sb);
+        copies.clear();
+    });
+    bench("fsv_intern every token", log.size(), [&] {
+        fsv_interner_t interner = {};
+        fsv_t sv = fsv_from_parts(log.data(), log.size());
+        fsv_t token = {};
+        while (fsv_split_by_any(&sv, &delims, &token)) sink += fsv_intern(&interner, token);
+        fsv_interner_free(&interner);
+    });
+}
+
+static void bench_parse_int(void) {
+    std::string numbers;
+    while (numbers.size() < 16*1024*1024) numbers += std::to_string((long long)rand()*rand() - RAND_MAX) + ",";
+    fsv_delims_t delims = fsv_delims_from_cstr(",");
+
+    bench("strtoll(fsv_tmp_sv_to_cstr)", numbers.size(), [&] {
+        fsv_t sv = fsv_from_parts(numbers.data(), numbers.size());
+        fsv_t token = {};
+        while (fsv_split_by_any(&sv, &delims, &token)) {
+            size_t save_point = fsv_tmp_save_point();
+            sink += strtoll(fsv_tmp_sv_to_cstr(token), NULL, 10);
+            fsv_tmp_rewind(save_point);
+        }
+    });
+    bench("fsv_parse_i64", numbers.size(), [&] {
+        fsv_t sv = fsv_from_parts(numbers.data(), numbers.size());
+        int64_t value = 0;
+        while (fsv_parse_i64(&sv, &value) == FSV_PARSE_OK) {
+            sink += value;
+            sv = fsv_slice(sv, 1, SIZE_MAX);
+        }
+    });
+}
+
+static void bench_parse_float(void) {
+    std::string numbers;
+    char buffer[64];
+    while (numbers.size() < 16*1024*1024) {
+        numbers += std::string(buffer, snprintf(buffer, sizeof(buffer), "%.17g,", (double)rand()/RAND_MAX*pow(10, rand() % 40 - 20)));
+    }
+    fsv_delims_t delims = fsv_delims_from_cstr(",");
+
+    bench("strtod(fsv_tmp_sv_to_cstr)", numbers.size(), [&] {
+        fsv_t sv = fsv_from_parts(numbers.data(), numbers.size());
+        fsv_t token = {};
+        while (fsv_split_by_any(&sv, &delims, &token)) {
+            size_t save_point = fsv_tmp_save_point();
+            sink += (size_t)strtod(fsv_tmp_sv_to_cstr(token), NULL);
+            fsv_tmp_rewind(save_point);
+        }
+    });
+    bench("fsv_parse_f64", numbers.size(), [&] {
+        fsv_t sv = fsv_from_parts(numbers.data(), numbers.size());
+        double value = 0;
+        while (fsv_parse_f64(&sv, &value) == FSV_PARSE_OK) {
+            sink += (size_t)value;
+            sv = fsv_slice(sv, 1, SIZE_MAX);
+        }
+    });
+}
+
+static void bench_format(void) {
+    std::vector<double> doubles;
+    std::vector<int64_t> integers;
+    for (int i = 0; i < 1000000; ++i) {
+        doubles.push_back((double)rand()/RAND_MAX*pow(10, rand() % 40 - 20));
+        integers.push_back((int64_t)rand()*rand() - RAND_MAX);
+    }
+    fsb_t sb = {};
+    // Throughput is reported in output bytes
+    bench("fsb_append_strf(\"%.17g\")", 20*doubles.size(), [&] {
+        sb.length = 0;
+        for (double value : doubles) fsb_append_strf(&sb, "%.17g", value);
+        sink += sb.length;
+    });
+    bench("fsb_append_f64", 20*doubles.size(), [&] {
+        sb.length = 0;
+        for (double value : doubles) fsb_append_f64(&sb, value);
+        sink += sb.length;
+    });
+    bench("fsb_append_strf(\"%s=%lld;\")", 15*integers.size(), [&] {
+        fsb_t report = {};
+        for (int64_t value : integers) fsb_append_strf(&report, "%s=%lld;", "key", (long long)value);
+        sink += report.length;
+        fsb_free(&report);
+    });
+    bench("fsb_append_strf(\"%lld\")", 10*integers.size(), [&] {
+        sb.length = 0;
+        for (int64_t value : integers) fsb_append_strf(&sb, "%lld", (long long)value);
+        sink += sb.length;
+    });
+    bench("fsb_append_i64", 10*integers.size(), [&] {
+        sb.length = 0;
+        for (int64_t value : integers) fsb_append_i64(&sb, value);
+        sink += sb.length;
+    });
+    fsb_free(&sb);
+}
+
+static void bench_small_strings(void) {
+    std::vector<std::string> names;
+    size_t bytes = 0;
+    for (int i = 0; i < 1000000; ++i) {
+        names.push_back("file_" + std::to_string(i) + ".txt");
+        bytes += names.back().size();
+    }
+    std::vector<fsb_t> sbs(names.size());
+    bench("fsb_from_sv(short names)", bytes, [&] {
+        for (size_t i = 0; i < names.size(); ++i) sbs[i] = fsb_from_sv(fsv_from_parts(names[i].data(), names[i].size()));
+        for (fsb_t &sb : sbs) fsb_free(&sb);
+    });
+    std::vector<fssb_t> fssbs(names.size());
+    bench("fssb_from_sv(short names)", bytes, [&] {
+        for (size_t i = 0; i < names.size(); ++i) fssbs[i] = fssb_from_sv(fsv_from_parts(names[i].data(), names[i].size()));
+        for (fssb_t &sb : fssbs) fssb_free(&sb);
+    });
+}
+
+static void bench_read_file(const std::string &text) {
+    const char *file_path = "fsv_bench_file.txt";
+    FILE *file = fopen(file_path, "wb");
+    if (file == NULL) return;
+    fwrite(text.data(), 1, text.size(), file);
+    fclose(file);
+
+    // Open the file and touch every page, the file stays in the page cache
+    fsb_t sb = {};
+    bench("fsb_read_entire_file", text.size(), [&] {
+        sb.length = 0;
+        fsb_read_entire_file(file_path, &sb);
+        for (size_t i = 0; i < sb.length; i += 4096) sink += sb.datas[i];
+    });
+    fsb_free(&sb);
+    bench("fsv_mmap_file", text.size(), [&] {
+        fsv_t sv = {};
+        fsv_mmap_file(file_path, FSV_MMAP_SEQUENTIAL, &sv);
+        for (size_t i = 0; i < sv.length; i += 4096) sink += sv.datas[i];
+        fsv_munmap_file(&sv);
+    });
+    bench("fsv_reader(1 MiB chunks)", text.size(), [&] {
+        fsv_reader_t reader = {};
+        fsv_t window = {};
+        fsv_reader_open(&reader, file_path, 0, '\n');
+        while (fsv_reader_next(&reader, &window)) sink += window.datas[window.length - 1];
+        fsv_reader_close(&reader);
+    });
+    remove(file_path);
+}
+
+static void bench_read_files(void) {
+    // Thousands of small files, like a config tree. They stay in the page cache,
+    // so this measures the per-file overhead rather than the device
+    const size_t count = 2000;
+    const std::string content(4096, 'x');
+    std::vector<std::string> names;
+    std::vector<const char*> paths;
+    for (size_t i = 0; i < count; ++i) names.push_back("fsv_bench_file_" + std::to_string(i) + ".txt");
+    for (const std::string &name : names) {
+        FILE *file = fopen(name.c_str(), "wb");
+        if (file == NULL) return;
+        fwrite(content.data(), 1, content.size(), file);
+        fclose(file);
+        paths.push_back(name.c_str());
+    }
+
+    std::vector<fsb_t> contents(count);
+    bench("fsb_read_entire_file(2000 x 4 KiB)", count*content.size(), [&] {
+        for (size_t i = 0; i < count; ++i) {
+            contents[i].length = 0;
+            fsb_read_entire_file(paths[i], &contents[i]);
+        }
+    });
+    bench("fsb_read_entire_files(2000 x 4 KiB)", count*content.size(), [&] {
+        for (fsb_t &sb : contents) sb.length = 0;
+        fsb_read_entire_files(paths.data(), count, contents.data(), NULL, 0);
+    });
+    for (fsb_t &sb : contents) fsb_free(&sb);
+    for (const std::string &name : names) remove(name.c_str());
+}
+
+static bool count_grep_match(void *ctx, size_t worker, const fsv_grep_match_t *match) {
+    (void)ctx;
+    (void)worker;
+    sink += match->line.length;
+    return true;
+}
+
+static void bench_grep(const std::string &text) {
+    // 64 files splitting `text`, with a rare literal to find
+    const char *dir = "fsv_bench_grep";
+    const size_t count = 64;
+    const size_t size  = text.size()/count;
+    std::string mkdir = std::string("mkdir -p ") + dir;
+    if (system(mkdir.c_str()) != 0) return;
+    std::vector<std::string> names;
+    for (size_t i = 0; i < count; ++i) {
+        names.push_back(std::string(dir) + "/f" + std::to_string(i));
+        FILE *file = fopen(names.back().c_str(), "wb");
+        if (file == NULL) return;
+        fwrite(text.data() + i*size, 1, size, file);
+        fputs("a rare needle\n", file);
+        fclose(file);
+    }
+
+    fsv_t pattern = fsv_from_cstr("rare needle");
+    bench("fsb_read_entire_file+fsv_index_of_sv", count*size, [&] {
+        ffp_t files = {};
+        fsb_read_entire_dir(dir, &files, true);
+        fsb_t sb = {};
+        for (size_t i = 0; i < files.size; ++i) {
+            sb.length = 0;
+            fsb_read_entire_file(files.datas[i].name.datas, &sb);
+            sink += fsv_index_of_sv(fsv_from_sb(sb), pattern, false);
+        }
+        fsb_free(&sb);
+        ffp_free(&files);
+    });
+    fsv_grep_t grep = {};
+    grep.patterns      = &pattern;
+    grep.pattern_count = 1;
+    grep.fn            = count_grep_match;
+    bench("fsv_grep_parallel", count*size, [&] {
+        fsv_grep_parallel(dir, &grep, NULL);
+    });
+
+    for (const std::string &name : names) remove(name.c_str());
+    remove(dir);
+}
+
+int main(int argc, char **argv) {
+    size_t size = (argc > 1 ? (size_t)atol(argv[1]) : 64)*1024*1024;
+
+    std::string haystack(size, 'a');
+    bench_find_byte(haystack);
+
+    std::string csv;
+    csv.reserve(size);
+    while (csv.size() < size) csv += "field,another_longer_field,1234567,";
+    bench_split_by_delim(csv);
+
+    std::string text;
+    text.reserve(size);
+    while (text.size() < size) text += "The quick brown fox jumps over the lazy dog, again and again\r\n";
+    bench_split_by_sv(text);
+    bench_trim_lines(text);
+    bench_hash(text);
+    bench_read_file(text);
+    bench_read_files();
+    bench_grep(text);
+
+    std::string log;
+    log.reserve(size);
+    while (log.size() < size) log += "ts=1700000000;level=info, host=some-host-name\tmsg=request handled in 12ms\n";
+    bench_split_by_any(log);
+    bench_intern(log);
+
+    bench_map();
+    bench_parse_int();
+    bench_parse_float();
+    bench_format();
+    bench_small_strings();
+
+    return 0;
+}
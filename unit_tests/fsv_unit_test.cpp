@@ -1,3 +1,18 @@
+#include <algorithm>
+#include <charconv>
+#include <cerrno>
+#include <cmath>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#    include <sys/stat.h>
+#endif // _WIN32
+
 #include "gtest/gtest.h"
 
 #define FSV_IMPLEMENTATION
@@ -96,6 +111,45 @@ TEST(fstring_view, fsv_from_partial_cstr_FROM_MIDDLE_STRING) {
     EXPECT_EQ(strncmp(sv.datas, cstr + left, right), 0);
 }
 
+TEST(fstring_view, fsv_from_partial_cstr_NOT_NULL_TERMINATED) {
+    // Must not read past `length`, `buffer` has no null-terminator
+    char buffer[4] = { 'a', 'b', 'c', 'd' };
+    fsv_t sv = fsv_from_partial_cstr(buffer, 3);
+    EXPECT_TRUE(fexpect_sv_eq_cstr(sv, "abc"));
+
+    buffer[1] = '\0';
+    sv = fsv_from_partial_cstr(buffer, 3);
+    EXPECT_TRUE(fexpect_sv_eq_cstr(sv, "a"));
+}
+
+TEST(fstring_view, fsv_from_parts_EMBEDDED_NULL) {
+    const char buffer[] = { 'a', '\0', 'b', ',', 'c' };
+    fsv_t sv = fsv_from_parts(buffer, sizeof(buffer));
+    fsv_t ot = {};
+
+    EXPECT_EQ(sv.length, sizeof(buffer));
+    EXPECT_EQ(sv.datas, buffer);
+    EXPECT_TRUE(fsv_split_by_delim(&sv, ',', &ot));
+    EXPECT_EQ(ot.length, 3);
+    EXPECT_EQ(sv.length, 1);
+
+    sv = fsv_from_parts(nullptr, 10);
+    EXPECT_EQ(sv.length, 0);
+    EXPECT_EQ(sv.datas, nullptr);
+}
+
+TEST(fstring_view, fsv_slice_CLAMPED) {
+    const char *cstr = "The quick brown fox jumps over the lazy dog";
+    fsv_t sv = fsv_from_cstr(cstr);
+
+    EXPECT_TRUE(fexpect_sv_eq_cstr(fsv_slice(sv, 4, 5), "quick"));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(fsv_slice(sv, 35, SIZE_MAX), "lazy dog"));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(fsv_slice(sv, 100, 5), ""));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(fsv_from_sv(sv, 3), "The"));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(fsv_from_sv(fsv_slice(sv, 0, 9), 100), "The quick"));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(fsv_slice(fsv_from_cstr(nullptr), 0, 5), nullptr));
+}
+
 TEST(fstring_view, FSV_TRIM_LEFT) {
     const char *cstr      = "   \t\r\n\v\n\f\n\tTHe QUIck bROwn FoX juMPS oVeR THe lazy DOg\t\r\t\v\t\f\n\n\n    ";
     const char *cstr_trim = "THe QUIck bROwn FoX juMPS oVeR THe lazy DOg\t\r\t\v\t\f\n\n\n    ";
@@ -140,6 +194,79 @@ TEST(fstring_view, fsv_index_of_NOT_FOUND_CASE) {
     EXPECT_EQ(fsv_index_of(sv, 'Z'), -1);
 }
 
+TEST(fstring_view, fsv_index_of_EVERY_SIMD_LEVEL) {
+    // Cover every block size and tail length of every kernel
+    char buffer[513] = {};
+    for (size_t i = 0; i < sizeof(buffer) - 1; ++i) buffer[i] = 'a' + i%26;
+
+    fsv_simd_t best = fsv_simd_detect();
+    for (int simd = FSV_SIMD_SWAR; simd <= best; ++simd) {
+        EXPECT_EQ(fsv_simd_set((fsv_simd_t)simd), simd);
+        for (size_t offset = 0; offset < 8; ++offset) {
+            for (size_t length = 0; length + offset < sizeof(buffer); length += 7) {
+                fsv_t sv = fsv_from_partial_cstr(buffer + offset, length);
+                for (size_t at = 0; at < length; at += 13) {
+                    buffer[offset + at] = '#';
+                    EXPECT_EQ(fsv_index_of(sv, '#'), (int)at) << "simd = " << simd << ", length = " << length;
+                    buffer[offset + at] = 'a' + (offset + at)%26;
+                }
+                EXPECT_EQ(fsv_index_of(sv, '#'), -1) << "simd = " << simd << ", length = " << length;
+            }
+        }
+    }
+    fsv_simd_set(best);
+}
+
+static size_t naive_find(const std::string &hay, const std::string &needle, bool ignore_case) {
+    for (size_t i = 0; i + needle.size() <= hay.size(); ++i) {
+        size_t j = 0;
+        while (j < needle.size()
+               && (ignore_case ? tolower(hay[i + j]) == tolower(needle[j]) : hay[i + j] == needle[j])) {
+            j++;
+        }
+        if (j == needle.size()) return i;
+    }
+    return std::string::npos;
+}
+
+TEST(fstring_view, fsv_index_of_sv_EVERY_SIMD_LEVEL) {
+    // Small alphabet so there are a lot of partial matches
+    std::string hay;
+    for (size_t i = 0; i < 2000; ++i) hay += "abAB@`"[rand()%6];
+
+    fsv_simd_t best = fsv_simd_detect();
+    for (int simd = FSV_SIMD_SWAR; simd <= best; ++simd) {
+        fsv_simd_set((fsv_simd_t)simd);
+        for (size_t length = 1; length < 80; ++length) {
+            // Needle from the haystack so it is found, and a different case one
+            size_t from = rand()%(hay.size() - length);
+            std::string needle = hay.substr(from, length);
+            std::string swapped = needle;
+            for (char &c : swapped) c = isupper(c) ? tolower(c) : toupper(c);
+
+            fsv_t sv = fsv_from_partial_cstr(hay.c_str(), hay.size());
+            for (bool ignore_case : { false, true }) {
+                for (const std::string *n : { &needle, &swapped }) {
+                    size_t expected = naive_find(hay, *n, ignore_case);
+                    int index = fsv_index_of_sv(sv, fsv_from_cstr(n->c_str()), ignore_case);
+                    EXPECT_EQ(index, expected == std::string::npos ? -1 : (int)expected)
+                        << "simd = " << simd << ", needle = " << *n << ", ignore_case = " << ignore_case;
+                }
+            }
+        }
+    }
+    fsv_simd_set(best);
+}
+
+TEST(fstring_view, fsv_index_of_sv_NOT_FOUND_CASE) {
+    fsv_t sv = fsv_from_cstr("The quick brown fox jumps over the lazy dog");
+    EXPECT_EQ(fsv_index_of_sv(sv, fsv_from_cstr("lazy cat"), true), -1);
+    EXPECT_EQ(fsv_index_of_sv(sv, fsv_from_cstr("LAZY DOG"), false), -1);
+    EXPECT_EQ(fsv_index_of_sv(sv, fsv_from_cstr("The quick brown fox jumps over the lazy dog!"), false), -1);
+    EXPECT_EQ(fsv_index_of_sv(sv, fsv_from_cstr(""), false), -1);
+    EXPECT_EQ(fsv_index_of_sv(sv, fsv_from_cstr("LAZY DOG"), true), 35);
+}
+
 TEST(fstring_view, FSV_STRLEN) {
     char str_arr[]   = "abcdefghijklmnopqrstuvwxyz";
     const char *cstr = "abcdefghijklmnopqrstuvwxyz";
@@ -230,6 +357,285 @@ TEST(fstring_view, fsv_eq_CASE_INSENSITIVE_NOT_EQUAL) {
     EXPECT_FALSE(fsv_eq(sv1, sv2, true));
 }
 
+TEST(fstring_view, fsv_eq_EVERY_SIMD_LEVEL) {
+    // Bytes around the letters and their non ASCII counterparts
+    // which must not be folded
+    const char alphabet[] = "@AZ[`az{\xC1\xDA\xE1\xFA";
+    fsv_simd_t best = fsv_simd_detect();
+    for (int simd = FSV_SIMD_SWAR; simd <= best; ++simd) {
+        fsv_simd_set((fsv_simd_t)simd);
+        for (size_t length = 0; length < 100; ++length) {
+            std::string a, b;
+            for (size_t i = 0; i < length; ++i) a += alphabet[rand()%(sizeof(alphabet) - 1)];
+            b = a;
+            for (char &c : b) c = isupper(c) ? tolower(c) : (islower(c) ? toupper(c) : c);
+
+            fsv_t sv1 = fsv_from_partial_cstr(a.c_str(), a.size());
+            fsv_t sv2 = fsv_from_partial_cstr(b.c_str(), b.size());
+            EXPECT_TRUE(fsv_eq(sv1, sv2, true)) << "simd = " << simd << ", a = " << a;
+            EXPECT_EQ(fsv_eq(sv1, sv2, false), a == b) << "simd = " << simd << ", a = " << a;
+
+            for (size_t at = 0; at < length; ++at) {
+                // Flip case of a non-letter byte, which should break equality
+                char saved = b[at];
+                b[at] ^= 0x20;
+                bool letter = isalpha((unsigned char)saved) != 0;
+                EXPECT_EQ(fsv_eq(sv1, sv2, true), letter) << "simd = " << simd << ", a = " << a << ", at = " << at;
+                EXPECT_EQ(fsv_starts_with(sv1, fsv_from_partial_cstr(b.c_str(), at + 1), true), letter);
+                EXPECT_EQ(fsv_ends_with(sv1, fsv_from_partial_cstr(b.c_str() + at, length - at), true), letter);
+                b[at] = saved;
+            }
+        }
+    }
+    fsv_simd_set(best);
+}
+
+TEST(fstring_view, fsv_parse_u64_SAME_AS_STRTOULL) {
+    std::vector<std::string> inputs = {
+        "0", "7", "12345678", "123456789", "1234567812345678", "12345678123456789",
+        "18446744073709551615", "18446744073709551616", "99999999999999999999999",
+        "000000000000000000000000000042", "42abc", "4 2", "12345678x",
+    };
+    for (int i = 0; i < 2000; ++i) {
+        std::string digits;
+        for (int n = 1 + rand() % 22; n > 0; --n) digits += (char)('0' + rand() % 10);
+        inputs.push_back(digits);
+    }
+
+    for (const std::string &input : inputs) {
+        errno = 0;
+        char *end = NULL;
+        unsigned long long expected = strtoull(input.c_str(), &end, 10);
+
+        uint64_t value = 0;
+        fsv_t sv = fsv_from_parts(input.c_str(), input.size());
+        fsv_parse_status_t status = fsv_parse_u64(&sv, &value);
+        EXPECT_EQ(status, errno == ERANGE ? FSV_PARSE_OVERFLOW : FSV_PARSE_OK) << input;
+        EXPECT_EQ(value, expected) << input;
+        EXPECT_EQ(sv.datas, end) << input;
+    }
+}
+
+TEST(fstring_view, fsv_parse_i64_SAME_AS_STRTOLL) {
+    std::vector<std::string> inputs = {
+        "0", "-0", "+0", "9223372036854775807", "9223372036854775808", "-9223372036854775808",
+        "-9223372036854775809", "-18446744073709551616", "+123", "-12345678,", "-0000000000000000000001",
+    };
+    for (int i = 0; i < 2000; ++i) {
+        std::string digits = rand() % 2 ? "-" : "";
+        for (int n = 1 + rand() % 21; n > 0; --n) digits += (char)('0' + rand() % 10);
+        inputs.push_back(digits);
+    }
+
+    for (const std::string &input : inputs) {
+        errno = 0;
+        char *end = NULL;
+        long long expected = strtoll(input.c_str(), &end, 10);
+
+        int64_t value = 0;
+        fsv_t sv = fsv_from_parts(input.c_str(), input.size());
+        fsv_parse_status_t status = fsv_parse_i64(&sv, &value);
+        EXPECT_EQ(status, errno == ERANGE ? FSV_PARSE_OVERFLOW : FSV_PARSE_OK) << input;
+        EXPECT_EQ(value, expected) << input;
+        EXPECT_EQ(sv.datas, end) << input;
+    }
+}
+
+static std::vector<std::string> float_inputs(void) {
+    std::vector<std::string> inputs = {
+        "0", "-0", "0.0", ".5", "5.", "1e23", "1E-5", "+1.5e+10", "123.456e-7", "1e308", "1.7976931348623157e308",
+        "1.7976931348623159e308", "1e309", "-1e309", "1e-400", "2.2250738585072011e-308", "2.2250738585072014e-308",
+        "4.9406564584124654e-324", "2.4703282292062327e-324", "2.4703282292062328e-324", "9007199254740993",
+        "9007199254740992.000000000000000000001", "7.038531e-26", "8.589973e9", "3.4028235e38", "3.4028236e38",
+        "1.17549435e-38", "1.4e-45", "7.0e-46", "0.000000000000000000000000000000000000000000001",
+        "12345678901234567890123456789", "1.00000000000000011102230246251565404236316680908203125",
+        "1.00000000000000011102230246251565404236316680908203124", "100000000000000000000000000000000e-32",
+        "1e", "1e+", "2.5E-", "1.5x", "0e1000000000000", "1e-99999999999999999999",
+    };
+    char buffer[64];
+    for (int i = 0; i < 20000; ++i) {
+        uint64_t bits = ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (std::isnan(value) || std::isinf(value)) continue;
+        snprintf(buffer, sizeof(buffer), "%.*g", 1 + rand() % 19, value);
+        inputs.push_back(buffer);
+        float f = (float)value;
+        if (!std::isinf(f)) {
+            snprintf(buffer, sizeof(buffer), "%.*g", 1 + rand() % 10, f);
+            inputs.push_back(buffer);
+        }
+    }
+    // Many digits, the values around halfway points need all of them.
+    // Both signs, the hard cases take a different path
+    size_t first_long = inputs.size();
+    inputs.push_back("-1684868616358.25012237620568800928655");
+    inputs.push_back("-1.000000059604644775390625");
+    std::string digits = "4.";
+    for (int i = 0; i < 800; ++i) digits += (char)('0' + rand() % 10);
+    inputs.push_back(digits);
+    inputs.push_back(digits + "e-320");
+    inputs.push_back("0." + std::string(400, '0') + "1e400");
+    for (int i = 0; i < 5000; ++i) {
+        std::string input;
+        for (int n = 1 + rand() % 25; n > 0; --n) input += (char)('0' + rand() % 10);
+        if (rand() % 2) input.insert(rand() % input.size(), ".");
+        input += "e" + std::to_string(rand() % 700 - 350);
+        inputs.push_back(input);
+    }
+    for (size_t i = first_long, count = inputs.size(); i < count; ++i) {
+        if (inputs[i][0] != '-') inputs.push_back("-" + inputs[i]);
+    }
+    return inputs;
+}
+
+TEST(fstring_view, fsv_parse_f64_SAME_AS_STRTOD) {
+    for (const std::string &input : float_inputs()) {
+        char *end = NULL;
+        double expected = strtod(input.c_str(), &end);
+
+        double value = 0;
+        fsv_t sv = fsv_from_parts(input.c_str(), input.size());
+        fsv_parse_status_t status = fsv_parse_f64(&sv, &value);
+        EXPECT_EQ(status, std::isinf(expected) ? FSV_PARSE_OVERFLOW : FSV_PARSE_OK) << input;
+        EXPECT_EQ(memcmp(&value, &expected, sizeof(value)), 0) << input << ": " << value << " != " << expected;
+        EXPECT_EQ(sv.datas, end) << input;
+    }
+}
+
+TEST(fstring_view, fsv_parse_f32_SAME_AS_STRTOF) {
+    for (const std::string &input : float_inputs()) {
+        char *end = NULL;
+        float expected = strtof(input.c_str(), &end);
+
+        float value = 0;
+        fsv_t sv = fsv_from_parts(input.c_str(), input.size());
+        fsv_parse_status_t status = fsv_parse_f32(&sv, &value);
+        EXPECT_EQ(status, std::isinf(expected) ? FSV_PARSE_OVERFLOW : FSV_PARSE_OK) << input;
+        EXPECT_EQ(memcmp(&value, &expected, sizeof(value)), 0) << input << ": " << value << " != " << expected;
+        EXPECT_EQ(sv.datas, end) << input;
+    }
+}
+
+TEST(fstring_view, fsv_parse_f64_SPECIAL) {
+    double value = 0;
+    fsv_t sv = fsv_from_cstr("-Infinity,inf,NaN");
+    EXPECT_EQ(fsv_parse_f64(&sv, &value), FSV_PARSE_OK);
+    EXPECT_TRUE(std::isinf(value) && value < 0);
+    EXPECT_TRUE(fexpect_sv_eq_cstr(sv, ",inf,NaN"));
+    sv = fsv_slice(sv, 1, SIZE_MAX);
+    EXPECT_EQ(fsv_parse_f64(&sv, &value), FSV_PARSE_OK);
+    EXPECT_TRUE(std::isinf(value) && value > 0);
+    sv = fsv_slice(sv, 1, SIZE_MAX);
+    EXPECT_EQ(fsv_parse_f64(&sv, &value), FSV_PARSE_OK);
+    EXPECT_TRUE(std::isnan(value));
+    EXPECT_EQ(sv.length, 0);
+
+    for (const char *input : { "", "nope", ".", "-.e5", "e5", "+-1", "in" }) {
+        sv = fsv_from_cstr(input);
+        value = 42;
+        EXPECT_EQ(fsv_parse_f64(&sv, &value), FSV_PARSE_INVALID) << input;
+        EXPECT_EQ(value, 42);
+        EXPECT_STREQ(sv.datas, input);
+    }
+
+    // Digits after the end of the view are not read
+    sv = fsv_from_parts("1.25e+10", 4);
+    EXPECT_EQ(fsv_parse_f64(&sv, &value), FSV_PARSE_OK);
+    EXPECT_EQ(value, 1.25);
+    EXPECT_EQ(sv.length, 0);
+}
+
+TEST(fstring_view, fsv_parse_INVALID) {
+    for (const char *input : { "", "-", "+", "abc", " 1", "--1", "+-1", "-+1", "x123" }) {
+        fsv_t sv = fsv_from_cstr(input);
+        int64_t i = 42;
+        uint64_t u = 42;
+        EXPECT_EQ(fsv_parse_i64(&sv, &i), FSV_PARSE_INVALID) << input;
+        EXPECT_EQ(fsv_parse_u64(&sv, &u), FSV_PARSE_INVALID) << input;
+        EXPECT_EQ(i, 42);
+        EXPECT_EQ(u, 42);
+        EXPECT_STREQ(sv.datas, input);
+    }
+    fsv_t sv = fsv_from_cstr("-1");
+    uint64_t u = 0;
+    EXPECT_EQ(fsv_parse_u64(&sv, &u), FSV_PARSE_INVALID);
+
+    // Not NUL terminated: digits after the end of the view are not read
+    sv = fsv_from_parts("1234567890123", 3);
+    EXPECT_EQ(fsv_parse_u64(&sv, &u), FSV_PARSE_OK);
+    EXPECT_EQ(u, 123);
+    EXPECT_EQ(sv.length, 0);
+}
+
+TEST(fstring_view, fsv_hash_SAME_AS_EQ) {
+    const char alphabet[] = "@AZ[`az{\xC1\xDA\xE1\xFA";
+    for (size_t length = 0; length < 200; ++length) {
+        std::string a, b;
+        for (size_t i = 0; i < length; ++i) a += alphabet[rand()%(sizeof(alphabet) - 1)];
+        b = a;
+        for (char &c : b) c = isupper(c) ? tolower(c) : (islower(c) ? toupper(c) : c);
+
+        fsv_t sv1 = fsv_from_parts(a.c_str(), a.size());
+        fsv_t sv2 = fsv_from_parts(b.c_str(), b.size());
+        EXPECT_EQ(fsv_hash(sv1, 42, true), fsv_hash(sv2, 42, true)) << "a = " << a;
+        EXPECT_EQ(fsv_hash(sv1, 42, false) == fsv_hash(sv2, 42, false), a == b) << "a = " << a;
+        // Only depends on the bytes, not on where they are
+        std::string copy = "#" + a;
+        EXPECT_EQ(fsv_hash(sv1, 42, false), fsv_hash(fsv_from_parts(copy.c_str() + 1, length), 42, false));
+    }
+    EXPECT_EQ(fsv_hash(fsv_from_parts(NULL, 10), 0, false), fsv_hash(fsv_from_cstr(""), 0, false));
+    EXPECT_NE(fsv_hash(fsv_from_cstr("key"), 0, false), fsv_hash(fsv_from_cstr("key"), 1, false));
+    EXPECT_NE(fsv_hash(fsv_from_cstr("a"), 0, false), fsv_hash(fsv_from_parts("a", 2), 0, false));
+}
+
+TEST(fstring_view, fsv_hash_COLLISIONS) {
+    // Keys that only differ by a few bytes, like the ones of a real map
+    std::vector<uint64_t> hashes;
+    char key[64];
+    for (int i = 0; i < 300000; ++i) {
+        int length = snprintf(key, sizeof(key), "key_%d_%s", i, i % 2 ? "with a longer tail to hit the 48 bytes loop" : "");
+        hashes.push_back(fsv_hash(fsv_from_parts(key, length), 0, false));
+    }
+
+    // Low bits are the ones used by hash tables to pick a bucket
+    const size_t buckets = 1024;
+    std::vector<size_t> counts(buckets);
+    for (uint64_t hash : hashes) counts[hash % buckets] += 1;
+    double expected = (double)hashes.size()/buckets, chi2 = 0;
+    for (size_t count : counts) chi2 += (count - expected)*(count - expected)/expected;
+    // 1023 degrees of freedom, way past p = 0.001
+    EXPECT_LT(chi2, 1200);
+
+    std::sort(hashes.begin(), hashes.end());
+    EXPECT_EQ(std::adjacent_find(hashes.begin(), hashes.end()), hashes.end());
+}
+
+TEST(fstring_view, fsv_hash_AVALANCHE) {
+    // Flipping any input bit should flip every output bit with a probability close to 1/2
+    for (size_t length : { 1, 3, 4, 8, 15, 16, 17, 47, 48, 100 }) {
+        std::vector<size_t> flips(64);
+        size_t samples = 0;
+        for (int round = 0; round < 64; ++round) {
+            std::string input;
+            for (size_t i = 0; i < length; ++i) input += (char)rand();
+            uint64_t hash = fsv_hash(fsv_from_parts(input.c_str(), length), 0, false);
+            for (size_t bit = 0; bit < length*8; ++bit) {
+                input[bit/8] ^= (char)(1 << (bit%8));
+                uint64_t diff = hash ^ fsv_hash(fsv_from_parts(input.c_str(), length), 0, false);
+                input[bit/8] ^= (char)(1 << (bit%8));
+                for (size_t i = 0; i < 64; ++i) flips[i] += (diff >> i) & 1;
+                samples += 1;
+            }
+        }
+        for (size_t i = 0; i < 64; ++i) {
+            double ratio = (double)flips[i]/samples;
+            EXPECT_GT(ratio, 0.4) << "length = " << length << ", bit = " << i;
+            EXPECT_LT(ratio, 0.6) << "length = " << length << ", bit = " << i;
+        }
+    }
+}
+
 TEST(fstring_view, fsv_starts_with_CASE_SENSITIVE_FALSE) {
     fsv_t sv = fsv_from_cstr("THe QUIck bROwn FoX juMPS oVeR THe lazy DOg");
     const char *prefix = "The Quick";
@@ -522,6 +928,103 @@ TEST(fstring_view, fsv_split_FROM_EMPTY_STRING_AND_NULL) {
     EXPECT_EQ(fsv_tmp_save_point(), 0);
 }
 
+TEST(fstring_view, fsv_split_EVERY_SIMD_LEVEL) {
+    std::string cstr;
+    std::vector<std::string> expected;
+    const char spaces[] = " \t\n\v\f\r";
+    for (size_t i = 0; i < 200; ++i) {
+        expected.push_back(std::string(i%37, 'x'));
+        cstr += expected.back();
+        cstr += spaces[i%6];
+    }
+
+    fsv_simd_t best = fsv_simd_detect();
+    for (int simd = FSV_SIMD_SWAR; simd <= best; ++simd) {
+        fsv_simd_set((fsv_simd_t)simd);
+        fsv_t sv = fsv_from_partial_cstr(cstr.c_str(), cstr.size());
+        fsv_t ot = {};
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_TRUE(fsv_split(&sv, &ot));
+            EXPECT_TRUE(fexpect_sv_eq_cstr(ot, expected[i].c_str())) << "simd = " << simd;
+        }
+        EXPECT_FALSE(fsv_split(&sv, &ot));
+        EXPECT_EQ(sv.length, 0);
+    }
+    fsv_simd_set(best);
+}
+
+TEST(fstring_view, fsv_split_by_delim_EVERY_SIMD_LEVEL) {
+    std::string cstr;
+    for (size_t i = 0; i < 300; ++i) {
+        cstr += std::string(i%71, 'a' + i%26);
+        cstr += ',';
+    }
+    cstr += "tail";
+
+    fsv_simd_t best = fsv_simd_detect();
+    for (int simd = FSV_SIMD_SWAR; simd <= best; ++simd) {
+        fsv_simd_set((fsv_simd_t)simd);
+        fsv_t sv = fsv_from_partial_cstr(cstr.c_str(), cstr.size());
+        fsv_t ot = {};
+        for (size_t i = 0; i < 300; ++i) {
+            EXPECT_TRUE(fsv_split_by_delim(&sv, ',', &ot));
+            EXPECT_TRUE(fexpect_sv_eq_cstr(ot, std::string(i%71, 'a' + i%26).c_str())) << "simd = " << simd;
+        }
+        EXPECT_FALSE(fsv_split_by_delim(&sv, ',', &ot));
+        EXPECT_TRUE(fexpect_sv_eq_cstr(sv, "tail"));
+    }
+    fsv_simd_set(best);
+}
+
+TEST(fstring_view, fsv_split_by_any_LOG_LINE) {
+    const char *cstr   = "ts=1700000000;level=info, msg\tok";
+    fsv_delims_t delims = fsv_delims_from_cstr(" \t,;=");
+    fsv_t sv           = fsv_from_cstr(cstr);
+    fsv_t ot           = {};
+    const char *expected[] = { "ts", "1700000000", "level", "info", "", "msg" };
+
+    for (const char *token : expected) {
+        EXPECT_TRUE(fsv_split_by_any(&sv, &delims, &ot));
+        EXPECT_TRUE(fexpect_sv_eq_cstr(ot, token));
+    }
+    // After a fail split, input should be the same
+    // as before passing into the function
+    EXPECT_FALSE(fsv_split_by_any(&sv, &delims, &ot));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(ot, "msg"));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(sv, "ok"));
+}
+
+TEST(fstring_view, fsv_index_of_any_EVERY_SIMD_LEVEL) {
+    // Sets that can be bucketed by high nibble, by low nibble, or not at all
+    const char *sets[] = {
+        " \t,;=",
+        "\x01\x11\x21\x31\x41\x51\x61\x71\x81\x91\xA2",
+        "\x01\x12\x23\x34\x45\x56\x67\x78\x89\x9A\xAB\xBC\xCD\xDE\xEF\xF0",
+        "\xFF\x80\x7F",
+    };
+    std::string hay;
+    for (size_t i = 0; i < 1000; ++i) hay += (char)(rand()%255 + 1);
+
+    fsv_simd_t best = fsv_simd_detect();
+    for (const char *set : sets) {
+        fsv_delims_t delims = fsv_delims_from_cstr(set);
+        for (int simd = FSV_SIMD_SWAR; simd <= best; ++simd) {
+            fsv_simd_set((fsv_simd_t)simd);
+            for (size_t from = 0; from < hay.size(); ++from) {
+                size_t expected = hay.find_first_of(set, from);
+                fsv_t sv = fsv_from_parts(hay.c_str() + from, hay.size() - from);
+                EXPECT_EQ(fsv_index_of_any(sv, &delims), expected == std::string::npos ? -1 : (int)(expected - from))
+                    << "simd = " << simd << ", set = " << set << ", from = " << from;
+            }
+        }
+    }
+    fsv_simd_set(best);
+
+    EXPECT_TRUE(fsv_delims_from_cstr(sets[0]).vectorized);
+    EXPECT_TRUE(fsv_delims_from_cstr(sets[1]).vectorized);
+    EXPECT_FALSE(fsv_delims_from_cstr(sets[2]).vectorized);
+}
+
 TEST(fstring_view, fsv_split_by_delim_STARTS_AND_ENDS_WITH_DELIM) {
     const char *cstr  = "/home/user/some_folder/";
     char delim        = '/';
@@ -665,6 +1168,38 @@ TEST(fstring_view, fsv_split_by_cstr_SPLIT_BY_NULL_OR_EMPTY_STRING) {
     EXPECT_EQ(fsv_tmp_save_point(), 0);
 }
 
+TEST(fstring_view, fsv_split_by_cstr_IGNORE_CASE) {
+    const char *cstr = "key1 AND value1 and key2 AnD value2";
+    fsv_t sv         = fsv_from_cstr(cstr);
+    fsv_t ot         = {};
+
+    EXPECT_TRUE(fsv_split_by_cstr(&sv, " and ", true, &ot));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(ot, "key1"));
+    EXPECT_TRUE(fsv_split_by_cstr(&sv, " and ", true, &ot));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(ot, "value1"));
+    EXPECT_TRUE(fsv_split_by_cstr(&sv, " and ", true, &ot));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(ot, "key2"));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(sv, "value2"));
+    EXPECT_FALSE(fsv_split_by_cstr(&sv, " and ", true, &ot));
+}
+
+TEST(fstring_view, fsv_split_by_cstr_CRLF_LINES) {
+    std::string cstr;
+    for (size_t i = 0; i < 500; ++i) {
+        cstr += std::string(i%50, '\r');
+        cstr += "\r\n";
+    }
+
+    fsv_t sv = fsv_from_partial_cstr(cstr.c_str(), cstr.size());
+    fsv_t ot = {};
+    for (size_t i = 0; i < 500; ++i) {
+        EXPECT_TRUE(fsv_split_by_cstr(&sv, "\r\n", false, &ot));
+        EXPECT_EQ(ot.length, i%50);
+    }
+    EXPECT_FALSE(fsv_split_by_cstr(&sv, "\r\n", false, &ot));
+    EXPECT_EQ(sv.length, 0);
+}
+
 TEST(fstring_view, fsv_split_by_pair_NORMAL) {
     const char *cstr  = "THe QUIck bROwn FoX [juMPS] oVeR THe lazy DOg";
     fsv_t right       = fsv_from_cstr(cstr);
@@ -713,6 +1248,323 @@ TEST(fstring_view, fsv_split_by_pair_PAIR_AT_START_AND_END) {
     EXPECT_TRUE(fexpect_sv_eq_cstr(right, ""));
 }
 
+TEST(fstring_view_tokenizer, fsv_tokenizer_SAME_AS_SPLIT_BY_ANY) {
+    std::string cstr;
+    for (size_t i = 0; i < 5000; ++i) cstr += "ab ,;="[rand()%6];
+
+    const char *sets[] = { " ,;=", "\x01\x11\x21\x31\x41\x51\x61\x71\x81\x91\xA2 ,", "a" };
+    fsv_simd_t best = fsv_simd_detect();
+    for (const char *set : sets) {
+        fsv_delims_t delims = fsv_delims_from_cstr(set);
+        for (int simd = FSV_SIMD_SWAR; simd <= best; ++simd) {
+            fsv_simd_set((fsv_simd_t)simd);
+            // Every length so the tail of the last block is covered too
+            for (size_t length = 0; length < 200; ++length) {
+                fsv_t source = fsv_from_parts(cstr.c_str(), length);
+                fsv_tokenizer_t tokenizer = {};
+                fsv_tokenizer_scan(&tokenizer, source, &delims);
+
+                fsv_t sv = source, expected = {}, token = {};
+                while (fsv_split_by_any(&sv, &delims, &expected)) {
+                    EXPECT_TRUE(fsv_tokenizer_next(&tokenizer, &token));
+                    EXPECT_EQ(token.datas, expected.datas) << "simd = " << simd << ", length = " << length;
+                    EXPECT_EQ(token.length, expected.length) << "simd = " << simd << ", length = " << length;
+                }
+                EXPECT_FALSE(fsv_tokenizer_next(&tokenizer, &token));
+                fsv_t rest = fsv_tokenizer_rest(&tokenizer);
+                EXPECT_EQ(rest.length, sv.length);
+                if (sv.length > 0) {
+                    EXPECT_EQ(rest.datas, sv.datas);
+                }
+                fsv_tokenizer_free(&tokenizer);
+            }
+
+            fsv_tokenizer_t tokenizer = {};
+            size_t count = fsv_tokenizer_scan(&tokenizer, fsv_from_parts(cstr.c_str(), cstr.size()), &delims);
+            size_t expected = 0;
+            for (char c : cstr) expected += delims.table[(uint8_t)c];
+            EXPECT_EQ(count, expected);
+            fsv_tokenizer_free(&tokenizer);
+        }
+    }
+    fsv_simd_set(best);
+}
+
+TEST(fstring_view_tokenizer, fsv_tokenizer_REUSE) {
+    fsv_delims_t delims = fsv_delims_from_cstr(",");
+    fsv_tokenizer_t tokenizer = {};
+    fsv_t token = {};
+
+    EXPECT_EQ(fsv_tokenizer_scan(&tokenizer, fsv_from_cstr("a,b,c"), &delims), 2);
+    EXPECT_TRUE(fsv_tokenizer_next(&tokenizer, &token));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(token, "a"));
+
+    // Scanning again starts over and keeps the memory
+    size_t capacity = tokenizer.capacity;
+    EXPECT_EQ(fsv_tokenizer_scan(&tokenizer, fsv_from_cstr("x,,y"), &delims), 2);
+    EXPECT_EQ(tokenizer.capacity, capacity);
+    EXPECT_TRUE(fsv_tokenizer_next(&tokenizer, &token));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(token, "x"));
+    EXPECT_TRUE(fsv_tokenizer_next(&tokenizer, &token));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(token, ""));
+    EXPECT_FALSE(fsv_tokenizer_next(&tokenizer, &token));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(fsv_tokenizer_rest(&tokenizer), "y"));
+
+    fsv_tokenizer_free(&tokenizer);
+    EXPECT_EQ(tokenizer.datas, nullptr);
+    EXPECT_EQ(tokenizer.capacity, 0);
+    EXPECT_EQ(tokenizer.size, 0);
+}
+
+TEST(fstring_view_tokenizer, fsv_split_parallel_SAME_AS_SPLIT_BY_DELIM) {
+    std::string cstr;
+    for (size_t i = 0; i < 1024*1024; ++i) cstr += (rand()%32 == 0) ? '\n' : 'a' + rand()%26;
+    std::string no_delim(512*1024, 'x');
+    std::string only_delim(512*1024, '\n');
+
+    fsv_delims_t delims = fsv_delims_from_cstr("\n");
+    for (const std::string *input : { &cstr, &no_delim, &only_delim }) {
+        for (size_t threads : { 0, 1, 3, 8 }) {
+            fsv_t source = fsv_from_parts(input->data(), input->size());
+            fsv_partitions_t partitions = {};
+            size_t count = fsv_split_parallel(source, &delims, threads, &partitions);
+            EXPECT_GE(partitions.size, 1);
+
+            fsv_t sv = source, expected = {}, token = {};
+            size_t partition = 0, tokens = 0;
+            while (fsv_split_by_delim(&sv, '\n', &expected)) {
+                while (!fsv_tokenizer_next(&partitions.datas[partition], &token)) {
+                    // Only the last partition may have something left
+                    EXPECT_EQ(fsv_tokenizer_rest(&partitions.datas[partition]).length, 0);
+                    partition += 1;
+                    ASSERT_LT(partition, partitions.size);
+                }
+                EXPECT_EQ(token.datas, expected.datas);
+                EXPECT_EQ(token.length, expected.length);
+                tokens += 1;
+            }
+            EXPECT_EQ(count, tokens);
+            EXPECT_EQ(partition + 1, partitions.size) << "threads = " << threads;
+            fsv_t rest = fsv_tokenizer_rest(&partitions.datas[partitions.size - 1]);
+            EXPECT_EQ(rest.length, sv.length);
+            fsv_partitions_free(&partitions);
+        }
+    }
+
+    fsv_partitions_t partitions = {};
+    EXPECT_EQ(fsv_split_parallel(fsv_from_cstr("a\nb"), &delims, 4, &partitions), 1);
+    EXPECT_EQ(partitions.size, 1);
+    fsv_partitions_free(&partitions);
+    EXPECT_EQ(partitions.datas, nullptr);
+}
+
+TEST(fstring_view_map, fsv_map_SAME_AS_UNORDERED_MAP) {
+    // Keys must outlive the map
+    std::vector<std::string> keys;
+    for (int i = 0; i < 3000; ++i) keys.push_back("key_" + std::to_string(i*7919 % 3001));
+
+    fsv_simd_t best = fsv_simd_detect();
+    for (int simd = FSV_SIMD_SWAR; simd <= best; ++simd) {
+        fsv_simd_set((fsv_simd_t)simd);
+        fsv_map_t map = {};
+        std::unordered_map<std::string, void*> expected;
+        // Lots of removals so tombstones get reused and cleaned up
+        for (int round = 0; round < 50000; ++round) {
+            const std::string &key = keys[rand() % (round < 25000 ? keys.size() : 100)];
+            fsv_t sv = fsv_from_parts(key.c_str(), key.size());
+            void *value = (void*)(uintptr_t)round;
+            switch (rand() % 3) {
+            case 0:
+                EXPECT_EQ(fsv_map_put(&map, sv, value), expected.count(key) == 0);
+                expected[key] = value;
+                break;
+            case 1:
+                EXPECT_EQ(fsv_map_remove(&map, sv), expected.erase(key) == 1);
+                break;
+            case 2: {
+                void *got = NULL;
+                auto it = expected.find(key);
+                EXPECT_EQ(fsv_map_get(&map, sv, &got), it != expected.end());
+                if (it != expected.end()) {
+                    EXPECT_EQ(got, it->second);
+                }
+            } break;
+            }
+            ASSERT_EQ(map.size, expected.size()) << "simd = " << simd << ", round = " << round;
+        }
+        EXPECT_LE(map.size + map.tombstones, map.capacity/8*7);
+
+        size_t cursor = 0, count = 0;
+        fsv_map_entry_t *entry = NULL;
+        while (fsv_map_next(&map, &cursor, &entry)) {
+            auto it = expected.find(std::string(entry->key.datas, entry->key.length));
+            ASSERT_NE(it, expected.end());
+            EXPECT_EQ(entry->value, it->second);
+            count += 1;
+        }
+        EXPECT_EQ(count, expected.size());
+        fsv_map_free(&map);
+    }
+    fsv_simd_set(best);
+}
+
+TEST(fstring_view_map, fsv_map_IGNORE_CASE) {
+    fsv_map_t map = {};
+    map.ignore_case = true;
+    int a = 1, b = 2;
+    EXPECT_TRUE(fsv_map_put(&map, fsv_from_cstr("Content-Type"), &a));
+    EXPECT_FALSE(fsv_map_put(&map, fsv_from_cstr("content-type"), &b));
+    EXPECT_TRUE(fsv_map_put(&map, fsv_from_cstr(""), &a));
+
+    void *value = NULL;
+    EXPECT_TRUE(fsv_map_get(&map, fsv_from_cstr("CONTENT-TYPE"), &value));
+    EXPECT_EQ(value, &b);
+    EXPECT_TRUE(fsv_map_get(&map, fsv_from_parts(NULL, 0), &value));
+    EXPECT_EQ(value, &a);
+    EXPECT_FALSE(fsv_map_get(&map, fsv_from_cstr("Content_Type"), &value));
+    EXPECT_EQ(map.size, 2);
+
+    bool inserted = true;
+    fsv_map_entry_t *entry = fsv_map_insert(&map, fsv_from_cstr("content-TYPE"), &inserted);
+    EXPECT_FALSE(inserted);
+    EXPECT_TRUE(fexpect_sv_eq_cstr(entry->key, "Content-Type"));
+
+    fsv_map_clear(&map);
+    EXPECT_EQ(map.size, 0);
+    EXPECT_EQ(fsv_map_find(&map, fsv_from_cstr("content-type")), nullptr);
+    fsv_map_free(&map);
+    EXPECT_EQ(map.datas, nullptr);
+    EXPECT_EQ(map.capacity, 0);
+    EXPECT_EQ(fsv_map_find(&map, fsv_from_cstr("content-type")), nullptr);
+    EXPECT_FALSE(fsv_map_remove(&map, fsv_from_cstr("content-type")));
+}
+
+static size_t count_arena_blocks(const fsv_arena_t *arena) {
+    size_t count = 0;
+    for (fsv_arena_block_t *block = arena->first; block != NULL; block = block->next) count += 1;
+    return count;
+}
+
+TEST(fstring_view_arena, fsv_arena_alloc) {
+    fsv_arena_t arena = {};
+    arena.block_size = 1024;
+
+    std::vector<std::pair<char*, size_t>> allocations;
+    for (size_t i = 0; i < 1000; ++i) {
+        size_t size = i % 10 == 0 ? 3000 : 1 + rand() % 100;
+        char *datas = (char*) fsv_arena_alloc(&arena, size);
+        EXPECT_EQ((uintptr_t)datas % FSV_ARENA_ALIGN, 0);
+        memset(datas, (int)i, size);
+        allocations.push_back({ datas, size });
+    }
+    // Nothing got overwritten
+    for (size_t i = 0; i < allocations.size(); ++i) {
+        for (size_t j = 0; j < allocations[i].second; ++j) ASSERT_EQ(allocations[i].first[j], (char)i);
+    }
+    EXPECT_EQ((uintptr_t)fsv_arena_alloc_aligned(&arena, 1, 64) % 64, 0);
+
+    // Same allocations after a reset fit in the blocks we already have
+    size_t blocks = count_arena_blocks(&arena);
+    fsv_arena_reset(&arena);
+    for (size_t i = 0; i < 100; ++i) fsv_arena_alloc(&arena, 100);
+    EXPECT_EQ(count_arena_blocks(&arena), blocks);
+
+    fsv_t copy = fsv_arena_sv_dup(&arena, fsv_from_cstr("Hello"));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(copy, "Hello"));
+    EXPECT_EQ(copy.datas[copy.length], '\0');
+    EXPECT_EQ(fsv_arena_sv_dup(&arena, fsv_from_parts(NULL, 10)).length, 0);
+
+    fsv_arena_free(&arena);
+    EXPECT_EQ(arena.first, nullptr);
+    EXPECT_EQ(arena.current, nullptr);
+}
+
+TEST(fstring_view_arena, fsv_arena_allocator) {
+    fsv_arena_t arena = {};
+    fsv_allocator_t allocator = fsv_arena_allocator(&arena);
+
+    fsb_t sb = {};
+    sb.allocator = &allocator;
+    std::string expected;
+    for (int i = 0; i < 1000; ++i) {
+        fsb_append_i64(&sb, i);
+        expected += std::to_string(i);
+    }
+    EXPECT_EQ(std::string(sb.datas, sb.length), expected);
+    // Grown in place at the end of the block, not copied 10 times
+    EXPECT_LE(count_arena_blocks(&arena), 2);
+
+    ffp_t fp = {};
+    fp.allocator = &allocator;
+    EXPECT_TRUE(fsb_read_entire_dir("../../", &fp, false));
+    EXPECT_NE(fp.size, 0);
+    for (size_t i = 0; i < fp.size; ++i) EXPECT_EQ(fp.datas[i].name.allocator, &allocator);
+
+    // Everything goes away with the arena, `fda_free_a` keeps the allocator
+    fda_free_a(&sb);
+    EXPECT_EQ(sb.allocator, &allocator);
+    fsv_arena_free(&arena);
+}
+
+TEST(fstring_view_arena, fsv_pool_allocator) {
+    fsv_pool_t pool = {};
+    pool.slot_size = 64;
+
+    void *a = fsv_pool_alloc(&pool);
+    void *b = fsv_pool_alloc(&pool);
+    EXPECT_NE(a, b);
+    EXPECT_EQ((uintptr_t)a % FSV_ARENA_ALIGN, 0);
+    fsv_pool_release(&pool, a);
+    EXPECT_EQ(fsv_pool_alloc(&pool), a);
+
+    fsv_allocator_t allocator = fsv_pool_allocator(&pool);
+    fsb_t sb = {};
+    sb.allocator = &allocator;
+    fsb_append_cstr(&sb, "The quick brown fox");
+    char *datas = sb.datas;
+    fsb_append_cstr(&sb, " jumps over the lazy dog");
+    EXPECT_EQ(sb.datas, datas);
+    EXPECT_STREQ(sb.datas, "The quick brown fox jumps over the lazy dog");
+    fsb_free(&sb);
+    // Its slot is the next one handed out
+    EXPECT_EQ(fsv_pool_alloc(&pool), datas);
+    EXPECT_EQ(fsv_allocator_alloc(&allocator, 65), nullptr);
+
+    fsv_pool_free(&pool);
+}
+
+TEST(fstring_view_interner, fsv_intern) {
+    fsv_interner_t interner = {};
+    std::vector<std::string> words;
+    for (int i = 0; i < 10000; ++i) words.push_back("word_" + std::to_string(i % 1000));
+
+    std::vector<fsv_atom_t> atoms;
+    for (const std::string &word : words) atoms.push_back(fsv_intern(&interner, fsv_from_parts(word.c_str(), word.size())));
+    EXPECT_EQ(interner.atoms.size, 1000);
+    for (size_t i = 0; i < words.size(); ++i) {
+        EXPECT_EQ(atoms[i], atoms[i % 1000]);
+        EXPECT_EQ(atoms[i], i % 1000);
+    }
+
+    // Interned strings do not depend on the memory they came from
+    std::string temporary = "status=200";
+    fsv_atom_t status = fsv_intern(&interner, fsv_from_parts(temporary.c_str(), temporary.size()));
+    temporary.assign(temporary.size(), '#');
+    EXPECT_TRUE(fexpect_sv_eq_cstr(fsv_atom_sv(&interner, status), "status=200"));
+    EXPECT_STREQ(fsv_atom_sv(&interner, status).datas, "status=200");
+    EXPECT_EQ(fsv_intern_cstr(&interner, "status=200"), status);
+
+    fsv_atom_t atom = 0;
+    EXPECT_TRUE(fsv_interner_find(&interner, fsv_from_cstr("word_42"), &atom));
+    EXPECT_EQ(atom, atoms[42]);
+    EXPECT_FALSE(fsv_interner_find(&interner, fsv_from_cstr("word_1000"), &atom));
+    EXPECT_EQ(fsv_intern(&interner, fsv_from_parts(NULL, 0)), fsv_intern_cstr(&interner, ""));
+
+    fsv_interner_free(&interner);
+    EXPECT_EQ(interner.atoms.size, 0);
+    EXPECT_EQ(interner.map.size, 0);
+}
+
 TEST(fstring_builder, MACRO_fda_append) {
     fsb_t sb = {};
 
@@ -755,6 +1607,21 @@ TEST(fstring_builder, MACRO_fda_reserve) {
     EXPECT_EQ(sb.length, 0);
 }
 
+TEST(fstring_builder, MACRO_fda_WITHOUT_ALLOCATOR) {
+    // Plain user arrays don't need an `allocator` field
+    struct {
+        size_t size, capacity;
+        int *datas;
+    } ints = {};
+    for (int i = 0; i < 100; ++i) fda_append(&ints, i);
+    fda_reserve(&ints, 1000);
+    EXPECT_EQ(ints.size, 100);
+    EXPECT_EQ(ints.capacity, 1000);
+    EXPECT_EQ(ints.datas[99], 99);
+    fda_free(&ints);
+    EXPECT_EQ(ints.datas, nullptr);
+}
+
 TEST(fstring_builder, fsb_read_entire_file_TEST) {
     fsb_t sb = {};
     // The test is ran in `build` folder under `unit_tests` folder
@@ -772,6 +1639,93 @@ TEST(fstring_builder, fsb_read_entire_file_TEST) {
     EXPECT_EQ(sb.length, 0);
 }
 
+TEST(fstring_builder, fsv_mmap_file_TEST) {
+    fsb_t sb = {};
+    fsv_t sv = {};
+    const char *file_path = "../../fsv.h";
+
+    EXPECT_TRUE(fsb_read_entire_file(file_path, &sb));
+    EXPECT_TRUE(fsv_mmap_file(file_path, FSV_MMAP_SEQUENTIAL | FSV_MMAP_WILLNEED | FSV_MMAP_HUGEPAGES, &sv));
+    EXPECT_TRUE(fsv_eq(sv, fsv_from_sb(sb), false));
+    fsv_munmap_file(&sv);
+    EXPECT_EQ(sv.datas, nullptr);
+    EXPECT_EQ(sv.length, 0);
+    fsb_free(&sb);
+
+    FILE *empty = fopen("fsv_mmap_empty.txt", "wb");
+    ASSERT_NE(empty, nullptr);
+    fclose(empty);
+    EXPECT_TRUE(fsv_mmap_file("fsv_mmap_empty.txt", FSV_MMAP_NORMAL, &sv));
+    EXPECT_EQ(sv.length, 0);
+    fsv_munmap_file(&sv);
+    remove("fsv_mmap_empty.txt");
+
+    EXPECT_FALSE(fsv_mmap_file("fsv_mmap_does_not_exist.txt", FSV_MMAP_NORMAL, &sv));
+    EXPECT_EQ(sv.length, 0);
+}
+
+static std::string read_all_windows(const char *file_path, size_t chunk_size, char delim, size_t *windows) {
+    fsv_reader_t reader = {};
+    std::string ret;
+    *windows = 0;
+    if (!fsv_reader_open(&reader, file_path, chunk_size, delim)) return "<failed>";
+    fsv_t window = {};
+    while (fsv_reader_next(&reader, &window)) {
+        EXPECT_LE(window.length, 2*reader.chunk_size);
+        ret.append(window.datas, window.length);
+        (*windows)++;
+    }
+    fsv_reader_close(&reader);
+    return ret;
+}
+
+TEST(fstring_builder, fsv_reader_TEST) {
+    const char *file_path = "fsv_reader_test.txt";
+    std::string content;
+    for (int i = 0; i < 5000; ++i) content += "line " + std::to_string(i) + std::string(i % 37, 'x') + "\n";
+    content += "no newline at the end";
+    FILE *file = fopen(file_path, "wb");
+    ASSERT_NE(file, nullptr);
+    fwrite(content.data(), 1, content.size(), file);
+    fclose(file);
+
+    // Every window but the last one ends with a whole line
+    fsv_reader_t reader = {};
+    ASSERT_TRUE(fsv_reader_open(&reader, file_path, 256, '\n'));
+    fsv_t window = {}, line = {};
+    std::string lines;
+    size_t windows = 0;
+    bool whole_lines = true;
+    while (fsv_reader_next(&reader, &window)) {
+        if (reader.eof == false) whole_lines &= window.datas[window.length - 1] == '\n';
+        while (fsv_split_by_delim(&window, '\n', &line)) lines.append(line.datas, line.length).append("\n");
+        // Only the last window has an unfinished line left
+        lines.append(window.datas, window.length);
+        windows++;
+    }
+    fsv_reader_close(&reader);
+    EXPECT_TRUE(whole_lines);
+    EXPECT_EQ(lines, content);
+    EXPECT_GT(windows, content.size()/512);
+
+    // Records longer than a chunk are split but nothing is lost
+    EXPECT_EQ(read_all_windows(file_path, 16, '\n', &windows), content);
+    EXPECT_EQ(read_all_windows(file_path, 7, '#', &windows), content);
+    EXPECT_EQ(read_all_windows(file_path, 0, '\n', &windows), content);
+    EXPECT_EQ(windows, 1);
+    remove(file_path);
+
+    file = fopen(file_path, "wb");
+    fclose(file);
+    EXPECT_EQ(read_all_windows(file_path, 64, '\n', &windows), "");
+    EXPECT_EQ(windows, 0);
+    remove(file_path);
+
+    EXPECT_FALSE(fsv_reader_open(&reader, "fsv_reader_does_not_exist.txt", 64, '\n'));
+    EXPECT_FALSE(fsv_reader_next(&reader, &window));
+    fsv_reader_close(&reader);
+}
+
 TEST(fstring_builder, fsb_read_entire_dir_TEST) {
     ffp_t fp = {};
     const char *file_path = "../../";
@@ -799,7 +1753,631 @@ TEST(fstring_builder, fsb_read_entire_dir_TEST) {
     EXPECT_EQ(fp.size, 0);
 }
 
+static std::vector<std::pair<std::string, bool>> sorted_entities(const ffp_t *fp) {
+    std::vector<std::pair<std::string, bool>> ret;
+    for (size_t i = 0; i < fp->size; ++i) ret.push_back({ fp->datas[i].name.datas, fp->datas[i].is_dir });
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
+TEST(fstring_builder, fsb_read_entire_dir_TREE) {
+#ifndef _WIN32
+    // POSIX walkers only: Windows joins with '\\', follows directory links and drops trailing dots
+    namespace fs = std::filesystem;
+    fs::remove_all("fsv_dir_test");
+    fs::create_directories("fsv_dir_test/a/b/c");
+    fs::create_directories("fsv_dir_test/empty");
+    for (const char *file : { "f1", "dot.", "..hidden", "a/f2", "a/b/f3", "a/b/c/f4" }) {
+        FILE *f = fopen((std::string("fsv_dir_test/") + file).c_str(), "wb");
+        ASSERT_NE(f, nullptr);
+        fclose(f);
+    }
+    // Not followed, listed as a file like lstat would say
+    fs::create_directory_symlink("a", "fsv_dir_test/link");
+
+    ffp_t fp = {};
+    EXPECT_TRUE(fsb_read_entire_dir("fsv_dir_test", &fp, false));
+    std::vector<std::pair<std::string, bool>> expected = {
+        { "fsv_dir_test/..hidden", false }, { "fsv_dir_test/a", true }, { "fsv_dir_test/dot.", false },
+        { "fsv_dir_test/empty", true }, { "fsv_dir_test/f1", false }, { "fsv_dir_test/link", false },
+    };
+    EXPECT_EQ(sorted_entities(&fp), expected);
+    ffp_free(&fp);
+
+    EXPECT_TRUE(fsb_read_entire_dir("fsv_dir_test/", &fp, true));
+    expected = {
+        { "fsv_dir_test/..hidden", false }, { "fsv_dir_test/a/b/c/f4", false }, { "fsv_dir_test/a/b/f3", false },
+        { "fsv_dir_test/a/f2", false }, { "fsv_dir_test/dot.", false }, { "fsv_dir_test/f1", false },
+        { "fsv_dir_test/link", false },
+    };
+    EXPECT_EQ(sorted_entities(&fp), expected);
+    ffp_free(&fp);
+
+    EXPECT_FALSE(fsb_read_entire_dir("fsv_dir_test/f1", &fp, true));
+    fs::remove_all("fsv_dir_test");
+#endif // _WIN32
+}
+
+static void touch(const std::string &path) {
+    FILE *f = fopen(path.c_str(), "wb");
+    ASSERT_NE(f, nullptr);
+    fclose(f);
+}
+
+// Walkers join with the platform separator
+static std::string native_path(std::string path) {
+#ifdef _WIN32
+    std::replace(path.begin(), path.end(), '/', '\\');
+#endif // _WIN32
+    return path;
+}
+
+static std::vector<std::pair<std::string, bool>> fpt_entities(const fpt_t *table, bool only_files) {
+    std::vector<std::pair<std::string, bool>> ret;
+    fsb_t path = {};
+    // Entity 0 is the listed directory itself
+    for (size_t i = 1; i < table->size; ++i) {
+        if (only_files && table->datas[i].is_dir) continue;
+        path.length = 0;
+        fpt_append_path(table, i, &path);
+        EXPECT_EQ(path.datas[path.length], '\0');
+        ret.push_back({ std::string(path.datas, path.length), (bool)table->datas[i].is_dir });
+    }
+    fsb_free(&path);
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
+TEST(fstring_builder, fpt_read_entire_dir_TEST) {
+    namespace fs = std::filesystem;
+    fs::remove_all("fsv_fpt_test");
+    fs::create_directories("fsv_fpt_test/a/b/c");
+    fs::create_directories("fsv_fpt_test/empty");
+    for (const char *file : { "f1", "a/f2", "a/b/f3", "a/b/c/f4" }) {
+        FILE *f = fopen((std::string("fsv_fpt_test/") + file).c_str(), "wb");
+        ASSERT_NE(f, nullptr);
+        fclose(f);
+    }
+#ifndef _WIN32
+    // Windows drops the trailing dot and follows directory links
+    touch("fsv_fpt_test/dot.");
+    fs::create_directory_symlink("a", "fsv_fpt_test/link");
+#endif // _WIN32
+
+    for (bool recursive : { false, true }) {
+        ffp_t fp = {};
+        fpt_t table = {};
+        EXPECT_TRUE(fsb_read_entire_dir("fsv_fpt_test", &fp, recursive));
+        EXPECT_TRUE(fpt_read_entire_dir("fsv_fpt_test/", &table, recursive));
+        EXPECT_TRUE(fexpect_sv_eq_cstr(fpt_name(&table, 0), "fsv_fpt_test"));
+        EXPECT_EQ(table.datas[0].parent, FPT_NO_PARENT);
+        EXPECT_EQ(fpt_entities(&table, recursive), sorted_entities(&fp)) << "recursive = " << recursive;
+        // Parents always come first
+        for (size_t i = 1; i < table.size; ++i) EXPECT_LT(table.datas[i].parent, i);
+        ffp_free(&fp);
+        fpt_free(&table);
+    }
+
+    fpt_t table = {};
+    EXPECT_TRUE(fpt_read_entire_dir(native_path("fsv_fpt_test/a/b").c_str(), &table, true));
+    std::vector<std::pair<std::string, bool>> expected = {
+        { native_path("fsv_fpt_test/a/b/c"), true }, { native_path("fsv_fpt_test/a/b/c/f4"), false },
+        { native_path("fsv_fpt_test/a/b/f3"), false },
+    };
+    EXPECT_EQ(fpt_entities(&table, false), expected);
+    fpt_free(&table);
+    EXPECT_EQ(table.datas, nullptr);
+    EXPECT_EQ(table.names.datas, nullptr);
+
+    EXPECT_FALSE(fpt_read_entire_dir("fsv_fpt_does_not_exist", &table, true));
+    fpt_free(&table);
+    fs::remove_all("fsv_fpt_test");
+}
+
+static bool count_until_limit(void *ctx, size_t worker, fsv_t path, bool is_dir) {
+    (void)worker;
+    (void)path;
+    (void)is_dir;
+    return __atomic_add_fetch((size_t*)ctx, 1, __ATOMIC_RELAXED) < 10;
+}
+
+TEST(fstring_builder, fsb_read_entire_dir_parallel_TEST) {
+    namespace fs = std::filesystem;
+    fs::remove_all("fsv_walk_test");
+    std::vector<std::pair<std::string, bool>> expected;
+    for (int i = 0; i < 20; ++i) {
+        std::string dir = "fsv_walk_test/d" + std::to_string(i) + "/sub" + std::to_string(i % 3);
+        fs::create_directories(dir);
+        for (int j = 0; j < i; ++j) {
+            std::string file = dir + "/f" + std::to_string(j);
+            FILE *f = fopen(file.c_str(), "wb");
+            ASSERT_NE(f, nullptr);
+            fclose(f);
+            expected.push_back({ native_path(file), false });
+        }
+    }
+#ifndef _WIN32
+    // Windows follows directory links
+    fs::create_directory_symlink("d1", "fsv_walk_test/link");
+    expected.push_back({ "fsv_walk_test/link", false });
+#endif // _WIN32
+    std::sort(expected.begin(), expected.end());
+
+    ffp_t sequential = {};
+    EXPECT_TRUE(fsb_read_entire_dir("fsv_walk_test", &sequential, true));
+    EXPECT_EQ(sorted_entities(&sequential), expected);
+    ffp_free(&sequential);
+
+    for (size_t threads : { 0, 1, 3, 8 }) {
+        ffp_t fp = {};
+        EXPECT_TRUE(fsb_read_entire_dir_parallel("fsv_walk_test", &fp, threads, true));
+        ASSERT_EQ(fp.size, expected.size()) << "threads = " << threads;
+        // Sorted already, no need to sort it here
+        for (size_t i = 0; i < fp.size; ++i) {
+            EXPECT_EQ(std::string(fp.datas[i].name.datas), expected[i].first);
+            EXPECT_FALSE(fp.datas[i].is_dir);
+        }
+        ffp_free(&fp);
+    }
+
+    for (size_t threads : { 1, 4 }) {
+        size_t calls = 0;
+        EXPECT_TRUE(fsv_walk_parallel("fsv_walk_test", threads, count_until_limit, &calls));
+        EXPECT_GE(calls, 10);
+        EXPECT_LE(calls, 10 + threads - 1);
+    }
+
+    ffp_t fp = {};
+    EXPECT_FALSE(fsb_read_entire_dir_parallel("fsv_walk_does_not_exist", &fp, 4, true));
+    EXPECT_EQ(fp.size, 0);
+    fs::remove_all("fsv_walk_test");
+}
+
+static std::vector<std::string> watch_changes(const fsv_watch_t *watch, uint64_t generation) {
+    std::vector<std::string> ret;
+    const fsv_watch_change_t *changes = NULL;
+    size_t count = 0;
+    EXPECT_TRUE(fsv_watch_changes_since(watch, generation, &changes, &count));
+    for (size_t i = 0; i < count; ++i) {
+        ret.push_back(std::string(changes[i].added ? "+" : "-") + changes[i].path.datas);
+    }
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
+static void expect_watch_matches_tree(const fsv_watch_t *watch) {
+    ffp_t fp = {};
+    EXPECT_TRUE(fsb_read_entire_dir(watch->root.datas, &fp, true));
+    EXPECT_EQ(sorted_entities(&watch->files), sorted_entities(&fp));
+    ffp_free(&fp);
+}
+
+TEST(fstring_builder, fsv_watch_TEST) {
+    namespace fs = std::filesystem;
+    fs::remove_all("fsv_watch_test");
+    fs::create_directories("fsv_watch_test/a");
+    touch("fsv_watch_test/f1");
+    touch("fsv_watch_test/a/f2");
+
+    fsv_watch_t watch = {};
+    ASSERT_TRUE(fsv_watch_open(&watch, "fsv_watch_test"));
+    EXPECT_EQ(watch.generation, 0);
+    expect_watch_matches_tree(&watch);
+
+    touch("fsv_watch_test/f3");
+    fs::create_directories("fsv_watch_test/b/c");
+    touch("fsv_watch_test/b/c/f4");
+    fs::remove("fsv_watch_test/f1");
+    EXPECT_TRUE(fsv_watch_poll(&watch));
+    expect_watch_matches_tree(&watch);
+    std::vector<std::string> expected = {
+        native_path("+fsv_watch_test/b/c/f4"),
+        native_path("+fsv_watch_test/f3"),
+        native_path("-fsv_watch_test/f1"),
+    };
+    EXPECT_EQ(watch_changes(&watch, 0), expected);
+
+    // Files in a moved directory are removed and added again under the new name
+    uint64_t seen = watch.generation;
+    fs::rename("fsv_watch_test/b", "fsv_watch_test/a/b");
+    touch("fsv_watch_test/a/b/c/f5");
+    EXPECT_TRUE(fsv_watch_poll(&watch));
+    expect_watch_matches_tree(&watch);
+    expected = {
+        native_path("+fsv_watch_test/a/b/c/f4"),
+        native_path("+fsv_watch_test/a/b/c/f5"),
+        native_path("-fsv_watch_test/b/c/f4"),
+    };
+    EXPECT_EQ(watch_changes(&watch, seen), expected);
+    EXPECT_TRUE(watch_changes(&watch, watch.generation).empty());
+
+    seen = watch.generation;
+    fs::remove_all("fsv_watch_test/a");
+    EXPECT_TRUE(fsv_watch_poll(&watch));
+    expect_watch_matches_tree(&watch);
+    expected = {
+        native_path("-fsv_watch_test/a/b/c/f4"),
+        native_path("-fsv_watch_test/a/b/c/f5"),
+        native_path("-fsv_watch_test/a/f2"),
+    };
+    EXPECT_EQ(watch_changes(&watch, seen), expected);
+
+#ifdef __linux__
+    // Only live directories are tracked, however many came and went
+    for (int i = 0; i < 20; ++i) {
+        fs::create_directories("fsv_watch_test/tmp/d");
+        touch("fsv_watch_test/tmp/d/f");
+        EXPECT_TRUE(fsv_watch_poll(&watch));
+        fs::remove_all("fsv_watch_test/tmp");
+        EXPECT_TRUE(fsv_watch_poll(&watch));
+    }
+    expect_watch_matches_tree(&watch);
+    EXPECT_EQ(watch.dirs.size, 1);
+    EXPECT_EQ(watch.watches.size, 1);
+    EXPECT_EQ(watch.owners.size, watch.files.size);
+#endif // __linux__
+
+    // A resync drops the queued events and logs the difference instead
+    seen = watch.generation;
+    touch("fsv_watch_test/f6");
+    fs::remove("fsv_watch_test/f3");
+    EXPECT_TRUE(fsv_watch_resync(&watch));
+    EXPECT_TRUE(fsv_watch_poll(&watch));
+    expect_watch_matches_tree(&watch);
+    expected = { native_path("+fsv_watch_test/f6"), native_path("-fsv_watch_test/f3") };
+    EXPECT_EQ(watch_changes(&watch, seen), expected);
+
+    // Nothing changed
+    seen = watch.generation;
+    EXPECT_TRUE(fsv_watch_poll(&watch));
+    EXPECT_EQ(watch.generation, seen);
+
+    fsv_watch_close(&watch);
+    EXPECT_EQ(watch.files.datas, nullptr);
+    EXPECT_EQ(watch.changes.datas, nullptr);
+    fs::remove_all("fsv_watch_test");
+}
+
+TEST(fstring_builder, fsb_read_entire_files_TEST) {
+    namespace fs = std::filesystem;
+    fs::remove_all("fsv_batch_test");
+    fs::create_directories("fsv_batch_test/dir");
+    ffp_t files = {};
+    std::vector<std::string> expected;
+    for (size_t i = 0; i < 50; ++i) {
+        // Empty, small and bigger than one read
+        std::string content(i*i*37, (char)('a' + i % 26));
+        std::string path = "fsv_batch_test/f" + std::to_string(i);
+        FILE *f = fopen(path.c_str(), "wb");
+        ASSERT_NE(f, nullptr);
+        fwrite(content.data(), 1, content.size(), f);
+        fclose(f);
+        ffe_t file = {};
+        file.name = fsb_from_sv(fsv_from_cstr(path.c_str()));
+        fda_append(&files, file);
+        expected.push_back(content);
+    }
+
+    for (size_t threads : { 1, 4 }) {
+        std::vector<fsb_t> contents(files.size);
+        std::vector<int> errors(files.size, -1);
+        // Appended like `fsb_read_entire_file`
+        fsb_append_cstr(&contents[0], "head:");
+        EXPECT_TRUE(ffp_read_entire_files(&files, contents.data(), errors.data(), threads));
+        EXPECT_TRUE(fexpect_sv_eq_cstr(fsv_from_sb(contents[0]), "head:"));
+        for (size_t i = 0; i < files.size; ++i) {
+            EXPECT_EQ(errors[i], 0);
+            if (i > 0) {
+                EXPECT_EQ(std::string(contents[i].datas, contents[i].length), expected[i]);
+            }
+            EXPECT_EQ(contents[i].datas[contents[i].length], '\0');
+            fsb_free(&contents[i]);
+        }
+    }
+
+    const char *paths[] = { "fsv_batch_test/f3", "fsv_batch_does_not_exist", "fsv_batch_test/dir" };
+    fsb_t contents[3] = {};
+    int errors[3] = {};
+    EXPECT_FALSE(fsb_read_entire_files(paths, 3, contents, errors, 0));
+    EXPECT_EQ(errors[0], 0);
+    EXPECT_EQ(std::string(contents[0].datas, contents[0].length), expected[3]);
+    EXPECT_EQ(errors[1], ENOENT);
+    EXPECT_EQ(contents[1].length, 0);
+    EXPECT_NE(errors[2], 0);
+    EXPECT_EQ(contents[2].length, 0);
+    for (fsb_t &sb : contents) fsb_free(&sb);
+    EXPECT_TRUE(fsb_read_entire_files(paths, 0, contents, NULL, 0));
+
+#ifndef _WIN32
+    // A FIFO without a writer would block its worker forever
+    ASSERT_EQ(mkfifo("fsv_batch_test/pipe", 0600), 0);
+    ffe_t pipe = {};
+    pipe.name = fsb_from_sv(fsv_from_cstr("fsv_batch_test/pipe"));
+    fda_append(&files, pipe);
+    std::vector<fsb_t> with_pipe(files.size);
+    std::vector<int> pipe_errors(files.size, -1);
+    EXPECT_FALSE(ffp_read_entire_files(&files, with_pipe.data(), pipe_errors.data(), 4));
+    EXPECT_EQ(pipe_errors.back(), EINVAL);
+    EXPECT_EQ(with_pipe.back().length, 0);
+    EXPECT_EQ(pipe_errors.front(), 0);
+    for (fsb_t &sb : with_pipe) fsb_free(&sb);
+#endif // _WIN32
+
+    ffp_free(&files);
+    fs::remove_all("fsv_batch_test");
+}
+
+typedef std::tuple<std::string, size_t, size_t, std::string, size_t> grep_match_t;
+
+typedef struct {
+    std::vector<grep_match_t> matches[FSV_PARALLEL_MAX_THREADS];
+    size_t stop_after;
+} grep_ctx_t;
+
+static bool collect_grep_match(void *ctx, size_t worker, const fsv_grep_match_t *match) {
+    grep_ctx_t *grep_ctx = (grep_ctx_t*) ctx;
+    grep_ctx->matches[worker].push_back({
+        std::string(match->path.datas, match->path.length), match->line_number, match->column,
+        std::string(match->line.datas, match->line.length), match->pattern,
+    });
+    return grep_ctx->stop_after == 0 || grep_ctx->matches[worker].size() < grep_ctx->stop_after;
+}
+
+static std::vector<grep_match_t> sorted_grep_matches(const grep_ctx_t *grep_ctx) {
+    std::vector<grep_match_t> ret;
+    for (const auto &matches : grep_ctx->matches) ret.insert(ret.end(), matches.begin(), matches.end());
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
+TEST(fstring_builder, fsv_grep_parallel_TEST) {
+    namespace fs = std::filesystem;
+    fs::remove_all("fsv_grep_test");
+    fs::create_directories("fsv_grep_test/a/b");
+    auto write = [](const char *path, const std::string &content) {
+        FILE *f = fopen(path, "wb");
+        ASSERT_NE(f, nullptr);
+        fwrite(content.data(), 1, content.size(), f);
+        fclose(f);
+    };
+    write("fsv_grep_test/f1", "nothing here\nsome needle and an other\r\nNEEDLE\n\nother at the end");
+    write("fsv_grep_test/a/f2", "other\nneedle");
+    write("fsv_grep_test/a/b/f3", "");
+    write("fsv_grep_test/a/b/binary", std::string("needle\0needle\n", 14));
+#ifndef _WIN32
+    // Opening a FIFO without a writer blocks, it must not be searched at all
+    ASSERT_EQ(mkfifo("fsv_grep_test/a/pipe", 0600), 0);
+    fs::create_symlink("pipe", "fsv_grep_test/a/link_to_pipe");
+    fsv_t mapped = {};
+    EXPECT_FALSE(fsv_mmap_file("fsv_grep_test/a/pipe", FSV_MMAP_NORMAL, &mapped));
+#endif // _WIN32
+
+    fsv_t patterns[] = { fsv_from_cstr("needle"), fsv_from_cstr(""), fsv_from_cstr("other") };
+    for (size_t threads : { 1, 4 }) {
+        grep_ctx_t grep_ctx = {};
+        fsv_grep_t grep     = {};
+        grep.patterns       = patterns;
+        grep.pattern_count  = 3;
+        grep.thread_count   = threads;
+        grep.fn             = collect_grep_match;
+        grep.ctx            = &grep_ctx;
+        size_t matches      = 0;
+        EXPECT_TRUE(fsv_grep_parallel("fsv_grep_test", &grep, &matches));
+        std::vector<grep_match_t> expected = {
+            { native_path("fsv_grep_test/a/f2"), 1, 1, "other", 2 },
+            { native_path("fsv_grep_test/a/f2"), 2, 1, "needle", 0 },
+            { native_path("fsv_grep_test/f1"), 2, 6, "some needle and an other", 0 },
+            { native_path("fsv_grep_test/f1"), 5, 1, "other at the end", 2 },
+        };
+        EXPECT_EQ(sorted_grep_matches(&grep_ctx), expected);
+        EXPECT_EQ(matches, expected.size());
+
+        grep_ctx = {};
+        grep.ignore_case = true;
+        EXPECT_TRUE(fsv_grep_parallel("fsv_grep_test", &grep, &matches));
+        EXPECT_EQ(matches, expected.size() + 1);
+        EXPECT_EQ(std::get<3>(sorted_grep_matches(&grep_ctx)[3]), "NEEDLE");
+
+        // Early exit, either from the limit or from the callback
+        grep_ctx = {};
+        grep.max_matches = 2;
+        EXPECT_TRUE(fsv_grep_parallel("fsv_grep_test", &grep, &matches));
+        EXPECT_EQ(matches, 2);
+        EXPECT_EQ(sorted_grep_matches(&grep_ctx).size(), 2);
+
+        grep_ctx = {};
+        grep_ctx.stop_after = 1;
+        grep.max_matches    = 0;
+        EXPECT_TRUE(fsv_grep_parallel("fsv_grep_test", &grep, &matches));
+        EXPECT_GE(matches, 1);
+        EXPECT_LE(matches, threads);
+        EXPECT_EQ(sorted_grep_matches(&grep_ctx).size(), matches);
+    }
+
+    // Lines are counted by every kernel, across their block boundaries
+    fs::remove_all("fsv_grep_test");
+    fs::create_directories("fsv_grep_test");
+    std::string lines;
+    for (size_t i = 1; i <= 20000; ++i) lines += i == 7777 || i == 19999 ? "a needle\n" : "\n";
+    write("fsv_grep_test/lines", lines);
+    fsv_grep_t grep = {};
+    grep.patterns      = patterns;
+    grep.pattern_count = 1;
+    grep.fn            = collect_grep_match;
+    fsv_simd_t best = fsv_simd_detect();
+    for (int simd = FSV_SIMD_SWAR; simd <= best; ++simd) {
+        fsv_simd_set((fsv_simd_t)simd);
+        grep_ctx_t grep_ctx = {};
+        grep.ctx = &grep_ctx;
+        EXPECT_TRUE(fsv_grep_parallel("fsv_grep_test", &grep, NULL));
+        std::vector<grep_match_t> expected = {
+            { native_path("fsv_grep_test/lines"), 7777, 3, "a needle", 0 },
+            { native_path("fsv_grep_test/lines"), 19999, 3, "a needle", 0 },
+        };
+        EXPECT_EQ(sorted_grep_matches(&grep_ctx), expected) << "simd = " << simd;
+    }
+    fsv_simd_set(best);
+
+    size_t matches = 1;
+    EXPECT_FALSE(fsv_grep_parallel("fsv_grep_does_not_exist", &grep, &matches));
+    EXPECT_EQ(matches, 0);
+    fs::remove_all("fsv_grep_test");
+}
+
+TEST(fstring_builder, fsb_append_TYPED) {
+    fsb_t sb = {};
+    fsb_append_cstr(&sb, "id=");
+    fsb_append_u64(&sb, 42);
+    fsb_append_char(&sb, ',');
+    fsb_append_sv(&sb, fsv_from_cstr("delta="));
+    fsb_append_i64(&sb, -7);
+    fsb_append_char(&sb, ',');
+    fsb_append_f64(&sb, 0.1);
+    fsb_append_sv(&sb, fsv_from_parts(NULL, 3));
+    EXPECT_TRUE(fexpect_sv_eq_cstr(fsv_from_sb(sb), "id=42,delta=-7,0.1"));
+    EXPECT_STREQ(sb.datas, "id=42,delta=-7,0.1");
+    fsb_free(&sb);
+}
+
+TEST(fstring_builder, fsb_append_i64_SAME_AS_TO_CHARS) {
+    std::vector<int64_t> values = { 0, 1, -1, 9, 10, 99, 100, INT64_MAX, INT64_MIN };
+    for (int64_t power = 1; power < INT64_MAX/10; power *= 10) {
+        values.insert(values.end(), { power - 1, power, power + 1, -power });
+    }
+    for (int i = 0; i < 10000; ++i) values.push_back((int64_t)(((uint64_t)rand() << 33) ^ ((uint64_t)rand() << 10) ^ (uint64_t)rand()) >> (rand() % 63));
+
+    char buffer[32];
+    for (int64_t value : values) {
+        fsb_t sb = {};
+        fsb_append_i64(&sb, value);
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        EXPECT_EQ(std::string(sb.datas, sb.length), std::string(buffer, result.ptr)) << value;
+        fsb_free(&sb);
+
+        uint64_t u = (uint64_t)value;
+        fsb_append_u64(&sb, u);
+        result = std::to_chars(buffer, buffer + sizeof(buffer), u);
+        EXPECT_EQ(std::string(sb.datas, sb.length), std::string(buffer, result.ptr)) << u;
+        fsb_free(&sb);
+    }
+}
+
+TEST(fstring_builder, fsb_append_f64_SAME_AS_TO_CHARS) {
+    std::vector<double> values = {
+        0.0, -0.0, 1.0, -1.0, 0.1, 0.3, 1e23, 1e22, 5e-324, 1e-323, 2.2250738585072014e-308, 2.2250738585072009e-308,
+        1.7976931348623157e308, 100000.0, 123456.0, 1234567.0, 0.0001, 0.00001, 123e-7, 9007199254740993.0,
+        1.0/3.0, 2.0/3.0, 4.35, 0.000123456789, 5e-310, 1e21, 1e100, HUGE_VAL, -HUGE_VAL,
+    };
+    for (int exponent = -1074; exponent <= 1023; ++exponent) values.push_back(ldexp(1.0, exponent));
+    for (int t = 1; t < 1000; ++t) values.push_back(ldexp((double)t, -1074));
+    for (int i = 0; i < 10000; ++i) values.push_back(ldexp((double)(((uint64_t)rand() << 31) ^ (uint64_t)rand()), -1074));
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t bits = ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (!std::isnan(value)) values.push_back(value);
+    }
+    // Integers past 2^53 print every digit in fixed notation
+    for (int i = 0; i < 10000; ++i) values.push_back(ldexp((double)rand()*rand(), 30 + rand() % 30));
+    // Short decimals, the common case in a CSV
+    for (int i = 0; i < 10000; ++i) values.push_back((double)(rand() % 100000)/pow(10, rand() % 8));
+
+    char buffer[64];
+    for (double value : values) {
+        fsb_t sb = {};
+        fsb_append_f64(&sb, value);
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        ASSERT_EQ(std::string(sb.datas, sb.length), std::string(buffer, result.ptr)) << value;
+        EXPECT_EQ(sb.datas[sb.length], '\0');
+        fsb_free(&sb);
+    }
+
+    fsb_t sb = {};
+    fsb_append_f64(&sb, NAN);
+    EXPECT_STREQ(sb.datas, "nan");
+    fsb_free(&sb);
+}
+
+TEST(fstring_builder, fsb_append_strf_GROWTH) {
+    fsb_t sb = {};
+    std::string expected;
+    size_t reallocations = 0;
+    char *datas = NULL;
+    for (int i = 0; i < 100000; ++i) {
+        EXPECT_EQ(fsb_append_strf(&sb, "%s=%d;", "key", i), (int)std::to_string(i).size() + 5);
+        expected += "key=" + std::to_string(i) + ";";
+        if (sb.datas != datas) reallocations += 1;
+        datas = sb.datas;
+    }
+    EXPECT_EQ(std::string(sb.datas, sb.length), expected);
+    EXPECT_EQ(sb.datas[sb.length], '\0');
+    // Geometric growth
+    EXPECT_LT(reallocations, 32);
+
+    // Longer than the spare capacity, needs the second pass
+    std::string big(10000, 'x');
+    EXPECT_EQ(fsb_append_strf(&sb, "[%s]", big.c_str()), 10002);
+    expected += "[" + big + "]";
+    EXPECT_EQ(std::string(sb.datas, sb.length), expected);
+    EXPECT_EQ(sb.datas[sb.length], '\0');
+    fsb_free(&sb);
+
+    EXPECT_EQ(fsb_append_strf(&sb, "%s", ""), 0);
+    EXPECT_STREQ(sb.datas, "");
+    fsb_free(&sb);
+}
+
+TEST(fstring_builder, fsb_from_sv_EMBEDDED_NULL) {
+    fsb_t sb = fsb_from_sv(fsv_from_parts("a\0b", 3));
+    EXPECT_EQ(sb.length, 3);
+    EXPECT_EQ(memcmp(sb.datas, "a\0b", 4), 0);
+    fsb_free(&sb);
+
+    sb = fsb_from_sv(fsv_from_parts(NULL, 0));
+    EXPECT_EQ(sb.length, 0);
+    EXPECT_STREQ(sb.datas, "");
+    fsb_free(&sb);
+}
+
+TEST(fstring_builder, fssb_INLINE_THEN_HEAP) {
+    fssb_t sb = {};
+    EXPECT_STREQ(fssb_cstr(&sb), "");
+    EXPECT_EQ(fsv_from_fssb(&sb).length, 0);
+
+    std::string expected;
+    for (int i = 0; i < 200; ++i) {
+        std::string part = std::to_string(i);
+        fssb_append_sv(&sb, fsv_from_parts(part.c_str(), part.size()));
+        expected += part;
+        EXPECT_STREQ(fssb_cstr(&sb), expected.c_str());
+        EXPECT_EQ(sb.length, expected.size());
+        if (expected.size() <= FSSB_INLINE_CAPACITY) {
+            // Still inside the struct
+            EXPECT_EQ(fssb_cstr(&sb), (const char*)&sb + offsetof(fssb_t, u));
+        }
+    }
+    EXPECT_TRUE(fsv_eq(fsv_from_fssb(&sb), fsv_from_parts(expected.c_str(), expected.size()), false));
+    fssb_free(&sb);
+    EXPECT_EQ(sb.length, 0);
+    EXPECT_STREQ(fssb_cstr(&sb), "");
+
+    // Copying an inline one copies its chars too
+    fssb_t name = fssb_from_sv(fsv_from_cstr("fsv.h"));
+    fssb_t copy = name;
+    fssb_free(&name);
+    EXPECT_STREQ(fssb_cstr(&copy), "fsv.h");
+    fssb_free(&copy);
+
+    fssb_t exact = fssb_from_sv(fsv_from_cstr("12345678901234567890123"));
+    EXPECT_EQ(exact.length, FSSB_INLINE_CAPACITY);
+    EXPECT_STREQ(fssb_cstr(&exact), "12345678901234567890123");
+    fssb_append_sv(&exact, fsv_from_cstr("4"));
+    EXPECT_STREQ(fssb_cstr(&exact), "123456789012345678901234");
+    fssb_free(&exact);
+}
+
 TEST(ftemp_buffer, fsv_tmp_alloc_test) {
+    fsv_tmp_reset();
     size_t save_point = fsv_tmp_save_point();
 
     size_t length = rand()%FSV_TMP_CAPACITY;
@@ -807,7 +2385,7 @@ TEST(ftemp_buffer, fsv_tmp_alloc_test) {
     EXPECT_EQ(fsv_tmp_save_point() - save_point, length);
 
     fsv_tmp_rewind(save_point);
-    EXPECT_EQ(fsv_tmp_size, save_point);
+    EXPECT_EQ(fsv_tmp_save_point(), save_point);
 }
 
 TEST(ftemp_buffer, fsv_tmp_strdup) {
@@ -819,7 +2397,7 @@ TEST(ftemp_buffer, fsv_tmp_strdup) {
     EXPECT_STREQ(ret, cstr);
 
     fsv_tmp_rewind(save_point);
-    EXPECT_EQ(fsv_tmp_size, save_point);
+    EXPECT_EQ(fsv_tmp_save_point(), save_point);
 }
 
 TEST(ftemp_buffer, fsv_tmp_sv_to_cstr_NORMAL) {
@@ -832,20 +2410,25 @@ TEST(ftemp_buffer, fsv_tmp_sv_to_cstr_NORMAL) {
     EXPECT_TRUE(fexpect_sv_eq_cstr(sv, ret));
 
     fsv_tmp_rewind(save_point);
-    EXPECT_EQ(fsv_tmp_size, save_point);
+    EXPECT_EQ(fsv_tmp_save_point(), save_point);
 }
 
 TEST(ftemp_buffer, fsv_tmp_sv_to_cstr_BUFFER_REACH_CAPACITY) {
     const char *cstr  = "The quick brown fox jumps over the lazy dog";
-    fsv_tmp_size      = FSV_TMP_CAPACITY - strlen(cstr) - 2;
+    fsv_tmp_reset();
+    fsv_tmp_alloc(FSV_TMP_CAPACITY - strlen(cstr));
     fsv_t sv          = fsv_from_cstr(cstr);
     size_t save_point = fsv_tmp_save_point();
 
+    // Does not fit in the first block anymore
     char *ret = fsv_tmp_sv_to_cstr(sv);
-    EXPECT_EQ(fsv_tmp_save_point() - save_point, strlen(cstr) + 1);
+    EXPECT_GE(fsv_tmp_save_point() - save_point, strlen(cstr) + 1);
     EXPECT_TRUE(fexpect_sv_eq_cstr(sv, ret));
 
+    fsv_tmp_rewind(save_point);
+    EXPECT_EQ(fsv_tmp_save_point(), save_point);
     fsv_tmp_reset();
+    EXPECT_EQ(fsv_tmp_save_point(), 0);
 }
 
 TEST(ftemp_buffer, fsv_tmp_sv_to_cstr_NULL_OR_EMPTY_STRING) {
@@ -875,7 +2458,7 @@ TEST(ftemp_buffer, fsv_tmp_concat_cstr_NORMAL) {
     EXPECT_TRUE(fexpect_sv_eq_cstr(sv, merge));
 
     fsv_tmp_rewind(save_point);
-    EXPECT_EQ(fsv_tmp_size, save_point);
+    EXPECT_EQ(fsv_tmp_save_point(), save_point);
 }
 
 TEST(ftemp_buffer, fsv_tmp_concat_cstr_REPEATED_CONCAT) {
@@ -958,20 +2541,23 @@ TEST(ftemp_buffer, fsv_tmp_concat_cstr_REPEATED_CONCAT) {
     EXPECT_TRUE(fexpect_sv_eq_cstr(sv, ex_cstr));
 
     fsv_tmp_rewind(save_point);
-    EXPECT_EQ(fsv_tmp_size, save_point);
+    EXPECT_EQ(fsv_tmp_save_point(), save_point);
 }
 
 TEST(ftemp_buffer, fsv_tmp_concat_cstr_BUFFER_REACH_CAPACITY) {
     const char *cstr1  = "The quick brown fox jumps";
     const char *cstr2  = " over the lazy dog";
     const char *merge  = "The quick brown fox jumps over the lazy dog";
-    fsv_tmp_size = FSV_TMP_CAPACITY - strlen(merge) - 1;
+    fsv_tmp_reset();
+    fsv_tmp_alloc(FSV_TMP_CAPACITY - strlen(merge));
     size_t save_point = fsv_tmp_save_point();
 
+    // No room left for the NUL, so it moves to the next block
     fsv_t sv = fsv_tmp_concat_cstr(fsv_from_cstr(cstr1), cstr2);
     EXPECT_EQ(sv.length, strlen(merge));
-    EXPECT_EQ(fsv_tmp_save_point() - save_point, strlen(merge));
+    EXPECT_GE(fsv_tmp_save_point() - save_point, strlen(merge));
     EXPECT_TRUE(fexpect_sv_eq_cstr(sv, merge));
+    EXPECT_EQ(sv.datas[sv.length], '\0');
 
     fsv_tmp_reset();
 }
@@ -987,7 +2573,7 @@ TEST(ftemp_buffer, fsv_tmp_concat_cstr_NULL) {
     EXPECT_TRUE(fexpect_sv_eq_cstr(sv, merge));
 
     fsv_tmp_rewind(save_point);
-    EXPECT_EQ(fsv_tmp_size, save_point);
+    EXPECT_EQ(fsv_tmp_save_point(), save_point);
 
     sv = fsv_tmp_concat(fsv_from_cstr(merge), fsv_from_cstr(cstr1));
     EXPECT_EQ(sv.length, strlen(merge));
@@ -995,7 +2581,7 @@ TEST(ftemp_buffer, fsv_tmp_concat_cstr_NULL) {
     EXPECT_TRUE(fexpect_sv_eq_cstr(sv, merge));
 
     fsv_tmp_rewind(save_point);
-    EXPECT_EQ(fsv_tmp_size, save_point);
+    EXPECT_EQ(fsv_tmp_save_point(), save_point);
 
     sv = fsv_tmp_concat(fsv_from_cstr(cstr1), fsv_from_cstr(cstr1));
     EXPECT_EQ(sv.length, 0);
@@ -1078,5 +2664,72 @@ TEST(ftemp_buffer, fsv_tmp_concat_continuous_cstr_REPEATED_CONCAT) {
     EXPECT_TRUE(fexpect_sv_eq_cstr(sv, ex_cstr));
 
     fsv_tmp_rewind(save_point);
-    EXPECT_EQ(fsv_tmp_size, save_point);
+    EXPECT_EQ(fsv_tmp_save_point(), save_point);
+}
+
+TEST(ftemp_buffer, fsv_tmp_alloc_CHAINED_BLOCKS) {
+    fsv_tmp_reset();
+    std::vector<std::pair<char*, size_t>> allocs;
+    size_t middle = 0;
+    for (size_t i = 0; i < 64; ++i) {
+        if (i == 32) middle = fsv_tmp_save_point();
+        size_t length = 1 + (i*997)%(FSV_TMP_CAPACITY/2);
+        if (i == 40) length = 3*FSV_TMP_CAPACITY;
+        char *ret = fsv_tmp_alloc(length);
+        memset(ret, 'a' + (int)(i%26), length);
+        allocs.push_back({ret, length});
+    }
+    // Earlier allocations are untouched by the blocks chained after them
+    for (size_t i = 0; i < allocs.size(); ++i) {
+        EXPECT_EQ(allocs[i].first[0], 'a' + (int)(i%26));
+        EXPECT_EQ(allocs[i].first[allocs[i].second - 1], 'a' + (int)(i%26));
+    }
+
+    fsv_tmp_rewind(middle);
+    EXPECT_EQ(fsv_tmp_save_point(), middle);
+    // Same size, same place: the blocks after the save point are reused
+    char *ret = fsv_tmp_alloc(allocs[32].second);
+    EXPECT_EQ(ret, allocs[32].first);
+    for (size_t i = 0; i < 32; ++i) {
+        EXPECT_EQ(allocs[i].first[0], 'a' + (int)(i%26));
+    }
+
+    fsv_tmp_reset();
+    EXPECT_EQ(fsv_tmp_save_point(), 0);
+}
+
+TEST(ftemp_buffer, fsv_tmp_concat_continuous_PAST_BLOCK) {
+    fsv_tmp_reset();
+    size_t save_point = fsv_tmp_save_point();
+    std::string expected;
+    fsv_t sv = {};
+    for (size_t i = 0; i < 3*FSV_TMP_CAPACITY/16; ++i) {
+        sv = fsv_tmp_concat_continuous_cstr(sv, "0123456789abcdef");
+        expected += "0123456789abcdef";
+        EXPECT_EQ(fsv_tmp_save_point(), save_point);
+    }
+    EXPECT_EQ(std::string(sv.datas, sv.length), expected);
+    EXPECT_EQ(sv.datas[sv.length], '\0');
+    fsv_tmp_reset();
+}
+
+TEST(ftemp_buffer, fsv_tmp_THREADS) {
+    std::vector<std::thread> threads;
+    std::vector<int> failures(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t, &failures]() {
+            // Every thread starts with its own empty buffer
+            if (fsv_tmp_save_point() != 0) failures[t]++;
+            std::vector<std::pair<char*, int>> strs;
+            for (int i = 0; i < 2000; ++i) {
+                strs.push_back({ fsv_tmp_sprintf("thread %d string %d", t, i), i });
+            }
+            for (auto &[str, i] : strs) {
+                if (std::string(str) != "thread " + std::to_string(t) + " string " + std::to_string(i)) failures[t]++;
+            }
+            fsv_tmp_free();
+        });
+    }
+    for (std::thread &thread : threads) thread.join();
+    for (int t = 0; t < 4; ++t) EXPECT_EQ(failures[t], 0) << "thread " << t;
 }